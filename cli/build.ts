@@ -12,8 +12,11 @@ const NATIVE_LIBS: [string, string][] = [
   ["SDL_image", "SDL3_image"],
   ["box2d", "box2d_jove"],
   ["audio_decode", "audio_decode"],
+  ["audio_mixer", "jove_mixer"],
   ["pl_mpeg", "pl_mpeg_jove"],
   ["shaderc", "shaderc_jove"],
+  ["jove_input", "jove_input"],
+  ["jove_render", "jove_render"],
 ];
 
 // Engine assets to copy
@@ -157,6 +157,8 @@ function fillBuffer(waveform: Waveform): void {
   for (const v of voices) if (v.envStage !== "off") numActive++;
   const norm = numActive > 1 ? 1 / Math.sqrt(numActive) : 1;
 
+  // Write straight into the 16-bit sample view — no per-sample setSample() call
+  const samples = soundData.getInt16Array();
   for (let i = 0; i < BUFFER_SIZE; i++) {
     let mix = 0;
     for (const v of voices) {
@@ -165,7 +167,8 @@ function fillBuffer(waveform: Waveform): void {
       const p = v.phase + i * inc;
       mix += waveformSample(waveform, p) * envTick(v);
     }
-    soundData.setSample(i, mix * norm * volume);
+    const v = mix * norm * volume;
+    samples[i] = Math.round((v < -1 ? -1 : v > 1 ? 1 : v) * 32767);
   }
 
   // Advance phase for each voice
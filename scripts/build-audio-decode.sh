@@ -24,3 +24,4 @@ cp "$BUILD_DIR/libaudio_decode.so" "$INSTALL_DIR/lib/"
 
 echo "=== Audio decode build complete ==="
 echo "Library: $INSTALL_DIR/lib/libaudio_decode.so"
+echo "Benchmark: $BUILD_DIR/audio_decode_bench [--seconds S] file.ogg file.mp3 file.flac"
@@ -0,0 +1,36 @@
+#!/usr/bin/env bash
+set -euo pipefail
+
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+PROJECT_DIR="$(cd "$SCRIPT_DIR/.." && pwd)"
+SOURCE_DIR="$PROJECT_DIR/vendor/audio_mixer"
+INSTALL_DIR="$SOURCE_DIR/install"
+SDL3_DIR="$PROJECT_DIR/vendor/SDL3/install"
+
+# Build in /tmp for speed on WSL (NTFS is slow)
+BUILD_DIR="/tmp/audio-mixer-build"
+
+echo "=== Audio Mixer Build Script ==="
+
+# Verify SDL3 is installed
+if [ ! -d "$SDL3_DIR" ]; then
+  echo "ERROR: SDL3 not found at $SDL3_DIR"
+  echo "Run 'bun run build-sdl3' first."
+  exit 1
+fi
+
+echo "Building jove_mixer shared library..."
+cmake -S "$SOURCE_DIR" -B "$BUILD_DIR" -G Ninja \
+  -DCMAKE_BUILD_TYPE=Release \
+  -DSDL3_INSTALL_DIR="$SDL3_DIR"
+
+ninja -C "$BUILD_DIR" -j"$(nproc)"
+
+# Install
+echo "Installing to $INSTALL_DIR..."
+mkdir -p "$INSTALL_DIR/lib"
+cp "$BUILD_DIR/libjove_mixer.so" "$INSTALL_DIR/lib/"
+
+echo "=== Audio mixer build complete ==="
+echo "Library: $INSTALL_DIR/lib/libjove_mixer.so"
+echo "Benchmark: $BUILD_DIR/jove_mixer_bench [voices] [seconds]"
@@ -24,7 +24,7 @@ SDL3_BUILD="$BUILD_ROOT/SDL3-build"
 SDL3_INSTALL="$PROJECT_DIR/vendor/SDL3/install"
 
 echo ""
-echo "=== [1/7] Building SDL3 ==="
+echo "=== [1/10] Building SDL3 ==="
 
 if [ ! -d "$SDL3_SOURCE" ]; then
   echo "Cloning SDL3..."
@@ -58,7 +58,7 @@ SDL_TTF_BUILD="$BUILD_ROOT/SDL_ttf-build"
 SDL_TTF_INSTALL="$PROJECT_DIR/vendor/SDL_ttf/install"
 
 echo ""
-echo "=== [2/7] Building SDL_ttf ==="
+echo "=== [2/10] Building SDL_ttf ==="
 
 if [ ! -d "$SDL_TTF_SOURCE" ]; then
   echo "Cloning SDL_ttf (with vendored deps)..."
@@ -92,7 +92,7 @@ SDL_IMAGE_BUILD="$BUILD_ROOT/SDL_image-build"
 SDL_IMAGE_INSTALL="$PROJECT_DIR/vendor/SDL_image/install"
 
 echo ""
-echo "=== [3/7] Building SDL_image ==="
+echo "=== [3/10] Building SDL_image ==="
 
 if [ ! -d "$SDL_IMAGE_SOURCE" ]; then
   echo "Cloning SDL_image (with vendored deps)..."
@@ -131,7 +131,7 @@ BOX2D_INSTALL="$PROJECT_DIR/vendor/box2d/install"
 BOX2D_TAG="v3.1.1"
 
 echo ""
-echo "=== [4/7] Building Box2D + wrapper ==="
+echo "=== [4/10] Building Box2D + wrapper ==="
 
 if [ ! -d "$BOX2D_SOURCE" ]; then
   echo "Cloning Box2D $BOX2D_TAG..."
@@ -180,7 +180,7 @@ AUDIO_BUILD="$BUILD_ROOT/audio_decode-build"
 AUDIO_INSTALL="$AUDIO_SOURCE/install"
 
 echo ""
-echo "=== [5/7] Building audio_decode ==="
+echo "=== [5/10] Building audio_decode ==="
 
 cmake -S "$AUDIO_SOURCE" -B "$AUDIO_BUILD" -G Ninja \
   -DCMAKE_TOOLCHAIN_FILE="$TOOLCHAIN" \
@@ -199,10 +199,89 @@ done
 
 echo "audio_decode done: $(ls "$AUDIO_INSTALL"/lib/audio_decode.dll 2>/dev/null || echo 'not found')"
 
-# ─── 6. pl_mpeg ──────────────────────────────────────────────────────────────
+# ─── 6. audio_mixer ─────────────────────────────────────────────────────────
+
+MIXER_SOURCE="$PROJECT_DIR/vendor/audio_mixer"
+MIXER_BUILD="$BUILD_ROOT/audio_mixer-build"
+MIXER_INSTALL="$MIXER_SOURCE/install"
+
+echo ""
+echo "=== [6/10] Building audio_mixer ==="
+
+cmake -S "$MIXER_SOURCE" -B "$MIXER_BUILD" -G Ninja \
+  -DCMAKE_TOOLCHAIN_FILE="$TOOLCHAIN" \
+  -DCMAKE_BUILD_TYPE=Release \
+  -DSDL3_INSTALL_DIR="$SDL3_INSTALL" \
+  -DJOVE_MIXER_BENCH=OFF
+
+ninja -C "$MIXER_BUILD" -j"$(nproc)"
+
+mkdir -p "$MIXER_INSTALL/lib"
+for dll in "$MIXER_BUILD"/libjove_mixer.dll "$MIXER_BUILD"/jove_mixer.dll; do
+  if [ -f "$dll" ]; then
+    cp "$dll" "$MIXER_INSTALL/lib/jove_mixer.dll"
+    break
+  fi
+done
+
+echo "audio_mixer done: $(ls "$MIXER_INSTALL"/lib/jove_mixer.dll 2>/dev/null || echo 'not found')"
+
+# ─── 7. jove_input ──────────────────────────────────────────────────────────
+
+INPUT_SOURCE="$PROJECT_DIR/vendor/jove_input"
+INPUT_BUILD="$BUILD_ROOT/jove_input-build"
+INPUT_INSTALL="$INPUT_SOURCE/install"
+
+echo ""
+echo "=== [7/10] Building jove_input ==="
+
+cmake -S "$INPUT_SOURCE" -B "$INPUT_BUILD" -G Ninja \
+  -DCMAKE_TOOLCHAIN_FILE="$TOOLCHAIN" \
+  -DCMAKE_BUILD_TYPE=Release \
+  -DSDL3_INSTALL_DIR="$SDL3_INSTALL"
+
+ninja -C "$INPUT_BUILD" -j"$(nproc)"
+
+mkdir -p "$INPUT_INSTALL/lib"
+for dll in "$INPUT_BUILD"/libjove_input.dll "$INPUT_BUILD"/jove_input.dll; do
+  if [ -f "$dll" ]; then
+    cp "$dll" "$INPUT_INSTALL/lib/jove_input.dll"
+    break
+  fi
+done
+
+echo "jove_input done: $(ls "$INPUT_INSTALL"/lib/jove_input.dll 2>/dev/null || echo 'not found')"
+
+# ─── 8. jove_render ─────────────────────────────────────────────────────────
+
+RENDER_SOURCE="$PROJECT_DIR/vendor/jove_render"
+RENDER_BUILD="$BUILD_ROOT/jove_render-build"
+RENDER_INSTALL="$RENDER_SOURCE/install"
+
+echo ""
+echo "=== [8/10] Building jove_render ==="
+
+cmake -S "$RENDER_SOURCE" -B "$RENDER_BUILD" -G Ninja \
+  -DCMAKE_TOOLCHAIN_FILE="$TOOLCHAIN" \
+  -DCMAKE_BUILD_TYPE=Release \
+  -DSDL3_INSTALL_DIR="$SDL3_INSTALL"
+
+ninja -C "$RENDER_BUILD" -j"$(nproc)"
+
+mkdir -p "$RENDER_INSTALL/lib"
+for dll in "$RENDER_BUILD"/libjove_render.dll "$RENDER_BUILD"/jove_render.dll; do
+  if [ -f "$dll" ]; then
+    cp "$dll" "$RENDER_INSTALL/lib/jove_render.dll"
+    break
+  fi
+done
+
+echo "jove_render done: $(ls "$RENDER_INSTALL"/lib/jove_render.dll 2>/dev/null || echo 'not found')"
+
+# ─── 9. pl_mpeg ──────────────────────────────────────────────────────────────
 
 echo ""
-echo "=== [6/7] Building pl_mpeg ==="
+echo "=== [9/10] Building pl_mpeg ==="
 
 PLMPEG_SOURCE="$PROJECT_DIR/vendor/pl_mpeg"
 PLMPEG_BUILD="$BUILD_ROOT/pl_mpeg"
@@ -231,7 +310,7 @@ done
 
 echo "pl_mpeg done: $(ls "$PLMPEG_INSTALL"/lib/pl_mpeg_jove.dll 2>/dev/null || echo 'not found')"
 
-# ─── 7. shaderc + shaderc_jove wrapper ──────────────────────────────────────
+# ─── 10. shaderc + shaderc_jove wrapper ──────────────────────────────────────
 
 SHADERC_SOURCE="$BUILD_ROOT/shaderc-source"
 SHADERC_BUILD="$BUILD_ROOT/shaderc-build"
@@ -239,7 +318,7 @@ SHADERC_WRAPPER_BUILD="$BUILD_ROOT/shaderc_jove-build"
 SHADERC_INSTALL="$PROJECT_DIR/vendor/shaderc/install"
 
 echo ""
-echo "=== [7/7] Building shaderc + wrapper ==="
+echo "=== [10/10] Building shaderc + wrapper ==="
 
 if ! command -v python3 &>/dev/null; then
   echo "WARNING: python3 not found — skipping shaderc build"
@@ -298,6 +377,9 @@ for f in \
   "$SDL_IMAGE_INSTALL/lib/SDL3_image.dll" \
   "$BOX2D_INSTALL/lib/box2d_jove.dll" \
   "$AUDIO_INSTALL/lib/audio_decode.dll" \
+  "$MIXER_INSTALL/lib/jove_mixer.dll" \
+  "$INPUT_INSTALL/lib/jove_input.dll" \
+  "$RENDER_INSTALL/lib/jove_render.dll" \
   "$PLMPEG_INSTALL/lib/pl_mpeg_jove.dll" \
   "$SHADERC_INSTALL/lib/shaderc_jove.dll"; do
   if [ -f "$f" ]; then
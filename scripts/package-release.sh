@@ -65,6 +65,9 @@ if [ "$PLATFORM" = "linux-x64" ]; then
     "vendor/SDL_image/install/lib/libSDL3_image.so.0"
     "vendor/box2d/install/lib/libbox2d_jove.so"
     "vendor/audio_decode/install/lib/libaudio_decode.so"
+    "vendor/audio_mixer/install/lib/libjove_mixer.so"
+    "vendor/jove_input/install/lib/libjove_input.so"
+    "vendor/jove_render/install/lib/libjove_render.so"
     "vendor/pl_mpeg/install/lib/libpl_mpeg_jove.so"
     "vendor/shaderc/install/lib/libshaderc_jove.so"
   )
@@ -77,6 +80,9 @@ if [ "$PLATFORM" = "linux-x64" ]; then
     ""
     ""
     ""
+    ""
+    ""
+    ""
   )
 
   for i in "${!LIBS[@]}"; do
@@ -101,6 +107,9 @@ elif [ "$PLATFORM" = "windows-x64" ]; then
     "vendor/SDL_image/install/lib/SDL3_image.dll"
     "vendor/box2d/install/lib/box2d_jove.dll"
     "vendor/audio_decode/install/lib/audio_decode.dll"
+    "vendor/audio_mixer/install/lib/jove_mixer.dll"
+    "vendor/jove_input/install/lib/jove_input.dll"
+    "vendor/jove_render/install/lib/jove_render.dll"
     "vendor/pl_mpeg/install/lib/pl_mpeg_jove.dll"
     "vendor/shaderc/install/lib/shaderc_jove.dll"
   )
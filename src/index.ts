@@ -8,14 +8,16 @@ export {
 export type { GameCallbacks, WindowFlags, WindowMode, JoveEvent } from "./jove/types.ts";
 export type { ImageData } from "./jove/image.ts";
 export type { Font } from "./jove/font.ts";
-export type { SpriteBatch, Mesh, Image, Text, Canvas, Quad } from "./jove/graphics.ts";
+export type { SpriteBatch, Mesh, VertexAttribute, Image, Text, Canvas, Quad, CommandBufferStats, DynamicResolutionOptions, SDFFontOptions, Tilemap } from "./jove/graphics.ts";
 export type { ParticleSystem } from "./jove/particles.ts";
 export type { Shader } from "./jove/shader.ts";
-export type { Source, QueueableSource } from "./jove/audio.ts";
+export type { Source, QueueableSource, FilterSettings, EffectSettings, DeviceOptions, DeviceInfo, SoundBank, SoundBankOptions, SynthSource, Envelope } from "./jove/audio.ts";
 export type { SoundData } from "./jove/sound.ts";
 export type { ByteData } from "./jove/data.ts";
 export type { File, FileData } from "./jove/filesystem.ts";
-export type { Joystick } from "./jove/joystick.ts";
+export type { Thread, Channel } from "./jove/thread.ts";
+export type { Job, JobOptions } from "./jove/jobs.ts";
+export type { Joystick, JoystickSnapshot } from "./jove/joystick.ts";
 export type { World, Body, Fixture, Shape, Joint, Contact, DistanceJoint, RevoluteJoint, PrismaticJoint, WeldJoint, MouseJoint, WheelJoint, MotorJoint } from "./jove/physics.ts";
 
 import * as jove from "./jove/index.ts";
@@ -0,0 +1,332 @@
+// jove2d sound banks — many sounds registered cheaply, decoded on demand
+// jove2d extension (no love2d equivalent); re-exported from audio.ts.
+//
+// A bank keeps each OGG/MP3/FLAC file's compressed bytes in memory and decodes it on
+// first play, or ahead of time on a native worker thread via prefetch(). Decoded PCM
+// is evicted least-recently-used once the bank goes over its byte budget, and decoded
+// again from the compressed bytes the next time it's needed.
+
+import { ptr, read, toArrayBuffer } from "bun:ffi";
+import type { Pointer } from "bun:ffi";
+import { existsSync, readFileSync } from "fs";
+import { loadAudioDecode } from "../sdl/ffi_audio_decode.ts";
+import { SDL_AUDIO_S16 } from "../sdl/types.ts";
+import { _init, _ensureDevice, _decodeFile, _createSource } from "./audio.ts";
+import type { Source } from "./audio.ts";
+import { _createMixerSource } from "./audio-mixer.ts";
+
+type DecodeLib = NonNullable<ReturnType<typeof loadAudioDecode>>;
+
+export interface SoundBankOptions {
+  /** Decoded PCM kept resident, in bytes. Default 64 MiB. */
+  budget?: number;
+  /** Simultaneous plays per sound before the oldest one is restarted. Default 8. */
+  maxVoices?: number;
+}
+
+export interface SoundBankStats {
+  sounds: number;
+  /** Sounds with decoded PCM resident. */
+  decoded: number;
+  /** Background decodes still running. */
+  pending: number;
+  compressedBytes: number;
+  decodedBytes: number;
+  budget: number;
+  /** play()/newSource() calls served from resident PCM. */
+  hits: number;
+  /** play()/newSource() calls that had to decode (or wait for a prefetch). */
+  misses: number;
+  evictions: number;
+}
+
+export interface SoundBank {
+  /** Register a sound. Codec files are read into memory compressed; WAVs are loaded on first use. */
+  add(name: string, path: string): boolean;
+  remove(name: string): void;
+  has(name: string): boolean;
+  isDecoded(name: string): boolean;
+  /** Start decoding sounds on background threads so their first play doesn't stall. */
+  prefetch(...names: string[]): void;
+  /**
+   * Play a sound on a pooled source and return it. Decodes first if needed.
+   * The source stays owned by the bank — it is reused and released on eviction.
+   */
+  play(name: string): Source | null;
+  /** Create a caller-owned source for a sound (not pooled or evicted by the bank). */
+  newSource(name: string): Source | null;
+  setBudget(bytes: number): void;
+  getBudget(): number;
+  getStats(): SoundBankStats;
+  /** Release every pooled source, cancel pending decodes, and forget all sounds. */
+  release(): void;
+}
+
+interface DecodedPcm {
+  data: Uint8Array;
+  format: number;
+  channels: number;
+  freq: number;
+}
+
+interface BankEntry {
+  path: string;
+  /** Compressed file bytes; null for files decoded from disk on demand (WAV). */
+  compressed: Uint8Array | null;
+  decoded: DecodedPcm | null;
+  /** Background decode job (-1 = none). */
+  job: number;
+  /** Pooled sources; clones of the first share its native mixer buffer. */
+  voices: Source[];
+  lastUsed: number;
+}
+
+const DEFAULT_BUDGET = 64 * 1024 * 1024;
+const DEFAULT_MAX_VOICES = 8;
+// Extensions the codec lib decodes from memory (WAV goes through SDL from disk)
+const COMPRESSED_EXTENSIONS = new Set([".ogg", ".mp3", ".flac"]);
+
+// Out-params for decode results — read back with read.*
+const _outData = new BigUint64Array(1); // int16_t*
+const _outCh = new Int32Array(1);
+const _outRate = new Int32Array(1);
+
+// Banks with background decodes in flight — collected once per frame by _pollSoundBanks()
+const _collectors = new Set<() => boolean>();
+
+/** Collect finished background decodes. Called from audio._updateSources(). */
+export function _pollSoundBanks(): void {
+  if (_collectors.size === 0) return;
+  for (const collect of _collectors) {
+    if (!collect()) _collectors.delete(collect);
+  }
+}
+
+/** Copy a decode result out of C memory and free it. */
+function _readPcm(lib: DecodeLib, frames: number): DecodedPcm | null {
+  const dataPtr = read.ptr(ptr(_outData), 0);
+  const channels = read.i32(ptr(_outCh), 0);
+  const freq = read.i32(ptr(_outRate), 0);
+  if (!dataPtr) return null;
+  let pcm: DecodedPcm | null = null;
+  if (frames > 0 && channels > 0 && freq > 0) {
+    const data = new Uint8Array(toArrayBuffer(dataPtr as unknown as Pointer, 0, frames * channels * 2).slice(0));
+    pcm = { data, format: SDL_AUDIO_S16, channels, freq };
+  }
+  lib.jove_audio_free(dataPtr as unknown as Pointer);
+  return pcm;
+}
+
+function _extension(path: string): string {
+  const dot = path.lastIndexOf(".");
+  return dot === -1 ? "" : path.slice(dot).toLowerCase();
+}
+
+/** Create a sound bank (jove2d extension). */
+export function newSoundBank(options: SoundBankOptions = {}): SoundBank {
+  const lib = loadAudioDecode();
+  const entries = new Map<string, BankEntry>();
+  let budget = Math.max(0, options.budget ?? DEFAULT_BUDGET);
+  const maxVoices = Math.max(1, Math.floor(options.maxVoices ?? DEFAULT_MAX_VOICES));
+  let decodedBytes = 0;
+  let pending = 0;
+  let clock = 0;
+  let hits = 0, misses = 0, evictions = 0;
+
+  function _setDecoded(entry: BankEntry, pcm: DecodedPcm | null): void {
+    entry.decoded = pcm;
+    if (pcm) decodedBytes += pcm.data.length;
+  }
+
+  function _takeJob(entry: BankEntry): void {
+    if (!lib || entry.job < 0) return;
+    const frames = lib.jove_audio_job_take(entry.job, ptr(_outData), ptr(_outCh), ptr(_outRate));
+    entry.job = -1;
+    pending--;
+    _setDecoded(entry, frames > 0 ? _readPcm(lib, frames) : null);
+  }
+
+  function _cancelJob(entry: BankEntry): void {
+    if (!lib || entry.job < 0) return;
+    lib.jove_audio_job_cancel(entry.job);
+    entry.job = -1;
+    pending--;
+  }
+
+  /** Collect finished prefetches; returns true while any are still running. */
+  function _collect(): boolean {
+    if (!lib) return false;
+    for (const entry of entries.values()) {
+      if (entry.job >= 0 && lib.jove_audio_job_poll(entry.job) !== 0) _takeJob(entry);
+    }
+    _enforceBudget(null);
+    return pending > 0;
+  }
+
+  function _evict(entry: BankEntry): void {
+    for (const v of entry.voices) v.release();
+    entry.voices.length = 0;
+    if (entry.decoded) decodedBytes -= entry.decoded.data.length;
+    entry.decoded = null;
+    evictions++;
+  }
+
+  /** Evict least-recently-used PCM until under budget. Never evicts `keep` or playing sounds. */
+  function _enforceBudget(keep: BankEntry | null): void {
+    while (decodedBytes > budget) {
+      let victim: BankEntry | null = null;
+      for (const entry of entries.values()) {
+        if (!entry.decoded || entry === keep) continue;
+        if (entry.voices.some((v) => v.isPlaying())) continue;
+        if (!victim || entry.lastUsed < victim.lastUsed) victim = entry;
+      }
+      if (!victim) return;
+      _evict(victim);
+    }
+  }
+
+  /** Make sure an entry has PCM, decoding synchronously or waiting on its prefetch. */
+  function _ensureDecoded(entry: BankEntry): boolean {
+    entry.lastUsed = ++clock;
+    if (entry.decoded) {
+      hits++;
+      return true;
+    }
+    misses++;
+    return _decodeNow(entry);
+  }
+
+  function _decodeNow(entry: BankEntry): boolean {
+    if (lib && entry.job >= 0) {
+      while (lib.jove_audio_job_poll(entry.job) === 0) Bun.sleepSync(0.25);
+      _takeJob(entry);
+    } else if (lib && entry.compressed) {
+      const c = entry.compressed;
+      const frames = lib.jove_audio_decode_memory(ptr(c), c.length, ptr(_outData), ptr(_outCh), ptr(_outRate));
+      _setDecoded(entry, _readPcm(lib, frames));
+    } else {
+      _setDecoded(entry, _decodeFile(entry.path));
+    }
+    _enforceBudget(entry);
+    return entry.decoded !== null;
+  }
+
+  function _createVoice(entry: BankEntry): Source | null {
+    const first = entry.voices[0];
+    if (first) return first.clone();
+    const d = entry.decoded!;
+    return _createMixerSource(d.data, d.format, d.channels, d.freq, "static")
+      ?? _createSource(d.data, d.format, d.channels, d.freq, "static");
+  }
+
+  function _prepare(name: string): BankEntry | null {
+    const entry = entries.get(name);
+    if (!entry) return null;
+    if (!_init() || !_ensureDevice()) return null;
+    return _ensureDecoded(entry) ? entry : null;
+  }
+
+  const bank: SoundBank = {
+    add(name: string, path: string): boolean {
+      bank.remove(name);
+      let compressed: Uint8Array | null = null;
+      if (lib && COMPRESSED_EXTENSIONS.has(_extension(path))) {
+        try {
+          compressed = readFileSync(path);
+        } catch {
+          return false;
+        }
+      } else if (!existsSync(path)) {
+        return false;
+      }
+      entries.set(name, { path, compressed, decoded: null, job: -1, voices: [], lastUsed: 0 });
+      return true;
+    },
+
+    remove(name: string): void {
+      const entry = entries.get(name);
+      if (!entry) return;
+      _cancelJob(entry);
+      for (const v of entry.voices) v.release();
+      if (entry.decoded) decodedBytes -= entry.decoded.data.length;
+      entries.delete(name);
+    },
+
+    has(name: string): boolean {
+      return entries.has(name);
+    },
+
+    isDecoded(name: string): boolean {
+      return entries.get(name)?.decoded != null;
+    },
+
+    prefetch(...names: string[]): void {
+      for (const name of names) {
+        const entry = entries.get(name);
+        if (!entry || entry.decoded || entry.job >= 0) continue;
+        entry.lastUsed = ++clock;
+        if (lib && entry.compressed) {
+          const c = entry.compressed;
+          entry.job = lib.jove_audio_job_start(ptr(c), c.length);
+          if (entry.job >= 0) {
+            pending++;
+            _collectors.add(_collect);
+            continue;
+          }
+        }
+        // No job slot (or a WAV) — decode now
+        _decodeNow(entry);
+      }
+    },
+
+    play(name: string): Source | null {
+      const entry = _prepare(name);
+      if (!entry) return null;
+      let voice = entry.voices.find((v) => !v.isPlaying()) ?? null;
+      if (!voice) {
+        if (entry.voices.length < maxVoices) {
+          voice = _createVoice(entry);
+          if (!voice) return null;
+        } else {
+          // Out of voices — restart the oldest
+          voice = entry.voices.shift()!;
+        }
+        entry.voices.push(voice);
+      }
+      voice.play();
+      return voice;
+    },
+
+    newSource(name: string): Source | null {
+      const entry = _prepare(name);
+      return entry ? _createVoice(entry) : null;
+    },
+
+    setBudget(bytes: number): void {
+      budget = Math.max(0, bytes);
+      _enforceBudget(null);
+    },
+
+    getBudget(): number {
+      return budget;
+    },
+
+    getStats(): SoundBankStats {
+      let compressedBytes = 0;
+      let decoded = 0;
+      for (const entry of entries.values()) {
+        if (entry.compressed) compressedBytes += entry.compressed.length;
+        if (entry.decoded) decoded++;
+      }
+      return {
+        sounds: entries.size, decoded, pending, compressedBytes, decodedBytes, budget, hits, misses, evictions,
+      };
+    },
+
+    release(): void {
+      for (const name of [...entries.keys()]) bank.remove(name);
+      _collectors.delete(_collect);
+    },
+  };
+  return bank;
+}
@@ -0,0 +1,899 @@
+// jove2d audio mixer module — native mixer voices, filters, scene effects, positional audio
+// Extracted from audio.ts to keep the SDL-stream sources separate; re-exported from audio.ts.
+//
+// Static sources play as voices in the native mixer (vendor/audio_mixer), which runs
+// on SDL's audio thread. Each frame's JS-side cost is a handful of FFI calls that only
+// push commands onto a lock-free queue — the DSP graph itself never touches JS.
+
+import { ptr, read, toArrayBuffer } from "bun:ffi";
+import type { Pointer } from "bun:ffi";
+import { loadMixer } from "../sdl/ffi_mixer.ts";
+import { SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, SDL_AUDIO_S16 } from "../sdl/types.ts";
+import {
+  _init,
+  _ensureDevice,
+  _getMasterVolume,
+  _markActive,
+  _trackSource,
+  _untrackSource,
+  _createSource,
+} from "./audio.ts";
+import type { Source, SourceType } from "./audio.ts";
+
+export type MixerLib = NonNullable<ReturnType<typeof loadMixer>>;
+
+let _mixer: MixerLib | null = null;
+let _mixRate = 0;
+// Bumped on every close so buffers from a previous mixer are never freed twice
+let _generation = 0;
+
+// Completion flags shared with the audio thread (C static arrays, read via read.i32)
+let _endedTable: Pointer | null = null;
+let _endedCounter: Pointer | null = null;
+let _lastEndedCount = 0;
+// Set once per frame by _beginMixerPoll(): did any voice finish since the last frame?
+let _anyEnded = false;
+
+// ============================================================
+// Filter / effect settings (love2d-compatible tables)
+// ============================================================
+
+export type FilterType = "lowpass" | "highpass" | "bandpass";
+
+export interface FilterSettings {
+  type: FilterType;
+  /** Overall gain (0-1). Default 1. */
+  volume?: number;
+  /** Gain of frequencies below the band (highpass/bandpass, 0-1). Default 1. */
+  lowgain?: number;
+  /** Gain of frequencies above the band (lowpass/bandpass, 0-1). Default 1. */
+  highgain?: number;
+  /** Cutoff / center frequency in Hz (jove2d extension). */
+  frequency?: number;
+  /** Filter resonance (jove2d extension). Default 0.707. */
+  q?: number;
+}
+
+export type EffectType = "reverb" | "echo" | "delay" | "compressor" | "limiter";
+
+export interface EffectSettings {
+  type: EffectType;
+  /** Output level of the effect (0-1). Default 1. */
+  volume?: number;
+  // reverb
+  gain?: number;
+  decaytime?: number;
+  hfgain?: number;
+  diffusion?: number;
+  // echo / delay
+  delay?: number;
+  lrdelay?: number;
+  feedback?: number;
+  damping?: number;
+  // compressor / limiter
+  threshold?: number;
+  ratio?: number;
+  attack?: number;
+  release?: number;
+  makeup?: number;
+}
+
+const FILTER_TYPES: Record<FilterType, number> = { lowpass: 1, highpass: 2, bandpass: 3 };
+// OpenAL EFX reference frequencies, which love2d's fixed-band filters use
+const FILTER_DEFAULT_FREQ: Record<FilterType, number> = { lowpass: 5000, highpass: 250, bandpass: 1000 };
+const EFFECT_TYPES: Record<EffectType, number> = { reverb: 1, echo: 2, delay: 2, compressor: 3, limiter: 3 };
+
+export type DistanceModel =
+  | "none"
+  | "inverse" | "inverseclamped"
+  | "linear" | "linearclamped"
+  | "exponent" | "exponentclamped";
+
+// [native model, clamped]
+const DISTANCE_MODELS: Record<DistanceModel, [number, number]> = {
+  none: [0, 0],
+  inverse: [1, 0],
+  inverseclamped: [1, 1],
+  linear: [2, 0],
+  linearclamped: [2, 1],
+  exponent: [3, 0],
+  exponentclamped: [3, 1],
+};
+
+const MONO_ONLY_ERROR =
+  "This spatial audio functionality is only available for mono Sources. " +
+  "Ensure the Source is not multi-channel before calling this function.";
+
+function _clamp(v: number, lo: number, hi: number): number {
+  return v < lo ? lo : v > hi ? hi : v;
+}
+
+/** Validate and copy a filter table. Throws on an unknown type, like love2d. */
+function _checkFilter(settings: FilterSettings): FilterSettings {
+  if (!FILTER_TYPES[settings.type]) {
+    throw new Error(`Invalid filter type: ${settings.type}`);
+  }
+  return { ...settings };
+}
+
+function _applyFilter(lib: MixerLib, voice: number, f: FilterSettings | null): void {
+  if (!f) {
+    lib.jove_mixer_voice_set_filter(voice, 0, 1, 1, 1, 0, 0);
+    return;
+  }
+  lib.jove_mixer_voice_set_filter(
+    voice,
+    FILTER_TYPES[f.type],
+    _clamp(f.volume ?? 1, 0, 1),
+    _clamp(f.lowgain ?? 1, 0, 1),
+    _clamp(f.highgain ?? 1, 0, 1),
+    f.frequency ?? FILTER_DEFAULT_FREQ[f.type],
+    f.q ?? 0.707,
+  );
+}
+
+/** Pack effect settings into the six native parameter slots (see jove_mixer_effect_set_params). */
+function _effectParams(s: EffectSettings): [number, number, number, number, number, number] {
+  const volume = _clamp(s.volume ?? 1, 0, 1);
+  switch (s.type) {
+    case "reverb":
+      return [
+        _clamp(s.gain ?? 0.32, 0, 1),
+        _clamp(s.decaytime ?? 1.49, 0.1, 20),
+        _clamp(s.hfgain ?? 0.89, 0, 1),
+        _clamp(s.diffusion ?? 1, 0, 1),
+        volume,
+        0,
+      ];
+    case "echo":
+    case "delay":
+      return [
+        _clamp(s.delay ?? 0.1, 0, 1),
+        _clamp(s.lrdelay ?? 0.1, 0, 1),
+        _clamp(s.feedback ?? 0.5, 0, 0.99),
+        _clamp(s.damping ?? 0.5, 0, 0.99),
+        volume,
+        0,
+      ];
+    case "compressor":
+      return [
+        Math.min(0, s.threshold ?? -18),
+        Math.max(1, s.ratio ?? 4),
+        Math.max(0, s.attack ?? 0.005),
+        Math.max(0, s.release ?? 0.1),
+        s.makeup ?? 0,
+        volume,
+      ];
+    case "limiter":
+      return [
+        Math.min(0, s.threshold ?? -1),
+        Math.max(1, s.ratio ?? 1000),
+        Math.max(0, s.attack ?? 0.001),
+        Math.max(0, s.release ?? 0.05),
+        s.makeup ?? 0,
+        volume,
+      ];
+  }
+}
+
+// ============================================================
+// Mixer lifecycle
+// ============================================================
+
+/** Open the native mixer on the default playback device. Returns false if unavailable. */
+export function _openMixer(): boolean {
+  if (_mixer) return true;
+  const lib = loadMixer();
+  if (!lib) return false;
+  const rate = lib.jove_mixer_open(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK);
+  if (!rate) return false;
+  _mixer = lib;
+  _mixRate = rate;
+  _endedTable = lib.jove_mixer_get_ended_table() as unknown as Pointer;
+  _endedCounter = lib.jove_mixer_get_ended_counter() as unknown as Pointer;
+  _lastEndedCount = read.i32(_endedCounter, 0);
+  // The mixer starts from defaults — push any listener state set before it opened
+  _applyListener();
+  _applyDistanceModel();
+  return true;
+}
+
+/** Close the mixer. Sources must be released first. */
+export function _closeMixer(): void {
+  if (!_mixer) return;
+  _mixer.jove_mixer_close();
+  _mixer = null;
+  _mixRate = 0;
+  _endedTable = null;
+  _endedCounter = null;
+  _anyEnded = false;
+  _generation++;
+  _effects.clear();
+  _mixerSources.clear();
+}
+
+/**
+ * Check the shared ended counter once per frame (no FFI call). Mixer sources only
+ * look at their own flag when it changed, so steady-state polling is a single read.
+ */
+export function _beginMixerPoll(): void {
+  if (!_endedCounter) return;
+  const count = read.i32(_endedCounter, 0);
+  _anyEnded = count !== _lastEndedCount;
+  _lastEndedCount = count;
+}
+
+/** True if static sources are being mixed natively. */
+export function _isMixerOpen(): boolean {
+  return _mixer !== null;
+}
+
+/** Frames rendered by the mixer but not yet played by the device (0 if not open). */
+export function _getMixerQueuedFrames(): number {
+  return _mixer ? _mixer.jove_mixer_get_queued_frames() : 0;
+}
+
+/** Mix rate of the native mixer in Hz (0 if not open). */
+export function _getMixRate(): number {
+  return _mixRate;
+}
+
+/** Bumped each time the mixer closes; voices from an older generation are dead. */
+export function _getMixerGeneration(): number {
+  return _generation;
+}
+
+/** Open audio (and with it the mixer) on demand. Returns false if the mixer is unavailable. */
+export function _ensureMixer(): boolean {
+  if (_mixer) return true;
+  if (!_init()) return false;
+  _ensureDevice();
+  return _mixer !== null;
+}
+
+// ============================================================
+// Listener
+// ============================================================
+
+const _listener = {
+  position: [0, 0, 0] as [number, number, number],
+  // forward x, y, z, up x, y, z (OpenAL default: looking down -z, y up → +x is right)
+  orientation: [0, 0, -1, 0, 1, 0] as [number, number, number, number, number, number],
+};
+let _distanceModel: DistanceModel = "inverseclamped";
+
+function _applyListener(): void {
+  if (!_mixer) return;
+  const [x, y, z] = _listener.position;
+  const [fx, fy, fz, ux, uy, uz] = _listener.orientation;
+  _mixer.jove_mixer_set_listener(x, y, z, fx, fy, fz, ux, uy, uz);
+}
+
+function _applyDistanceModel(): void {
+  if (!_mixer) return;
+  const [model, clamped] = DISTANCE_MODELS[_distanceModel];
+  _mixer.jove_mixer_set_distance_model(model, clamped);
+}
+
+/** Set the listener position. */
+export function setPosition(x: number, y: number, z: number = 0): void {
+  _listener.position = [x, y, z];
+  _applyListener();
+}
+
+/** Get the listener position. */
+export function getPosition(): [number, number, number] {
+  return [..._listener.position];
+}
+
+/** Set the listener orientation as forward and up vectors. */
+export function setOrientation(fx: number, fy: number, fz: number, ux: number, uy: number, uz: number): void {
+  _listener.orientation = [fx, fy, fz, ux, uy, uz];
+  _applyListener();
+}
+
+/** Get the listener orientation: forward x, y, z, up x, y, z. */
+export function getOrientation(): [number, number, number, number, number, number] {
+  return [..._listener.orientation];
+}
+
+/** Set how positional sources attenuate with distance (love2d names). Default "inverseclamped". */
+export function setDistanceModel(model: DistanceModel): void {
+  if (!DISTANCE_MODELS[model]) throw new Error(`Invalid distance model: ${model}`);
+  _distanceModel = model;
+  _applyDistanceModel();
+}
+
+/** Get the current distance model. */
+export function getDistanceModel(): DistanceModel {
+  return _distanceModel;
+}
+
+/** Internal hook on mixer sources for bulk position updates. */
+interface PositionalSource {
+  /** Store a position and return the voice index to update natively (-1 to skip). */
+  _storePosition(x: number, y: number, z: number): number;
+}
+
+// Scratch voice list for setSourcePositions — grown on demand, ptr() taken fresh per call
+let _bulkVoices = new Int32Array(256);
+
+/**
+ * Update the positions of many sources in one native call (jove2d extension).
+ * positions holds x, y, z per source, in the same order as sources. Sources that
+ * aren't mono mixer sources are skipped.
+ */
+export function setSourcePositions(sources: ArrayLike<Source>, positions: Float32Array): void {
+  const count = Math.min(sources.length, Math.floor(positions.length / 3));
+  if (count === 0) return;
+  if (_bulkVoices.length < count) _bulkVoices = new Int32Array(Math.max(count, _bulkVoices.length * 2));
+  const voices = _bulkVoices;
+  for (let i = 0; i < count; i++) {
+    const s = sources[i] as Partial<PositionalSource> | undefined;
+    voices[i] = s?._storePosition
+      ? s._storePosition(positions[i * 3]!, positions[i * 3 + 1]!, positions[i * 3 + 2]!)
+      : -1;
+  }
+  _mixer?.jove_mixer_voice_set_positions(ptr(voices), ptr(positions), count);
+}
+
+// ============================================================
+// Sample clock (scheduled playback)
+// ============================================================
+
+/**
+ * Current time of the mixer's output clock in samples (frames at getSampleRate()),
+ * as of the last audio callback. Schedule with source.playAt(getSampleTime() + n).
+ * Returns 0 without the native mixer.
+ */
+export function getSampleTime(): number {
+  return _mixer ? _mixer.jove_mixer_get_clock() : 0;
+}
+
+/** Sample rate of the mixer clock in Hz (0 without the native mixer). */
+export function getSampleRate(): number {
+  return _mixRate;
+}
+
+// ============================================================
+// Scene effects
+// ============================================================
+
+interface SceneEffect {
+  idx: number;
+  nativeType: number;
+  settings: EffectSettings;
+}
+
+const _effects = new Map<string, SceneEffect>();
+
+/** Mixer-backed sources, so routing can be refreshed when an effect is (re)created. */
+const _mixerSources = new Set<{ _refreshSends(): void }>();
+
+/**
+ * Create, update, or remove (settings = false) a named scene effect.
+ * Sources route into it with source.setEffect(name). Returns false if effects are
+ * unsupported or all effect slots are in use.
+ */
+export function setEffect(name: string, settings: EffectSettings | false): boolean {
+  if (settings === false) {
+    const fx = _effects.get(name);
+    if (!fx) return false;
+    _mixer?.jove_mixer_effect_free(fx.idx);
+    _effects.delete(name);
+    return true;
+  }
+  const nativeType = EFFECT_TYPES[settings.type];
+  if (!nativeType) throw new Error(`Invalid effect type: ${settings.type}`);
+  if (!_ensureMixer()) return false;
+  const lib = _mixer!;
+
+  let fx = _effects.get(name);
+  if (fx && fx.nativeType !== nativeType) {
+    lib.jove_mixer_effect_free(fx.idx);
+    _effects.delete(name);
+    fx = undefined;
+  }
+  const created = !fx;
+  if (!fx) {
+    const idx = lib.jove_mixer_effect_create(nativeType);
+    if (idx < 0) return false;
+    fx = { idx, nativeType, settings };
+    _effects.set(name, fx);
+  }
+  fx.settings = { ...settings };
+  const p = _effectParams(settings);
+  lib.jove_mixer_effect_set_params(fx.idx, p[0], p[1], p[2], p[3], p[4], p[5]);
+
+  // Sources may already be routed to this name — point their sends at the new slot
+  if (created) {
+    for (const s of _mixerSources) s._refreshSends();
+  }
+  return true;
+}
+
+/** Get a copy of a scene effect's settings, or null if it doesn't exist. */
+export function getEffect(name: string): EffectSettings | null {
+  const fx = _effects.get(name);
+  return fx ? { ...fx.settings } : null;
+}
+
+/** Names of all active scene effects. */
+export function getActiveEffects(): string[] {
+  return [..._effects.keys()];
+}
+
+/** Maximum number of simultaneous scene effects (0 if effects are unsupported). */
+export function getMaxSceneEffects(): number {
+  const lib = loadMixer();
+  return lib ? lib.jove_mixer_get_max_effects() : 0;
+}
+
+/** Maximum number of effects a single source can route into (0 if unsupported). */
+export function getMaxSourceEffects(): number {
+  const lib = loadMixer();
+  return lib ? lib.jove_mixer_get_max_sends() : 0;
+}
+
+/** Whether filters and effects are supported (native mixer library present). */
+export function isEffectsSupported(): boolean {
+  return loadMixer() !== null;
+}
+
+/**
+ * Stand-in methods for sources that don't play through the mixer: filters and
+ * effects report unsupported, positional settings and loop points are accepted but
+ * not applied, and playAt() starts playback immediately.
+ */
+export function _noMixerSupport() {
+  let loopPoints: [number, number] = [0, 0];
+  let position: [number, number, number] = [0, 0, 0];
+  let distances: [number, number] = [1, Number.MAX_VALUE];
+  let rolloff = 1;
+  let relative = false;
+  return {
+    setFilter(_settings?: FilterSettings | null): boolean { return false; },
+    getFilter(): FilterSettings | null { return null; },
+    setEffect(_name: string, _filter?: FilterSettings | boolean): boolean { return false; },
+    getEffect(_name: string): FilterSettings | null { return null; },
+    getActiveEffects(): string[] { return []; },
+    setLoopPoints(start: number, end: number = 0): void { loopPoints = [start, end]; },
+    getLoopPoints(): [number, number] { return [...loopPoints]; },
+    playAt(this: Source, _sampleTime: number): void { this.play(); },
+    setPosition(x: number, y: number, z: number = 0): void { position = [x, y, z]; },
+    getPosition(): [number, number, number] { return [...position]; },
+    setAttenuationDistances(ref: number, max: number): void { distances = [ref, max]; },
+    getAttenuationDistances(): [number, number] { return [...distances]; },
+    setRolloff(r: number): void { rolloff = r; },
+    getRolloff(): number { return rolloff; },
+    setRelative(rel: boolean): void { relative = rel; },
+    isRelative(): boolean { return relative; },
+  };
+}
+
+// ============================================================
+// Mixer-backed static source
+// ============================================================
+
+/**
+ * Native PCM buffer shared between a source and its clones. Each source counts as one
+ * reference, dropped when the source is collected; the last one frees the buffer.
+ */
+interface MixerBuffer {
+  idx: number;
+  generation: number;
+  frames: number;
+  /** Channels as stored (the mixer folds more than two down to stereo). */
+  channels: number;
+  refs: number;
+}
+
+const _bufferRefs = new FinalizationRegistry<MixerBuffer>((buffer) => {
+  if (--buffer.refs > 0) return;
+  if (_mixer && buffer.generation === _generation) _mixer.jove_mixer_buffer_free(buffer.idx);
+});
+
+function _createBuffer(audioData: Uint8Array, format: number, channels: number, freq: number): MixerBuffer | null {
+  if (!_mixer || audioData.length === 0) return null;
+  // The mixer converts to S16 internally, so the JS copy can be dropped once the source is
+  const idx = _mixer.jove_mixer_buffer_create(ptr(audioData), audioData.length, format, channels, freq);
+  if (idx < 0) return null;
+  const frames = _mixer.jove_mixer_buffer_get_frames(idx);
+  return { idx, generation: _generation, frames, channels: Math.min(channels, 2), refs: 0 };
+}
+
+/** A JS copy of a buffer's S16 samples, for an SDL-stream clone when the mixer is out of voices. */
+function _readBuffer(buffer: MixerBuffer): Uint8Array | null {
+  if (!_mixer || buffer.generation !== _generation) return null;
+  const data = _mixer.jove_mixer_buffer_get_data(buffer.idx);
+  if (!data) return null;
+  return new Uint8Array(toArrayBuffer(data, 0, buffer.frames * buffer.channels * 2).slice(0));
+}
+
+/**
+ * What a mixer voice plays: a PCM buffer, or a synth oscillator (audio-synth.ts).
+ * Everything else — gain, pitch, filters, sends, position, scheduling — is shared.
+ */
+export interface VoiceBacking {
+  /** Mixer generation the backing belongs to; voices die with it. */
+  generation: number;
+  /** Length in frames at `rate`; 0 = unbounded (seek is a no-op, duration is -1). */
+  frames: number;
+  rate: number;
+  channels: number;
+  /** Create a fresh native voice, or -1. */
+  create(lib: MixerLib): number;
+  /** Push backing-specific state to a freshly created voice. */
+  configure(lib: MixerLib, voice: number): void;
+  /** A new source on the same backing (settings are copied by the caller). */
+  clone(): Source;
+}
+
+/** Mixer sources expose their current native voice so extensions can drive it. */
+export interface VoiceSource extends Source {
+  /** Native voice index, or -1 if the voice is released or the mixer closed. */
+  _voiceIndex(): number;
+}
+
+/**
+ * Create a static source that plays as a native mixer voice.
+ * Returns null if the mixer isn't open or out of voices/buffers — the caller
+ * falls back to an SDL-stream source.
+ */
+export function _createMixerSource(
+  audioData: Uint8Array,
+  format: number,
+  channels: number,
+  freq: number,
+  sourceType: SourceType,
+): Source | null {
+  const buffer = _createBuffer(audioData, format, channels, freq);
+  if (!buffer) return null;
+  const source = _sourceOnBuffer(buffer, freq, sourceType);
+  // Nothing holds the buffer yet, so free it now rather than leave it to the collector
+  if (!source && _mixer) _mixer.jove_mixer_buffer_free(buffer.idx);
+  return source;
+}
+
+/** A source on a shared buffer. Holds no reference to the PCM it was made from. */
+function _sourceOnBuffer(buffer: MixerBuffer, freq: number, sourceType: SourceType): Source | null {
+  const source = _createVoiceSource({
+    generation: buffer.generation,
+    frames: buffer.frames,
+    rate: freq,
+    channels: buffer.channels,
+    create: (lib) => lib.jove_mixer_voice_create(buffer.idx),
+    configure() {},
+    clone(): Source {
+      const cloned = _sourceOnBuffer(buffer, freq, sourceType);
+      if (cloned) return cloned;
+      // Out of voices (or the mixer closed): fall back to an SDL stream on a copy of the PCM
+      const pcm = _readBuffer(buffer);
+      if (!pcm) throw new Error("Source:clone: the mixer buffer is gone (mixer closed)");
+      return _createSource(pcm, SDL_AUDIO_S16, buffer.channels, freq, sourceType);
+    },
+  }, sourceType);
+  if (!source) return null;
+  buffer.refs++;
+  _bufferRefs.register(source, buffer);
+  return source;
+}
+
+/** Create a source around a native mixer voice. Returns null if the mixer is closed or out of voices. */
+export function _createVoiceSource(backing: VoiceBacking, sourceType: SourceType): VoiceSource | null {
+  if (!_mixer || backing.generation !== _generation) return null;
+  const lib = _mixer;
+  const freq = backing.rate;
+  const frames = backing.frames;
+
+  let _voice = backing.create(lib);
+  if (_voice < 0) return null;
+
+  let _state: "stopped" | "playing" | "paused" = "stopped";
+  let _volume = 1.0;
+  let _looping = false;
+  let _pitch = 1.0;
+  // Loop region in source frames (end 0 = end of buffer)
+  let _loopStart = 0;
+  let _loopEnd = 0;
+  // Identifies the current play() so a stale "ended" flag is never mistaken for a new one
+  let _seq = 0;
+  let _filter: FilterSettings | null = null;
+  // Effect name → send filter (null = unfiltered); insertion order = send slot
+  const _sends = new Map<string, FilterSettings | null>();
+  const duration = frames > 0 ? frames / freq : -1;
+  // Positional state — only mono sources can be positioned (as in love2d/OpenAL)
+  const mono = backing.channels === 1;
+  let _spatial = false;
+  let _x = 0, _y = 0, _z = 0;
+  let _refDist = 1;
+  let _maxDist = Number.MAX_VALUE;
+  let _rolloff = 1;
+  let _relative = false;
+
+  function _live(): boolean {
+    return _voice >= 0 && _mixer === lib && backing.generation === _generation;
+  }
+
+  function _applyGain(): void {
+    if (_live()) lib.jove_mixer_voice_set_gain(_voice, _volume * _getMasterVolume());
+  }
+
+  function _refreshSends(): void {
+    if (!_live()) return;
+    const max = lib.jove_mixer_get_max_sends();
+    let slot = 0;
+    for (const [name, f] of _sends) {
+      if (slot >= max) break;
+      const fx = _effects.get(name);
+      if (f) {
+        lib.jove_mixer_voice_set_send(
+          _voice, slot, fx ? fx.idx : -1, FILTER_TYPES[f.type],
+          _clamp(f.volume ?? 1, 0, 1), _clamp(f.lowgain ?? 1, 0, 1), _clamp(f.highgain ?? 1, 0, 1),
+          f.frequency ?? FILTER_DEFAULT_FREQ[f.type], f.q ?? 0.707,
+        );
+      } else {
+        lib.jove_mixer_voice_set_send(_voice, slot, fx ? fx.idx : -1, 0, 1, 1, 1, 0, 0);
+      }
+      slot++;
+    }
+    for (; slot < max; slot++) {
+      lib.jove_mixer_voice_set_send(_voice, slot, -1, 0, 1, 1, 1, 0, 0);
+    }
+  }
+
+  function _checkMono(): void {
+    if (!mono) throw new Error(MONO_ONLY_ERROR);
+  }
+
+  function _applySpatial(): void {
+    _spatial = true;
+    if (!_live()) return;
+    // f32 on the C side — keep "no maximum" finite
+    lib.jove_mixer_voice_set_spatial(_voice, _relative ? 1 : 0, _refDist, Math.min(_maxDist, 3.4e38), _rolloff);
+    lib.jove_mixer_voice_set_position(_voice, _x, _y, _z);
+  }
+
+  /** Push all voice parameters — used after (re)creating the voice. */
+  function _configure(): void {
+    backing.configure(lib, _voice);
+    _applyGain();
+    lib.jove_mixer_voice_set_pitch(_voice, _pitch);
+    lib.jove_mixer_voice_set_looping(_voice, _looping ? 1 : 0);
+    if (_loopStart > 0 || _loopEnd > 0) lib.jove_mixer_voice_set_loop_points(_voice, _loopStart, _loopEnd);
+    if (_filter) _applyFilter(lib, _voice, _filter);
+    if (_sends.size > 0) _refreshSends();
+    if (_spatial) _applySpatial();
+  }
+
+  const source: VoiceSource & { _refreshSends(): void } & PositionalSource = {
+    _type: sourceType,
+    _refreshSends,
+
+    _voiceIndex(): number {
+      return _live() ? _voice : -1;
+    },
+
+    _storePosition(x: number, y: number, z: number): number {
+      if (!mono) return -1;
+      _x = x; _y = y; _z = z;
+      if (!_spatial) {
+        // First positioning goes through the single-voice path to send the spatial settings
+        _applySpatial();
+        return -1;
+      }
+      return _live() ? _voice : -1;
+    },
+
+    play() {
+      source.playAt(-1);
+    },
+
+    playAt(sampleTime: number) {
+      if (!_live()) {
+        // Recreate the voice if it was auto-released after finishing
+        if (_mixer !== lib || backing.generation !== _generation) return;
+        _voice = backing.create(lib);
+        if (_voice < 0) return;
+        _configure();
+        _trackSource(source);
+        _mixerSources.add(source);
+      }
+      if (_state === "playing") {
+        // love2d: play() on playing source rewinds
+        lib.jove_mixer_voice_seek(_voice, 0);
+      }
+      _seq++;
+      if (sampleTime >= 0) {
+        // Counts as playing from now on; the audio thread holds it silent until sampleTime
+        lib.jove_mixer_voice_play_at(_voice, _seq, Math.floor(sampleTime));
+      } else {
+        lib.jove_mixer_voice_play(_voice, _seq);
+      }
+      _state = "playing";
+      _markActive(source);
+    },
+
+    pause() {
+      if (!_live() || _state !== "playing") return;
+      lib.jove_mixer_voice_pause(_voice);
+      _state = "paused";
+    },
+
+    stop() {
+      if (!_live()) return;
+      lib.jove_mixer_voice_stop(_voice);
+      _state = "stopped";
+    },
+
+    isPlaying() { return _state === "playing"; },
+    isStopped() { return _state === "stopped"; },
+    isPaused() { return _state === "paused"; },
+
+    setVolume(volume: number) {
+      _volume = Math.max(0, Math.min(1, volume));
+      _applyGain();
+    },
+    getVolume() { return _volume; },
+
+    setLooping(looping: boolean) {
+      _looping = looping;
+      if (_live()) lib.jove_mixer_voice_set_looping(_voice, looping ? 1 : 0);
+    },
+    isLooping() { return _looping; },
+
+    setLoopPoints(start: number, end: number = 0) {
+      const limit = frames > 0 ? frames : Infinity;
+      const first = Math.max(0, Math.min(limit, Math.floor(start * freq)));
+      const last = end > 0 ? Math.min(limit, Math.floor(end * freq)) : 0;
+      if (last > 0 && last <= first) throw new Error("Loop end must be after loop start");
+      _loopStart = first;
+      _loopEnd = last;
+      if (_live()) lib.jove_mixer_voice_set_loop_points(_voice, _loopStart, _loopEnd);
+    },
+    getLoopPoints(): [number, number] {
+      return [_loopStart / freq, _loopEnd / freq];
+    },
+
+    setPitch(pitch: number) {
+      _pitch = Math.max(0.01, pitch);
+      if (_live()) lib.jove_mixer_voice_set_pitch(_voice, _pitch);
+    },
+    getPitch() { return _pitch; },
+
+    seek(position: number) {
+      if (!_live() || frames === 0) return;
+      const frame = Math.max(0, Math.min(frames, Math.floor(position * freq)));
+      lib.jove_mixer_voice_seek(_voice, frame);
+    },
+
+    tell(): number {
+      if (!_live()) return 0;
+      return lib.jove_mixer_voice_tell(_voice) / freq;
+    },
+
+    getDuration(): number {
+      return duration;
+    },
+
+    clone(): Source {
+      const cloned = backing.clone();
+      cloned.setVolume(_volume);
+      cloned.setPitch(_pitch);
+      cloned.setLooping(_looping);
+      if (_loopStart > 0 || _loopEnd > 0) cloned.setLoopPoints(_loopStart / freq, _loopEnd / freq);
+      if (_filter) cloned.setFilter(_filter);
+      for (const [name, f] of _sends) cloned.setEffect(name, f ?? true);
+      if (_spatial) {
+        cloned.setAttenuationDistances(_refDist, _maxDist);
+        cloned.setRolloff(_rolloff);
+        cloned.setRelative(_relative);
+        cloned.setPosition(_x, _y, _z);
+      }
+      return cloned;
+    },
+
+    type(): SourceType {
+      return sourceType;
+    },
+
+    release() {
+      if (_live()) lib.jove_mixer_voice_free(_voice);
+      _voice = -1;
+      _state = "stopped";
+      _untrackSource(source);
+      _mixerSources.delete(source);
+    },
+
+    _poll(): boolean {
+      if (!_anyEnded || _state !== "playing" || !_live()) return false;
+      if (read.i32(_endedTable!, _voice * 4) === _seq) {
+        // Auto-stop when playback finished — signal for auto-release
+        _state = "stopped";
+        return true;
+      }
+      return false;
+    },
+
+    _applyMasterVolume() {
+      _applyGain();
+    },
+
+    // --- Filters and effects ---
+
+    setFilter(settings?: FilterSettings | null): boolean {
+      _filter = settings ? _checkFilter(settings) : null;
+      if (_live()) _applyFilter(lib, _voice, _filter);
+      return true;
+    },
+
+    getFilter(): FilterSettings | null {
+      return _filter ? { ..._filter } : null;
+    },
+
+    setEffect(name: string, filter: FilterSettings | boolean = true): boolean {
+      if (filter === false) {
+        if (!_sends.delete(name)) return false;
+        _refreshSends();
+        return true;
+      }
+      if (!_effects.has(name)) return false;
+      if (!_sends.has(name) && _sends.size >= lib.jove_mixer_get_max_sends()) return false;
+      _sends.set(name, filter === true ? null : _checkFilter(filter));
+      _refreshSends();
+      return true;
+    },
+
+    getEffect(name: string): FilterSettings | null {
+      const f = _sends.get(name);
+      return f ? { ...f } : null;
+    },
+
+    getActiveEffects(): string[] {
+      return [..._sends.keys()].filter((name) => _effects.has(name));
+    },
+
+    // --- Positional audio ---
+
+    setPosition(x: number, y: number, z: number = 0) {
+      _checkMono();
+      _x = x; _y = y; _z = z;
+      if (!_spatial) {
+        _applySpatial();
+      } else if (_live()) {
+        lib.jove_mixer_voice_set_position(_voice, x, y, z);
+      }
+    },
+    getPosition(): [number, number, number] {
+      return [_x, _y, _z];
+    },
+
+    setAttenuationDistances(ref: number, max: number) {
+      _checkMono();
+      _refDist = Math.max(0, ref);
+      _maxDist = Math.max(_refDist, max);
+      _applySpatial();
+    },
+    getAttenuationDistances(): [number, number] {
+      return [_refDist, _maxDist];
+    },
+
+    setRolloff(rolloff: number) {
+      _checkMono();
+      _rolloff = Math.max(0, rolloff);
+      _applySpatial();
+    },
+    getRolloff() { return _rolloff; },
+
+    setRelative(relative: boolean) {
+      _checkMono();
+      _relative = relative;
+      _applySpatial();
+    },
+    isRelative() { return _relative; },
+  };
+
+  _trackSource(source);
+  _mixerSources.add(source);
+  return source;
+}
@@ -0,0 +1,144 @@
+// jove2d synth sources — oscillators and envelopes rendered on the audio thread
+// jove2d extension (no love2d equivalent); re-exported from audio.ts.
+//
+// A synth is a native mixer voice that runs an oscillator instead of reading a buffer,
+// so generated sound has the same fixed latency as sample playback and never waits on
+// the JS frame loop. It is a full Source — volume, pitch, filters, effect sends,
+// position and playAt() all apply — plus frequency, waveform and an ADSR envelope.
+
+import { loadMixer } from "../sdl/ffi_mixer.ts";
+import { _createVoiceSource, _ensureMixer, _getMixRate, _getMixerGeneration } from "./audio-mixer.ts";
+import type { MixerLib, VoiceBacking } from "./audio-mixer.ts";
+import type { Source } from "./audio.ts";
+
+export type Waveform = "sine" | "square" | "saw" | "triangle" | "noise";
+
+/** ADSR envelope. Times in seconds; sustain is a level from 0 to 1. */
+export interface Envelope {
+  attack: number;
+  decay: number;
+  sustain: number;
+  release: number;
+}
+
+export interface SynthSource extends Source {
+  setWaveform(waveform: Waveform, pulseWidth?: number): void;
+  getWaveform(): Waveform;
+  /** Pulse width of the square wave (0..1, default 0.5). */
+  getPulseWidth(): number;
+  /** Oscillator frequency in Hz, reached over roughly `glide` seconds (default 0 = immediately). */
+  setFrequency(hz: number, glide?: number): void;
+  getFrequency(): number;
+  /** Set the envelope applied from the next note, or null for none (full level, note-off stops). */
+  setEnvelope(envelope: Envelope | null): void;
+  getEnvelope(): Envelope | null;
+  /** Start a note: retrigger the envelope, optionally at a new frequency. */
+  noteOn(hz?: number): void;
+  /** noteOn() on an exact mixer sample (see audio.getSampleTime()). */
+  noteOnAt(sampleTime: number, hz?: number): void;
+  /** Release the note; the source stops once the envelope's release finishes. */
+  noteOff(): void;
+  /** noteOff() on an exact mixer sample. */
+  noteOffAt(sampleTime: number): void;
+}
+
+const WAVEFORMS: Record<Waveform, number> = { sine: 1, square: 2, saw: 3, triangle: 4, noise: 5 };
+
+/**
+ * Create a synth source (jove2d extension). Returns null without the native mixer —
+ * synthesis only runs on the audio thread.
+ */
+export function newSynth(waveform: Waveform = "sine"): SynthSource | null {
+  if (!(waveform in WAVEFORMS)) throw new Error(`Invalid waveform: ${waveform}`);
+  if (!_ensureMixer()) return null;
+
+  let _waveform = waveform;
+  let _pulseWidth = 0.5;
+  let _frequency = 440;
+  let _envelope: Envelope | null = null;
+
+  const backing: VoiceBacking = {
+    generation: _getMixerGeneration(),
+    frames: 0,
+    rate: _getMixRate(),
+    channels: 1,
+    create: (lib) => lib.jove_mixer_synth_create(WAVEFORMS[_waveform]),
+    configure(lib, voice) {
+      lib.jove_mixer_voice_set_waveform(voice, WAVEFORMS[_waveform], _pulseWidth);
+      lib.jove_mixer_voice_set_frequency(voice, _frequency, 0);
+      _pushEnvelope(lib, voice);
+    },
+    clone(): Source {
+      const cloned = newSynth(_waveform);
+      if (!cloned) throw new Error("Cannot clone a synth Source: the mixer is closed or out of voices");
+      cloned.setWaveform(_waveform, _pulseWidth);
+      cloned.setFrequency(_frequency);
+      cloned.setEnvelope(_envelope);
+      return cloned;
+    },
+  };
+  const voiceSource = _createVoiceSource(backing, "static");
+  if (!voiceSource) return null;
+
+  function _pushEnvelope(lib: MixerLib, voice: number): void {
+    const e = _envelope;
+    if (e) lib.jove_mixer_voice_set_envelope(voice, 1, e.attack, e.decay, e.sustain, e.release);
+    else lib.jove_mixer_voice_set_envelope(voice, 0, 0, 0, 1, 0);
+  }
+
+  /** Run `fn` against the live voice, if there is one. */
+  function _withVoice(fn: (lib: MixerLib, voice: number) => void): void {
+    const voice = voiceSource!._voiceIndex();
+    if (voice >= 0) fn(loadMixer()!, voice);
+  }
+
+  const synth: SynthSource = Object.assign(voiceSource, {
+    setWaveform(waveform: Waveform, pulseWidth: number = _pulseWidth): void {
+      if (!(waveform in WAVEFORMS)) throw new Error(`Invalid waveform: ${waveform}`);
+      _waveform = waveform;
+      _pulseWidth = Math.max(0.01, Math.min(0.99, pulseWidth));
+      _withVoice((lib, voice) => lib.jove_mixer_voice_set_waveform(voice, WAVEFORMS[_waveform], _pulseWidth));
+    },
+    getWaveform(): Waveform { return _waveform; },
+    getPulseWidth(): number { return _pulseWidth; },
+
+    setFrequency(hz: number, glide: number = 0): void {
+      _frequency = Math.max(0, hz);
+      _withVoice((lib, voice) => lib.jove_mixer_voice_set_frequency(voice, _frequency, Math.max(0, glide)));
+    },
+    getFrequency(): number { return _frequency; },
+
+    setEnvelope(envelope: Envelope | null): void {
+      _envelope = envelope
+        ? {
+            attack: Math.max(0, envelope.attack),
+            decay: Math.max(0, envelope.decay),
+            sustain: Math.max(0, Math.min(1, envelope.sustain)),
+            release: Math.max(0, envelope.release),
+          }
+        : null;
+      _withVoice(_pushEnvelope);
+    },
+    getEnvelope(): Envelope | null {
+      return _envelope ? { ..._envelope } : null;
+    },
+
+    noteOn(hz?: number): void {
+      synth.noteOnAt(-1, hz);
+    },
+    noteOnAt(sampleTime: number, hz?: number): void {
+      if (hz !== undefined) synth.setFrequency(hz);
+      // Always a fresh note from the attack — play() is the way to resume a paused synth
+      if (!synth.isStopped()) synth.stop();
+      synth.playAt(sampleTime);
+    },
+    noteOff(): void {
+      synth.noteOffAt(-1);
+    },
+    noteOffAt(sampleTime: number): void {
+      if (synth.isStopped()) return;
+      _withVoice((lib, voice) => lib.jove_mixer_voice_note_off(voice, sampleTime >= 0 ? Math.floor(sampleTime) : -1));
+    },
+  });
+  return synth;
+}
@@ -1,5 +1,6 @@
 // jove2d audio module — mirrors love.audio API
 // Uses SDL3's built-in audio API for WAV playback + OGG/MP3/FLAC via codec lib
+// Static sources play as native mixer voices (audio-mixer.ts) when the mixer lib is present
 
 import { ptr, read, toArrayBuffer } from "bun:ffi";
 import type { Pointer } from "bun:ffi";
@@ -13,6 +14,43 @@ import {
   SDL_INIT_AUDIO,
 } from "../sdl/types.ts";
 import type { Decoder } from "./sound.ts";
+import {
+  _openMixer,
+  _closeMixer,
+  _beginMixerPoll,
+  _createMixerSource,
+  _noMixerSupport,
+  _getMixerQueuedFrames,
+  setEffect,
+  getEffect,
+  getActiveEffects,
+} from "./audio-mixer.ts";
+import type { FilterSettings } from "./audio-mixer.ts";
+export {
+  setEffect,
+  getEffect,
+  getActiveEffects,
+  getMaxSceneEffects,
+  getMaxSourceEffects,
+  isEffectsSupported,
+  setPosition,
+  getPosition,
+  setOrientation,
+  getOrientation,
+  setDistanceModel,
+  getDistanceModel,
+  setSourcePositions,
+  getSampleTime,
+  getSampleRate,
+  _isMixerOpen,
+  _getMixRate,
+} from "./audio-mixer.ts";
+export type { FilterSettings, FilterType, EffectSettings, EffectType, DistanceModel } from "./audio-mixer.ts";
+import { _pollSoundBanks } from "./audio-bank.ts";
+export { newSoundBank } from "./audio-bank.ts";
+export type { SoundBank, SoundBankOptions, SoundBankStats } from "./audio-bank.ts";
+export { newSynth } from "./audio-synth.ts";
+export type { SynthSource, Waveform, Envelope } from "./audio-synth.ts";
 
 // SDL_AudioSpec: { format: i32, channels: i32, freq: i32 } = 12 bytes
 const AUDIOSPEC_SIZE = 12;
@@ -21,12 +59,46 @@ let _deviceId: number = 0;
 let _masterVolume = 1.0;
 let _initialized = false;
 
-// Device audio spec
+// Device audio spec requested on open (zero fields = device default)
 const _deviceSpec = new Int32Array(3); // format, channels, freq
-const _deviceSpecPtr = ptr(_deviceSpec);
+
+/** Playback device configuration for audio.setDeviceOptions (jove2d extension). */
+export interface DeviceOptions {
+  /** Device buffer size in sample frames. Smaller lowers latency at the cost of more wakeups. */
+  sampleFrames?: number;
+  /** Device sample format. Default: the driver's choice. */
+  format?: "s16" | "f32";
+  /** Device sample rate in Hz. Default: the device's native rate. */
+  sampleRate?: number;
+}
+
+/** Actual playback device configuration, as reported by SDL after opening. */
+export interface DeviceInfo {
+  driver: string;
+  sampleRate: number;
+  channels: number;
+  format: string;
+  sampleFrames: number;
+}
+
+const SAMPLE_FRAMES_HINT = Buffer.from("SDL_AUDIO_DEVICE_SAMPLE_FRAMES\0");
+const DEVICE_FORMATS: Record<NonNullable<DeviceOptions["format"]>, number> = { s16: SDL_AUDIO_S16, f32: SDL_AUDIO_F32 };
+const FORMAT_NAMES: Record<number, string> = {
+  [SDL_AUDIO_U8]: "u8",
+  [SDL_AUDIO_S16]: "s16",
+  [SDL_AUDIO_F32]: "f32",
+  0x8020: "s32",
+};
+
+let _deviceOptions: DeviceOptions = {};
+// Filled when the device opens — latency estimates read these instead of calling SDL
+let _deviceInfo: DeviceInfo | null = null;
 
 // Source tracking for global operations
 const _sources = new Set<Source>();
+// Sources that need per-frame polling. Added on play() and pruned by _updateSources()
+// once they stop playing, so idle (preloaded, stopped, paused) sources cost nothing.
+const _activeSources = new Set<Source>();
 
 /** Initialize the audio subsystem. Called internally. Device opened lazily on first use. */
 export function _init(): boolean {
@@ -45,11 +117,45 @@ export function _ensureDevice(): boolean {
   // Try zero-filled spec first — bun:ffi on Windows mishandles null pointer args,
   // causing audio clicking artifacts when SDL resamples to device format.
   // Fall back to null for dummy driver (which rejects zero-filled spec).
-  _deviceId = sdl.SDL_OpenAudioDevice(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, _deviceSpecPtr);
+  _applyDeviceOptions();
+  _deviceId = sdl.SDL_OpenAudioDevice(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, ptr(_deviceSpec));
   if (!_deviceId) {
     _deviceId = sdl.SDL_OpenAudioDevice(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, null);
   }
-  return _deviceId !== 0;
+  if (!_deviceId) return false;
+  _deviceInfo = _queryDeviceInfo();
+  // Native mixer (optional) — static sources play as voices on the audio thread
+  _openMixer();
+  return true;
+}
+
+/** Push setDeviceOptions() into the SDL hint and the requested spec before opening. */
+function _applyDeviceOptions(): void {
+  const { sampleFrames, format, sampleRate } = _deviceOptions;
+  if (sampleFrames) {
+    sdl.SDL_SetHint(SAMPLE_FRAMES_HINT, Buffer.from(`${sampleFrames}\0`));
+  } else {
+    sdl.SDL_ResetHint(SAMPLE_FRAMES_HINT);
+  }
+  _deviceSpec[0] = format ? DEVICE_FORMATS[format] : 0;
+  _deviceSpec[1] = 0;
+  _deviceSpec[2] = sampleRate ?? 0;
+}
+
+function _queryDeviceInfo(): DeviceInfo {
+  // Out-params — read back with read.* (the typed arrays may hold stale copies)
+  const spec = new Int32Array(3);
+  const frames = new Int32Array(1);
+  const specPtr = ptr(spec);
+  const framesPtr = ptr(frames);
+  sdl.SDL_GetAudioDeviceFormat(_deviceId, specPtr, framesPtr);
+  return {
+    driver: String(sdl.SDL_GetCurrentAudioDriver() ?? ""),
+    format: FORMAT_NAMES[read.i32(specPtr, 0)] ?? "unknown",
+    channels: read.i32(specPtr, 4),
+    sampleRate: read.i32(specPtr, 8),
+    sampleFrames: read.i32(framesPtr, 0),
+  };
 }
 
 /** Get the current audio device ID (0 if not open). */
@@ -57,6 +163,27 @@ export function _getDeviceId(): number {
   return _deviceId;
 }
 
+/** Get the master volume (for audio-mixer module). */
+export function _getMasterVolume(): number {
+  return _masterVolume;
+}
+
+/** Mark a source as playing so _updateSources() polls it (for audio-mixer module). */
+export function _markActive(source: Source): void {
+  _activeSources.add(source);
+}
+
+/** Track a source for global operations (for audio-mixer module). */
+export function _trackSource(source: Source): void {
+  _sources.add(source);
+}
+
+/** Stop tracking a source (for audio-mixer module). */
+export function _untrackSource(source: Source): void {
+  _sources.delete(source);
+  _activeSources.delete(source);
+}
+
 /** Shut down the audio system. Called internally. */
 export function _quit(): void {
   if (!_initialized) return;
@@ -65,17 +192,36 @@ export function _quit(): void {
     source.release();
   }
   _sources.clear();
+  _activeSources.clear();
+  _closeDevice();
+  _initialized = false;
+}
+
+function _closeDevice(): void {
+  _closeMixer();
   if (_deviceId) {
     sdl.SDL_CloseAudioDevice(_deviceId);
     _deviceId = 0;
   }
-  _initialized = false;
+  _deviceInfo = null;
 }
 
-/** Poll all playing sources for end-of-stream / looping / streaming feed. Call once per frame. */
+/**
+ * Poll playing sources for end-of-stream / looping / streaming feed. Call once per frame.
+ * Cost is proportional to playing sources only; mixer voices report completion through
+ * a shared flag table, so polling them makes no FFI calls.
+ */
 export function _updateSources(): void {
+  _pollSoundBanks();
+  if (_activeSources.size === 0) return;
+  _beginMixerPoll();
   let toRelease: Source[] | null = null;
-  for (const source of _sources) {
+  for (const source of _activeSources) {
+    if (!source.isPlaying()) {
+      // Stopped or paused since the last frame — nothing to poll until play() again
+      _activeSources.delete(source);
+      continue;
+    }
     // Feed streaming sources before polling
     if ((source as any)._feedStream) {
       (source as any)._feedStream();
@@ -117,6 +263,38 @@ export interface Source {
   clone(): Source;
   type(): SourceType;
   release(): void;
+  /** Set the direct-path filter; null/undefined removes it. Returns false if filters are unsupported. */
+  setFilter(settings?: FilterSettings | null): boolean;
+  /** Get the direct-path filter settings, or null if none. */
+  getFilter(): FilterSettings | null;
+  /** Route into a scene effect (see audio.setEffect), optionally through a filter. false removes it. */
+  setEffect(name: string, filter?: FilterSettings | boolean): boolean;
+  /** Get the filter on an effect send, or null if the send is unfiltered or absent. */
+  getEffect(name: string): FilterSettings | null;
+  /** Names of the scene effects this source is routed into. */
+  getActiveEffects(): string[];
+  /**
+   * Start playing on an exact sample of the mixer clock (see audio.getSampleTime()).
+   * The source counts as playing right away. Without the native mixer it starts immediately.
+   */
+  playAt(sampleTime: number): void;
+  /**
+   * Loop region in seconds, used while looping: playback runs from the current position
+   * and then cycles [start, end) gaplessly. end 0 = end of the sound. Mixer sources only.
+   */
+  setLoopPoints(start: number, end?: number): void;
+  getLoopPoints(): [number, number];
+  /** Position the source (mono sources only — throws for stereo, like love2d). */
+  setPosition(x: number, y: number, z?: number): void;
+  getPosition(): [number, number, number];
+  /** Reference distance (full volume) and maximum distance for attenuation. */
+  setAttenuationDistances(ref: number, max: number): void;
+  getAttenuationDistances(): [number, number];
+  setRolloff(rolloff: number): void;
+  getRolloff(): number;
+  /** Treat the position as relative to the listener. */
+  setRelative(relative: boolean): void;
+  isRelative(): boolean;
   /** @internal — returns true if source finished and should be auto-released */
   _poll(): boolean;
   /** @internal */
@@ -223,10 +401,16 @@ export function newSource(path: string, type: SourceType = "static"): Source | n
 
   const decoded = _decodeFile(path);
   if (!decoded) return null;
-  return _createSource(decoded.data, decoded.format, decoded.channels, decoded.freq, type);
+  return _createMixerSource(decoded.data, decoded.format, decoded.channels, decoded.freq, type)
+    ?? _createSource(decoded.data, decoded.format, decoded.channels, decoded.freq, type);
 }
 
-function _createSource(
+/**
+ * Create a static source backed by its own SDL audio stream.
+ * Used when the native mixer is unavailable or out of voices.
+ * @internal
+ */
+export function _createSource(
   audioData: Uint8Array,
   format: number,
   channels: number,
@@ -285,6 +469,7 @@ function _createSource(
 
   const source: Source = {
     _type: sourceType,
+    ..._noMixerSupport(),
 
     play() {
       if (!_deviceId) return;
@@ -310,6 +495,7 @@ function _createSource(
         // Resume from pause
         sdl.SDL_ResumeAudioStreamDevice(_stream);
         _state = "playing";
+        _activeSources.add(source);
         return;
       }
       // stopped → playing
@@ -319,6 +505,7 @@ function _createSource(
       _applyPitch();
       sdl.SDL_ResumeAudioStreamDevice(_stream);
       _state = "playing";
+      _activeSources.add(source);
     },
 
     pause() {
@@ -427,6 +614,7 @@ function _createSource(
       }
       _state = "stopped";
       _sources.delete(source);
+      _activeSources.delete(source);
     },
 
     _poll(): boolean {
@@ -476,7 +664,8 @@ function _createStreamSource(path: string): Source | null {
     // Decoder not available (lib missing) or file not supported — fall back to full decode
     const decoded = _decodeFile(path);
     if (!decoded) return null;
-    return _createSource(decoded.data, decoded.format, decoded.channels, decoded.freq, "stream");
+    return _createMixerSource(decoded.data, decoded.format, decoded.channels, decoded.freq, "stream")
+      ?? _createSource(decoded.data, decoded.format, decoded.channels, decoded.freq, "stream");
   }
 
   const channels = decoder.getChannelCount();
@@ -487,6 +676,10 @@ function _createStreamSource(path: string): Source | null {
   const _bytesPerSecond = sampleRate * channels * bytesPerSample;
   const totalDuration = totalFrames / sampleRate;
   const bufferSize = decoder._bufferSize;
+  // Chunks decode in place into the decoder's C-side buffer and are handed to SDL
+  // from there — steady-state streaming allocates nothing on the JS side.
+  const _chunk = decoder._buffer;
+  const frameBytes = channels * bytesPerSample;
   // Keep ~4 chunks in the stream at all times
   const LOW_WATER = 2;
   const HIGH_WATER = 4;
@@ -533,8 +726,8 @@ function _createStreamSource(path: string): Source | null {
     // Fill up to HIGH_WATER chunks
     let chunksToFeed = HIGH_WATER - pendingChunks;
     while (chunksToFeed > 0) {
-      const chunk = decoder.decode();
-      if (!chunk) {
+      const frames = decoder.decodeInto(_chunk);
+      if (frames === 0) {
         // EOF
         if (_looping) {
           decoder.seek(0);
@@ -543,7 +736,7 @@ function _createStreamSource(path: string): Source | null {
         // Mark EOF — let _poll handle auto-stop when stream drains
         break;
       }
-      sdl.SDL_PutAudioStreamData(_stream, ptr(chunk._data), chunk._data.length);
+      sdl.SDL_PutAudioStreamData(_stream, decoder._bufPtr, frames * frameBytes);
       sdl.SDL_FlushAudioStream(_stream);
       chunksToFeed--;
     }
@@ -552,9 +745,9 @@ function _createStreamSource(path: string): Source | null {
   /** Pre-fill stream buffer before starting playback. */
   function _prefill(): void {
     for (let i = 0; i < HIGH_WATER; i++) {
-      const chunk = decoder.decode();
-      if (!chunk) break;
-      sdl.SDL_PutAudioStreamData(_stream!, ptr(chunk._data), chunk._data.length);
+      const frames = decoder.decodeInto(_chunk);
+      if (frames === 0) break;
+      sdl.SDL_PutAudioStreamData(_stream!, decoder._bufPtr, frames * frameBytes);
     }
     sdl.SDL_FlushAudioStream(_stream!);
   }
@@ -562,6 +755,7 @@ function _createStreamSource(path: string): Source | null {
   const source: Source & { _feedStream: () => void } = {
     _type: "stream" as SourceType,
     _feedStream: _feedStream,
+    ..._noMixerSupport(),
 
     play() {
       if (!_deviceId) return;
@@ -588,6 +782,7 @@ function _createStreamSource(path: string): Source | null {
       if (_state === "paused") {
         sdl.SDL_ResumeAudioStreamDevice(_stream);
         _state = "playing";
+        _activeSources.add(source);
         return;
       }
       // stopped → playing
@@ -599,6 +794,7 @@ function _createStreamSource(path: string): Source | null {
       _applyPitch();
       sdl.SDL_ResumeAudioStreamDevice(_stream);
       _state = "playing";
+      _activeSources.add(source);
     },
 
     pause() {
@@ -673,6 +869,7 @@ function _createStreamSource(path: string): Source | null {
       decoder.close();
       _state = "stopped";
       _sources.delete(source);
+      _activeSources.delete(source);
     },
 
     _poll(): boolean {
@@ -723,7 +920,7 @@ export function newQueueableSource(
   if (!_initialized && !_init()) return null;
   if (!_ensureDevice()) return null;
 
-  const format = bitDepth === 16 ? SDL_AUDIO_S16 : SDL_AUDIO_U8;
+  const format = bitDepth === 32 ? SDL_AUDIO_F32 : bitDepth === 16 ? SDL_AUDIO_S16 : SDL_AUDIO_U8;
 
   const srcSpec = new Int32Array([format, channels, sampleRate]);
   const dstSpec = new Int32Array([format, channels, sampleRate]);
@@ -756,6 +953,7 @@ export function newQueueableSource(
 
   const source: QueueableSource = {
     _type: "queue" as SourceType,
+    ..._noMixerSupport(),
 
     play() {
       if (!_deviceId) return;
@@ -770,6 +968,7 @@ export function newQueueableSource(
       if (_state === "paused") {
         sdl.SDL_ResumeAudioStreamDevice(_stream);
         _state = "playing";
+        _activeSources.add(source);
         return;
       }
       if (_state === "playing") return; // No rewind for queueable
@@ -779,6 +978,7 @@ export function newQueueableSource(
       _applyPitch();
       sdl.SDL_ResumeAudioStreamDevice(_stream);
       _state = "playing";
+      _activeSources.add(source);
     },
 
     pause() {
@@ -834,6 +1034,7 @@ export function newQueueableSource(
       _state = "stopped";
       _lastChunkSize = 0;
       _sources.delete(source);
+      _activeSources.delete(source);
     },
 
     _poll(): boolean {
@@ -881,6 +1082,66 @@ export function newQueueableSource(
   return source;
 }
 
+// ============================================================
+// Device configuration and latency
+// ============================================================
+
+/**
+ * Configure the playback device: buffer size in sample frames, format, and rate
+ * (jove2d extension). If the device is open and no sources exist it is reopened right
+ * away, keeping scene effects; returns false if live sources prevent that, in which
+ * case the options apply the next time the device opens.
+ */
+export function setDeviceOptions(options: DeviceOptions): boolean {
+  const { sampleFrames, format, sampleRate } = options;
+  if (sampleFrames !== undefined && (!Number.isInteger(sampleFrames) || sampleFrames <= 0)) {
+    throw new Error(`Invalid sample frame count: ${sampleFrames}`);
+  }
+  if (format !== undefined && !DEVICE_FORMATS[format]) {
+    throw new Error(`Invalid device format: ${format}`);
+  }
+  if (sampleRate !== undefined && (!Number.isInteger(sampleRate) || sampleRate <= 0)) {
+    throw new Error(`Invalid sample rate: ${sampleRate}`);
+  }
+  _deviceOptions = { ...options };
+  if (!_deviceId) return true;
+  if (_sources.size > 0) return false;
+
+  const effects = getActiveEffects().map((name) => [name, getEffect(name)!] as const);
+  _closeDevice();
+  _ensureDevice();
+  for (const [name, settings] of effects) setEffect(name, settings);
+  return true;
+}
+
+/** Get the options last passed to setDeviceOptions. */
+export function getDeviceOptions(): DeviceOptions {
+  return { ..._deviceOptions };
+}
+
+/** Actual device configuration (null until the device opens on first source). */
+export function getDeviceInfo(): DeviceInfo | null {
+  return _deviceInfo ? { ..._deviceInfo } : null;
+}
+
+/**
+ * Sample frames mixed but not yet consumed by the device (native mixer only —
+ * SDL-stream sources queue their whole sound up front, so they aren't counted).
+ */
+export function getQueuedSamples(): number {
+  return _getMixerQueuedFrames();
+}
+
+/**
+ * Estimated output latency in seconds: one device buffer plus the mixer's queued
+ * frames. Driver/OS buffering beyond the device buffer isn't visible to SDL, so treat
+ * this as a lower bound. Returns 0 before the device opens.
+ */
+export function getLatency(): number {
+  if (!_deviceInfo || _deviceInfo.sampleRate <= 0) return 0;
+  return (_deviceInfo.sampleFrames + _getMixerQueuedFrames()) / _deviceInfo.sampleRate;
+}
+
 // ============================================================
 // Global audio controls
 // ============================================================
@@ -901,7 +1162,7 @@ export function getVolume(): number {
 /** Get the number of currently playing sources. */
 export function getActiveSourceCount(): number {
   let count = 0;
-  for (const source of _sources) {
+  for (const source of _activeSources) {
     if (source.isPlaying()) count++;
   }
   return count;
@@ -909,7 +1170,7 @@ export function getActiveSourceCount(): number {
 
 /** Pause all currently playing sources (no args). */
 export function pause(): void {
-  for (const source of _sources) {
+  for (const source of _activeSources) {
     if (source.isPlaying()) {
       source.pause();
     }
@@ -150,6 +150,13 @@ export function hash(
   return hasher.digest("hex");
 }
 
+/** Wrap `data` in a ByteData without copying it (shared views from jove.thread). */
+export function _wrapByteData(data: Uint8Array): ByteData {
+  const bytes = new ByteData(0);
+  bytes._data = data;
+  return bytes;
+}
+
 /**
  * Create a new ByteData object.
  * @param sizeOrData - byte count, Uint8Array, or string
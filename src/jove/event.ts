@@ -8,6 +8,7 @@ import {
   SDL_EVENT_QUIT,
   SDL_EVENT_WINDOW_SHOWN,
   SDL_EVENT_WINDOW_HIDDEN,
+  SDL_EVENT_WINDOW_EXPOSED,
   SDL_EVENT_WINDOW_MOVED,
   SDL_EVENT_WINDOW_RESIZED,
   SDL_EVENT_WINDOW_MINIMIZED,
@@ -66,6 +67,10 @@ import {
 } from "../sdl/types.ts";
 import type { JoveEvent } from "./types.ts";
 import { _getRenderer } from "./graphics.ts";
+import { getRandomState, setRandomState } from "./math.ts";
+import * as keyboard from "./keyboard.ts";
+import * as mouse from "./mouse.ts";
+import * as joystick from "./joystick.ts";
 
 // Pre-allocate event buffer — reused every poll call.
 // IMPORTANT: We must use read.u32/read.i32 from bun:ffi to read from the
@@ -151,6 +156,7 @@ export function pollEvents(): JoveEvent[] {
       sdl.SDL_ConvertEventToRenderCoordinates(renderer, eventPtr);
     }
     const eventType = read.u32(eventPtr, 0);
+    if (eventType === SDL_EVENT_WINDOW_EXPOSED) _exposed = true;
     const event = mapEvent(eventType, eventPtr);
     if (event) {
       events.push(event);
@@ -160,6 +166,46 @@ export function pollEvents(): JoveEvent[] {
   return events;
 }
 
+// ============================================================
+// Idle waiting (jove2d extension)
+// ============================================================
+
+let _idleWait = false;
+let _idleTimeout = 0;
+// Window contents need presenting again (SDL_EVENT_WINDOW_EXPOSED) — not a JoveEvent
+let _exposed = false;
+
+/**
+ * Let the game loop sleep in SDL_WaitEvent while graphics has nothing to redraw
+ * (retained mode with no dirty regions — see graphics.setRetainedMode). The loop wakes
+ * on the next event, or after `timeout` seconds if given (0 = wait indefinitely), then
+ * runs update() as usual with the elapsed time as dt.
+ */
+export function setIdleWait(enable: boolean, timeout: number = 0): void {
+  _idleWait = enable;
+  _idleTimeout = Math.max(0, timeout);
+}
+
+/** Get the idle wait setting: [enabled, timeout in seconds]. */
+export function getIdleWait(): [boolean, number] {
+  return [_idleWait, _idleTimeout];
+}
+
+/** Block until an event arrives if idle waiting is on and `idle` is true. Called by the game loop. */
+export function _waitIfIdle(idle: boolean): void {
+  if (!_idleWait || !idle || _injectedEvents.length > 0 || isPlayingBack()) return;
+  // NULL event: wait without removing it — pollEvents() picks it up right after
+  const ms = _idleTimeout > 0 ? Math.max(1, Math.round(_idleTimeout * 1000)) : -1;
+  sdl.SDL_WaitEventTimeout(null, ms);
+}
+
+/** Whether the window was exposed since the last call (its contents must be presented again). */
+export function _takeExposed(): boolean {
+  const exposed = _exposed;
+  _exposed = false;
+  return exposed;
+}
+
 function mapEvent(eventType: number, p: Pointer): JoveEvent | null {
   switch (eventType) {
     case SDL_EVENT_QUIT:
@@ -369,3 +415,347 @@ function mapEvent(eventType: number, p: Pointer): JoveEvent | null {
       return null;
   }
 }
+
+// --- Input recording and playback (jove2d extension) ---
+//
+// A recording is the event stream the game loop dispatched, frame by frame, with each
+// frame's dt. Playing it back feeds the same events and dt to the loop — and rebuilds the
+// keyboard/mouse snapshots from those events — so a session replays deterministically.
+//
+// Log layout (little-endian):
+//   header  u32 magic "JVIR", u16 version, u16 reserved, u32 frame count,
+//           string RNG state (jove.math) at the start of recording,
+//           u16 joystick count, joysticks open at the start of recording
+//   frame   f64 dt, u32 event count, events
+//   event   u8 type code, then the fields of RECORD_SCHEMA[code] in order;
+//           a joystickadded event is followed by the joystick it opened
+//   joystick  the fields of JOYSTICK_SCHEMA, so playback needs no matching device
+//   b = u8 bool, i = i32, f = f64, s = u16 byte length + UTF-8
+
+type FieldKind = "b" | "i" | "f" | "s";
+
+// Recordable event types; the index is the type code. Append only — codes live in logs.
+const RECORD_SCHEMA: [string, [string, FieldKind][]][] = [
+  ["quit", []],
+  ["focus", [["hasFocus", "b"]]],
+  ["resize", [["width", "i"], ["height", "i"]]],
+  ["moved", [["x", "i"], ["y", "i"]]],
+  ["minimized", []],
+  ["maximized", []],
+  ["restored", []],
+  ["shown", []],
+  ["hidden", []],
+  ["close", []],
+  ["keypressed", [["key", "s"], ["scancode", "s"], ["isRepeat", "b"]]],
+  ["keyreleased", [["key", "s"], ["scancode", "s"]]],
+  ["mousepressed", [["x", "f"], ["y", "f"], ["button", "i"], ["clicks", "i"]]],
+  ["mousereleased", [["x", "f"], ["y", "f"], ["button", "i"]]],
+  ["mousemoved", [["x", "f"], ["y", "f"], ["dx", "f"], ["dy", "f"]]],
+  ["wheelmoved", [["x", "f"], ["y", "f"]]],
+  ["textinput", [["text", "s"]]],
+  ["textedited", [["text", "s"], ["start", "i"], ["length", "i"]]],
+  ["filedropped", [["path", "s"]]],
+  ["joystickadded", [["instanceId", "i"]]],
+  ["joystickremoved", [["instanceId", "i"]]],
+  ["joystickpressed", [["instanceId", "i"], ["button", "i"]]],
+  ["joystickreleased", [["instanceId", "i"], ["button", "i"]]],
+  ["joystickaxis", [["instanceId", "i"], ["axis", "i"], ["value", "f"]]],
+  ["joystickhat", [["instanceId", "i"], ["hat", "i"], ["direction", "s"]]],
+  ["gamepadpressed", [["instanceId", "i"], ["button", "s"]]],
+  ["gamepadreleased", [["instanceId", "i"], ["button", "s"]]],
+  ["gamepadaxis", [["instanceId", "i"], ["axis", "s"], ["value", "f"]]],
+];
+const RECORD_CODES = new Map(RECORD_SCHEMA.map(([type], code) => [type, code]));
+const JOYSTICKADDED_CODE = RECORD_CODES.get("joystickadded")!;
+// joystick.RecordedJoystick
+const JOYSTICK_SCHEMA: [string, FieldKind][] = [
+  ["instanceId", "i"], ["id", "i"], ["gamepad", "b"], ["name", "s"],
+  ["axes", "i"], ["buttons", "i"], ["hats", "i"],
+  ["vendor", "i"], ["product", "i"], ["version", "i"],
+];
+const RECORD_MAGIC = 0x5249564a; // "JVIR"
+const RECORD_VERSION = 3;
+const RECORD_FRAME_COUNT_OFFSET = 8;
+
+const _utf8Encoder = new TextEncoder();
+const _utf8Decoder = new TextDecoder();
+
+// Recorder: growable byte buffer
+let _recBytes: Uint8Array | null = null;
+let _recView: DataView | null = null;
+let _recLength = 0;
+let _recFrames = 0;
+
+export interface PlaybackOptions {
+  /** Push a quit event when the recording runs out (default false: resume live input). */
+  quitAtEnd?: boolean;
+}
+
+/** Wall-clock timing of a playback, for using recordings as benchmarks. */
+export interface PlaybackStats {
+  /** Frames replayed so far. */
+  frames: number;
+  /** Frames in the recording. */
+  totalFrames: number;
+  /** Wall-clock seconds since playback started. */
+  seconds: number;
+  meanFrameMs: number;
+  p95FrameMs: number;
+  maxFrameMs: number;
+}
+
+// Player state
+let _playView: DataView | null = null;
+let _playBytes: Uint8Array | null = null;
+let _playOffset = 0;
+let _playFrame = 0;
+let _playTotal = 0;
+let _playQuitAtEnd = false;
+let _playStart = 0;
+let _playLastTime = 0;
+let _playFrameTimes = new Float64Array(0);
+let _playFinished = false;
+
+function _recEnsure(bytes: number): void {
+  if (_recLength + bytes <= _recBytes!.length) return;
+  const grown = new Uint8Array(Math.max(_recBytes!.length * 2, _recLength + bytes));
+  grown.set(_recBytes!.subarray(0, _recLength));
+  _recBytes = grown;
+  _recView = new DataView(grown.buffer);
+}
+
+function _recString(s: string): void {
+  const bytes = _utf8Encoder.encode(s);
+  let len = Math.min(bytes.length, 0xffff);
+  // Truncate on a character boundary: back off past UTF-8 continuation bytes
+  if (len < bytes.length) while (len > 0 && (bytes[len]! & 0xc0) === 0x80) len--;
+  _recEnsure(2 + len);
+  _recView!.setUint16(_recLength, len, true);
+  _recBytes!.set(bytes.subarray(0, len), _recLength + 2);
+  _recLength += 2 + len;
+}
+
+function _recEvent(ev: JoveEvent, code: number): void {
+  _recEnsure(1);
+  _recView!.setUint8(_recLength++, code);
+  _recFields(ev as Record<string, unknown>, RECORD_SCHEMA[code]![1]);
+  if (code === JOYSTICKADDED_CODE) {
+    // Open it now (dispatch gets the same object) to record what playback must stand in for
+    const instanceId = (ev as { instanceId: number }).instanceId;
+    const joy = joystick._onJoystickAdded(instanceId);
+    _recJoystick(joy ? joystick._record(joy) : { instanceId, id: 0 });
+  }
+}
+
+/** A joystick record; { instanceId, id: 0 } for one that failed to open. */
+function _recJoystick(device: joystick.RecordedJoystick | { instanceId: number; id: 0 }): void {
+  _recFields(device as unknown as Record<string, unknown>, JOYSTICK_SCHEMA);
+}
+
+function _recFields(fields: Record<string, unknown>, schema: [string, FieldKind][]): void {
+  for (const [name, kind] of schema) {
+    const value = fields[name];
+    switch (kind) {
+      case "b":
+        _recEnsure(1);
+        _recView!.setUint8(_recLength++, value ? 1 : 0);
+        break;
+      case "i":
+        _recEnsure(4);
+        _recView!.setInt32(_recLength, Number(value) | 0, true);
+        _recLength += 4;
+        break;
+      case "f":
+        _recEnsure(8);
+        _recView!.setFloat64(_recLength, Number(value), true);
+        _recLength += 8;
+        break;
+      case "s":
+        _recString(String(value ?? ""));
+        break;
+    }
+  }
+}
+
+/** Start recording the game loop's events and dt (jove2d extension). Restarts any recording in progress. */
+export function startRecording(): void {
+  _recBytes = new Uint8Array(64 * 1024);
+  _recView = new DataView(_recBytes.buffer);
+  _recLength = 0;
+  _recFrames = 0;
+  _recView.setUint32(0, RECORD_MAGIC, true);
+  _recView.setUint16(4, RECORD_VERSION, true);
+  _recView.setUint16(6, 0, true);
+  _recView.setUint32(RECORD_FRAME_COUNT_OFFSET, 0, true);
+  _recLength = 12;
+  _recString(getRandomState());
+  const open = joystick.getJoysticks();
+  _recEnsure(2);
+  _recView.setUint16(_recLength, open.length, true);
+  _recLength += 2;
+  for (const joy of open) _recJoystick(joystick._record(joy));
+}
+
+/** Stop recording and return the log, or null if nothing was being recorded. */
+export function stopRecording(): Uint8Array | null {
+  if (!_recBytes) return null;
+  _recView!.setUint32(RECORD_FRAME_COUNT_OFFSET, _recFrames, true);
+  const log = _recBytes.slice(0, _recLength);
+  _recBytes = null;
+  _recView = null;
+  return log;
+}
+
+export function isRecording(): boolean {
+  return _recBytes !== null;
+}
+
+/** Append one frame to the recording. Called by the game loop with the events it dispatches. */
+export function _recordFrame(dt: number, events: JoveEvent[]): void {
+  if (!_recBytes) return;
+  _recEnsure(12);
+  _recView!.setFloat64(_recLength, dt, true);
+  const countOffset = _recLength + 8;
+  _recLength += 12;
+  let count = 0;
+  for (const ev of events) {
+    const code = RECORD_CODES.get(ev.type);
+    if (code === undefined) continue; // custom pushed event — not recordable
+    _recEvent(ev, code);
+    count++;
+  }
+  _recView!.setUint32(countOffset, count, true);
+  _recFrames++;
+}
+
+function _playString(): string {
+  const len = _playView!.getUint16(_playOffset, true);
+  const s = _utf8Decoder.decode(_playBytes!.subarray(_playOffset + 2, _playOffset + 2 + len));
+  _playOffset += 2 + len;
+  return s;
+}
+
+function _playEvent(): JoveEvent {
+  const code = _playView!.getUint8(_playOffset++);
+  const schema = RECORD_SCHEMA[code];
+  if (!schema) throw new Error(`Corrupt input recording: unknown event code ${code}`);
+  const ev = _playFields({ type: schema[0] }, schema[1]);
+  // Registered before the frame is dispatched, so joystickadded finds its stand-in
+  if (code === JOYSTICKADDED_CODE) joystick._addRecorded(_playJoystick());
+  return ev as JoveEvent;
+}
+
+function _playJoystick(): joystick.RecordedJoystick {
+  return _playFields({}, JOYSTICK_SCHEMA) as unknown as joystick.RecordedJoystick;
+}
+
+function _playFields(ev: Record<string, unknown>, schema: [string, FieldKind][]): Record<string, unknown> {
+  for (const [name, kind] of schema) {
+    switch (kind) {
+      case "b":
+        ev[name] = _playView!.getUint8(_playOffset++) !== 0;
+        break;
+      case "i":
+        ev[name] = _playView!.getInt32(_playOffset, true);
+        _playOffset += 4;
+        break;
+      case "f":
+        ev[name] = _playView!.getFloat64(_playOffset, true);
+        _playOffset += 8;
+        break;
+      case "s":
+        ev[name] = _playString();
+        break;
+    }
+  }
+  return ev;
+}
+
+/**
+ * Replay a recording through the game loop (jove2d extension). From the next frame the
+ * loop takes its events and dt from the log instead of SDL and the clock; live input is
+ * ignored except quit/close. The RNG state is restored to what it was when recording began.
+ */
+export function startPlayback(log: Uint8Array, options: PlaybackOptions = {}): void {
+  const view = new DataView(log.buffer, log.byteOffset, log.byteLength);
+  if (log.byteLength < 14 || view.getUint32(0, true) !== RECORD_MAGIC) {
+    throw new Error("Not an input recording");
+  }
+  const version = view.getUint16(4, true);
+  if (version !== RECORD_VERSION) throw new Error(`Unsupported input recording version: ${version}`);
+
+  _playBytes = log;
+  _playView = view;
+  _playTotal = view.getUint32(RECORD_FRAME_COUNT_OFFSET, true);
+  _playOffset = 12;
+  setRandomState(_playString());
+  const open: joystick.RecordedJoystick[] = [];
+  const joysticks = view.getUint16(_playOffset, true);
+  _playOffset += 2;
+  for (let i = 0; i < joysticks; i++) open.push(_playJoystick());
+  _playFrame = 0;
+  _playQuitAtEnd = options.quitAtEnd ?? false;
+  _playFrameTimes = new Float64Array(_playTotal);
+  _playStart = performance.now();
+  _playLastTime = _playStart;
+  _playFinished = false;
+  // Snapshots are rebuilt from the replayed events — start from nothing held
+  keyboard._resetSnapshot();
+  mouse._resetSnapshot();
+  // Joysticks become stand-ins for the recorded devices until playback stops
+  joystick._startReplay(open);
+}
+
+/** Stop playback; the loop goes back to live input. */
+export function stopPlayback(): void {
+  if (_playBytes) joystick._stopReplay();
+  _playBytes = null;
+  _playView = null;
+}
+
+export function isPlayingBack(): boolean {
+  return _playBytes !== null;
+}
+
+/** Frame timing of the current (or last) playback. */
+export function getPlaybackStats(): PlaybackStats {
+  // A frame's time is known once the next one is requested
+  const frames = _playFinished ? _playFrame : Math.max(0, _playFrame - 1);
+  const times = Array.from(_playFrameTimes.subarray(0, frames)).sort((a, b) => a - b);
+  const sum = times.reduce((a, b) => a + b, 0);
+  return {
+    frames: _playFrame,
+    totalFrames: _playTotal,
+    seconds: ((_playFinished ? _playLastTime : performance.now()) - _playStart) / 1000,
+    meanFrameMs: frames > 0 ? sum / frames : 0,
+    p95FrameMs: frames > 0 ? times[Math.min(frames - 1, Math.floor(frames * 0.95))]! : 0,
+    maxFrameMs: frames > 0 ? times[frames - 1]! : 0,
+  };
+}
+
+/**
+ * Next recorded frame, or null when not playing back. Called by the game loop in place of
+ * timer.step()/pollEvents(). When the log runs out playback stops (after a final quit
+ * event if quitAtEnd was set).
+ */
+export function _playbackFrame(): { dt: number; events: JoveEvent[] } | null {
+  if (!_playBytes) return null;
+  const now = performance.now();
+  if (_playFrame > 0) _playFrameTimes[_playFrame - 1] = now - _playLastTime;
+  _playLastTime = now;
+
+  if (_playFrame >= _playTotal || _playOffset + 12 > _playBytes.length) {
+    _playFinished = true;
+    const quitAtEnd = _playQuitAtEnd;
+    stopPlayback();
+    return quitAtEnd ? { dt: 0, events: [{ type: "quit" }] } : null;
+  }
+
+  const dt = _playView!.getFloat64(_playOffset, true);
+  const count = _playView!.getUint32(_playOffset + 8, true);
+  _playOffset += 12;
+  const events: JoveEvent[] = [];
+  for (let i = 0; i < count; i++) events.push(_playEvent());
+  _playFrame++;
+  return { dt, events };
+}
@@ -18,6 +18,19 @@ export interface GlyphInfo {
   w: number;   // glyph width (pixels)
 }
 
+/**
+ * Distance-field glyph source shared by SDF fonts of every size from one file: a TTF_Font
+ * opened once at `rasterSize` in SDF mode, whose glyphs fill one atlas (graphics-text.ts).
+ */
+export interface SDFSource {
+  /** TTF_Font at the raster size, with SDF rendering enabled */
+  readonly font: Pointer;
+  /** Pixel size the distance fields are rasterized at */
+  readonly rasterSize: number;
+  /** Distance-field spread around each glyph (raster pixels) */
+  readonly spread: number;
+}
+
 export interface Font {
   /** Internal TTF_Font pointer (null for bitmap fonts) */
   readonly _font: Pointer;
@@ -37,6 +50,8 @@ export interface Font {
   readonly _glyphHeight?: number;
   /** Bitmap font extra spacing between characters */
   readonly _extraSpacing?: number;
+  /** SDF fonts: the shared distance-field source (drawn scaled by _size / rasterSize) */
+  readonly _sdf?: SDFSource;
 
   /** Get the height of a line of text (in pixels). */
   getHeight(): number;
@@ -65,6 +80,7 @@ export function _createFont(
   fontPtr: Pointer,
   size: number,
   ttf: TTFSymbols,
+  onRelease?: () => void,
 ): Font {
   let _lineHeightMult = 1.0;
   // Cache the native line skip so we can compute lineHeight ratio
@@ -158,11 +174,65 @@ export function _createFont(
     },
 
     release(): void {
+      onRelease?.();
       ttf.TTF_CloseFont(fontPtr);
     },
   };
 }
 
+/**
+ * Create an SDF font of `size` pixels over `base`, the raster-size font of `sdf`. Metrics
+ * are the raster font's scaled to `size`; nothing is re-rasterized.
+ */
+export function _createSDFFont(base: Font, size: number, sdf: SDFSource, onRelease: () => void): Font {
+  const k = size / sdf.rasterSize;
+  let _lineHeightMult = 1.0;
+
+  return {
+    _font: base._font,
+    _size: size,
+    _sdf: sdf,
+
+    getHeight(): number {
+      return base.getHeight() * k;
+    },
+
+    getWidth(text: string): number {
+      return base.getWidth(text) * k;
+    },
+
+    getAscent(): number {
+      return base.getAscent() * k;
+    },
+
+    getDescent(): number {
+      return base.getDescent() * k;
+    },
+
+    getBaseline(): number {
+      return base.getBaseline() * k;
+    },
+
+    getLineHeight(): number {
+      return _lineHeightMult;
+    },
+
+    // Kept per font — the raster font is shared by every size
+    setLineHeight(height: number): void {
+      _lineHeightMult = height;
+    },
+
+    getWrap(text: string, wraplimit: number): [number, string[]] {
+      const [maxWidth, lines] = base.getWrap(text, wraplimit / k);
+      return [maxWidth * k, lines];
+    },
+
+    release(): void {
+      onRelease();
+    },
+  };
+}
+
 export function _createBitmapFont(
   texture: SDLTexture,
   textureWidth: number,
@@ -3,6 +3,7 @@
 
 import { ptr, read } from "bun:ffi";
 import sdl from "../sdl/ffi.ts";
+import * as rc from "./graphics-commands.ts";
 import {
   SDL_TEXTURE_ADDRESS_WRAP,
   SDL_TEXTURE_ADDRESS_CLAMP,
@@ -16,6 +17,10 @@ import {
   _getPointSize,
   _transformPoint,
   _isIdentity,
+  _getTransformMatrix,
+  isCulling,
+  _cullBox,
+  _statCull,
 } from "./graphics.ts";
 import type { Image, Canvas, Quad } from "./graphics.ts";
 
@@ -43,23 +48,60 @@ export interface SpriteBatch {
   setColor(r: number, g: number, b: number, a?: number): void;
   setColor(): void;
   getColor(): [number, number, number, number] | null;
+  /**
+   * Bucket sprites into square chunks of `size` pixels (batch space) by their center, and
+   * draw only the chunks whose bounds are visible (jove2d extension). 0 turns it off.
+   */
+  setChunkSize(size: number): void;
+  getChunkSize(): number;
+}
+
+/** A spatial bucket of a chunked SpriteBatch, with the bounds of its sprites in batch space. */
+interface SpriteChunk {
+  sprites: number[];
+  minX: number;
+  minY: number;
+  maxX: number;
+  maxY: number;
+  /** Bounds need recomputing (a sprite left the chunk). */
+  dirty: boolean;
 }
 
 // Scratch buffer for transforming batch vertices at draw time
 let _spriteBatchScratch = new Float32Array(0);
+// Visible sprites of a chunked batch: their indices, then their vertices in draw order
+let _visibleSprites = new Int32Array(0);
+let _spriteBatchGather = new Float32Array(0);
 
 // ============================================================
 // Mesh type
 // ============================================================
 
 export type MeshDrawMode = "fan" | "strip" | "triangles" | "points";
+/** love2d mesh usage hint. "static" meshes keep their transformed geometry between draws. */
+export type MeshUsage = "dynamic" | "static" | "stream";
+
+/** One attribute of a mesh vertex format, as in love2d's newMesh(vertexformat, ...). */
+export interface VertexAttribute {
+  name: string;
+  type: string;
+  components: number;
+}
+
+/** Mesh vertex: values in vertex-format order (default x, y, u, v, r, g, b, a). */
+export type MeshVertex = number[];
 
 export interface Mesh {
   _isMesh: true;
   _texture: SDLTexture | null;
-  setVertex(index: number, x: number, y: number, u?: number, v?: number, r?: number, g?: number, b?: number, a?: number): void;
-  getVertex(index: number): [number, number, number, number, number, number, number, number];
-  setVertices(vertices: Array<[number, number, number?, number?, number?, number?, number?, number?]>, startIndex?: number): void;
+  /** Set a vertex's values in vertex-format order (default x, y, u?, v?, r?, g?, b?, a?). */
+  setVertex(index: number, ...values: number[]): void;
+  getVertex(index: number): number[];
+  /**
+   * Replace vertices from startIndex (1-based). Accepts love2d tuples, or a Float32Array of
+   * getVertexStride() floats per vertex in vertex-format order — no per-vertex arrays.
+   */
+  setVertices(vertices: MeshVertex[] | Float32Array, startIndex?: number): void;
   setVertexMap(...indices: number[]): void;
   setVertexMapArray(map: number[]): void;
   getVertexMap(): number[] | null;
@@ -72,15 +114,30 @@ export interface Mesh {
   setVertexAttribute(vertexIndex: number, attributeIndex: number, ...values: number[]): void;
   getVertexAttribute(vertexIndex: number, attributeIndex: number): number[];
   getVertexCount(): number;
-  getVertexFormat(): Array<{ name: string; type: string; components: number }>;
+  getVertexFormat(): VertexAttribute[];
+  /** Floats per vertex in setVertices(Float32Array) — the sum of the format's components. */
+  getVertexStride(): number;
+  getUsage(): MeshUsage;
   flush(): void;
   release(): void;
-  /** @internal */
-  _getDrawData(): { vertices: Float32Array; indices: Int32Array; numVerts: number; numIndices: number } | null;
+  /** @internal — version is bumped on every geometry change; -1 = never cache */
+  _getDrawData(): { vertices: Float32Array; indices: Int32Array; numVerts: number; numIndices: number; version: number } | null;
+  /** @internal — transformed-vertex cache for "static" meshes (null otherwise) */
+  _staticCache: MeshTransformCache | null;
+}
+
+/** Last transformed geometry of a static mesh, keyed on the draw + global transform. */
+interface MeshTransformCache {
+  vertices: Float32Array;
+  key: Float64Array;
+  version: number;
 }
 
 // Scratch buffer for transforming mesh vertices at draw time
 let _meshScratch = new Float32Array(0);
+// Static-mesh cache key: x, y, r, sx, sy, ox, oy + the 6 global transform values
+const MESH_CACHE_KEY_SIZE = 13;
+const _meshKey = new Float64Array(MESH_CACHE_KEY_SIZE);
 
 // ============================================================
 // SpriteBatch creation
@@ -102,6 +159,9 @@ export function newSpriteBatch(image: Image, maxSprites: number = 1000): SpriteB
   let _indexData = _buildIndexPattern(_capacity);
   let _count = 0;
   let _batchColor: [number, number, number, number] | null = null;
+  let _chunkSize = 0;
+  const _chunks = new Map<number, SpriteChunk>();
+  let _spriteChunk = new Int32Array(_capacity); // chunk key of each sprite
 
   // Get texture dimensions for UV normalization
   sdl.SDL_GetTextureSize(_image._texture, _texWPtr, _texHPtr);
@@ -182,9 +242,50 @@ export function newSpriteBatch(image: Image, maxSprites: number = 1000): SpriteB
     newVerts.set(_vertexData.subarray(0, _count * FLOATS_PER_SPRITE));
     _vertexData = newVerts;
     _indexData = _buildIndexPattern(newCapacity);
+    const newChunkOf = new Int32Array(newCapacity);
+    newChunkOf.set(_spriteChunk.subarray(0, Math.min(_count, newCapacity)));
+    _spriteChunk = newChunkOf;
     _capacity = newCapacity;
   }
 
+  function _chunkInsert(spriteIndex: number): void {
+    _spriteBounds(_vertexData, spriteIndex);
+    const [minX, minY, maxX, maxY] = _sb;
+    const cx = Math.floor((minX + maxX) / 2 / _chunkSize);
+    const cy = Math.floor((minY + maxY) / 2 / _chunkSize);
+    // Cell coordinates packed into one int32 key (±32k cells per axis), so it survives _spriteChunk
+    const key = ((cy & 0xffff) << 16) | (cx & 0xffff);
+    let chunk = _chunks.get(key);
+    if (!chunk) {
+      chunk = { sprites: [], minX, minY, maxX, maxY, dirty: false };
+      _chunks.set(key, chunk);
+    } else if (!chunk.dirty) {
+      chunk.minX = Math.min(chunk.minX, minX);
+      chunk.minY = Math.min(chunk.minY, minY);
+      chunk.maxX = Math.max(chunk.maxX, maxX);
+      chunk.maxY = Math.max(chunk.maxY, maxY);
+    }
+    chunk.sprites.push(spriteIndex);
+    _spriteChunk[spriteIndex] = key;
+  }
+
+  function _chunkRemove(spriteIndex: number): void {
+    const key = _spriteChunk[spriteIndex]!;
+    const chunk = _chunks.get(key);
+    if (!chunk) return;
+    const at = chunk.sprites.indexOf(spriteIndex);
+    if (at >= 0) chunk.sprites.splice(at, 1);
+    if (chunk.sprites.length === 0) _chunks.delete(key);
+    else chunk.dirty = true;
+  }
+
+  function _rebuildChunks(): void {
+    _chunks.clear();
+    if (_chunkSize > 0) {
+      for (let i = 0; i < _count; i++) _chunkInsert(i);
+    }
+  }
+
   function _parseArgs(args: any[]): { quad: Quad | null; x: number; y: number; r: number; sx: number; sy: number; ox: number; oy: number } {
     let quad: Quad | null = null;
     let offset = 0;
@@ -202,7 +303,10 @@ export function newSpriteBatch(image: Image, maxSprites: number = 1000): SpriteB
     return { quad, x, y, r, sx, sy, ox, oy };
   }
 
-  const batch: SpriteBatch & { _getBuffers(): { vertexData: Float32Array; indexData: Int32Array } } = {
+  const batch: SpriteBatch & {
+    _getBuffers(): { vertexData: Float32Array; indexData: Int32Array };
+    _getChunks(): Map<number, SpriteChunk> | null;
+  } = {
     _isSpriteBatch: true as const,
     get _texture() { return _image._texture; },
 
@@ -210,12 +314,17 @@ export function newSpriteBatch(image: Image, maxSprites: number = 1000): SpriteB
       return { vertexData: _vertexData, indexData: _indexData };
     },
 
+    _getChunks() {
+      return _chunkSize > 0 ? _chunks : null;
+    },
+
     add(...args: any[]): number {
       if (_count >= _capacity) {
         _grow(_capacity * 2);
       }
       const { quad, x, y, r, sx, sy, ox, oy } = _parseArgs(args);
       _buildSpriteVertices(_count, quad, x, y, r, sx, sy, ox, oy);
+      if (_chunkSize > 0) _chunkInsert(_count);
       _count++;
       return _count; // 1-based ID
     },
@@ -225,10 +334,15 @@ export function newSpriteBatch(image: Image, maxSprites: number = 1000): SpriteB
       if (idx < 0 || idx >= _count) return;
       const { quad, x, y, r, sx, sy, ox, oy } = _parseArgs(rest);
       _buildSpriteVertices(idx, quad, x, y, r, sx, sy, ox, oy);
+      if (_chunkSize > 0) {
+        _chunkRemove(idx);
+        _chunkInsert(idx);
+      }
     },
 
     clear(): void {
       _count = 0;
+      _chunks.clear();
     },
 
     flush(): void {
@@ -252,7 +366,9 @@ export function newSpriteBatch(image: Image, maxSprites: number = 1000): SpriteB
         newVerts.set(_vertexData.subarray(0, _count * FLOATS_PER_SPRITE));
         _vertexData = newVerts;
         _indexData = _buildIndexPattern(size);
+        _spriteChunk = _spriteChunk.slice(0, size);
         _capacity = size;
+        _rebuildChunks();
       }
     },
 
@@ -276,11 +392,42 @@ export function newSpriteBatch(image: Image, maxSprites: number = 1000): SpriteB
     getColor(): [number, number, number, number] | null {
       return _batchColor ? [..._batchColor] as [number, number, number, number] : null;
     },
+
+    setChunkSize(size: number): void {
+      const next = size > 0 ? size : 0;
+      if (next === _chunkSize) return;
+      _chunkSize = next;
+      _rebuildChunks();
+    },
+
+    getChunkSize(): number {
+      return _chunkSize;
+    },
   };
 
   return batch;
 }
 
+// Bounds of one sprite [minX, minY, maxX, maxY], written by _spriteBounds
+const _sb = new Float64Array(4);
+
+/** Bounds of sprite `spriteIndex`'s four vertices, into _sb. */
+function _spriteBounds(vertexData: Float32Array, spriteIndex: number): void {
+  const base = spriteIndex * FLOATS_PER_SPRITE;
+  let minX = Infinity, minY = Infinity, maxX = -Infinity, maxY = -Infinity;
+  for (let off = base; off < base + FLOATS_PER_SPRITE; off += 8) {
+    const vx = vertexData[off]!, vy = vertexData[off + 1]!;
+    if (vx < minX) minX = vx;
+    if (vx > maxX) maxX = vx;
+    if (vy < minY) minY = vy;
+    if (vy > maxY) maxY = vy;
+  }
+  _sb[0] = minX;
+  _sb[1] = minY;
+  _sb[2] = maxX;
+  _sb[3] = maxY;
+}
+
 // ============================================================
 // Mesh creation
 // ============================================================
@@ -288,45 +435,153 @@ export function newSpriteBatch(image: Image, maxSprites: number = 1000): SpriteB
 // Floats per vertex: x, y, r, g, b, a, u, v = 8 (matches SDL_Vertex layout)
 const MESH_FLOATS_PER_VERTEX = 8;
 
+// love2d's default vertex format; also the tuple order of newMesh(vertices)
+const DEFAULT_VERTEX_FORMAT: VertexAttribute[] = [
+  { name: "VertexPosition", type: "float", components: 2 },
+  { name: "VertexTexCoord", type: "float", components: 2 },
+  { name: "VertexColor", type: "byte", components: 4 },
+];
+
+// Built-in attributes → offsets in the SDL_Vertex layout. Anything else is a custom
+// attribute, stored per vertex alongside (SDL_Renderer's vertex stage only reads these).
+const BUILTIN_ATTRIBUTES: Record<string, { offsets: number[]; defaults: number[]; min: number }> = {
+  VertexPosition: { offsets: [0, 1], defaults: [0, 0], min: 2 },
+  VertexTexCoord: { offsets: [6, 7], defaults: [0, 0], min: 2 },
+  VertexColor: { offsets: [2, 3, 4, 5], defaults: [1, 1, 1, 1], min: 3 },
+};
+
+/**
+ * Where each format component lives: component k (in format order) is stored in
+ * the SDL_Vertex data (extra[k] = 0) or the custom-attribute data (extra[k] = 1) at
+ * offset[k] within its vertex, with default value def[k].
+ */
+interface MeshLayout {
+  format: VertexAttribute[];
+  extra: Uint8Array;
+  offset: Int32Array;
+  def: Float32Array;
+  /** First component index of each attribute, plus the total at the end */
+  attrStart: number[];
+  /** Custom floats per vertex */
+  extraStride: number;
+}
+
+function _buildMeshLayout(format: VertexAttribute[]): MeshLayout {
+  const extra: number[] = [];
+  const offset: number[] = [];
+  const def: number[] = [];
+  const attrStart: number[] = [];
+  const seen = new Set<string>();
+  let extraStride = 0;
+  for (const attr of format) {
+    const n = Math.floor(attr.components);
+    if (seen.has(attr.name)) throw new Error(`Duplicate vertex attribute: ${attr.name}`);
+    if (!(n >= 1 && n <= 4)) throw new Error(`Invalid component count for vertex attribute ${attr.name}: ${attr.components}`);
+    seen.add(attr.name);
+    attrStart.push(offset.length);
+    const builtin = BUILTIN_ATTRIBUTES[attr.name];
+    if (builtin) {
+      if (n < builtin.min || n > builtin.offsets.length) {
+        throw new Error(`Vertex attribute ${attr.name} needs ${builtin.min}-${builtin.offsets.length} components`);
+      }
+      for (let k = 0; k < n; k++) {
+        extra.push(0);
+        offset.push(builtin.offsets[k]!);
+        def.push(builtin.defaults[k]!);
+      }
+    } else {
+      for (let k = 0; k < n; k++) {
+        extra.push(1);
+        offset.push(extraStride++);
+        def.push(0);
+      }
+    }
+  }
+  if (!seen.has("VertexPosition")) throw new Error("Mesh vertex format must include VertexPosition");
+  attrStart.push(offset.length);
+  return {
+    format: format.map((a) => ({ ...a })),
+    extra: Uint8Array.from(extra),
+    offset: Int32Array.from(offset),
+    def: Float32Array.from(def),
+    attrStart,
+    extraStride,
+  };
+}
+
 /**
  * Create a new Mesh for custom vertex geometry.
- * Overload 1: newMesh(vertexcount, mode?) — empty mesh with N vertices
- * Overload 2: newMesh(vertices, mode?) — mesh from vertex array
+ * Overload 1: newMesh(vertexcount, mode?, usage?) — empty mesh with N vertices
+ * Overload 2: newMesh(vertices, mode?, usage?) — mesh from vertex array
+ * Overload 3: newMesh(vertexformat, vertices | vertexcount, mode?, usage?) — custom format
  */
 export function newMesh(
-  verticesOrCount: number | Array<[number, number, number?, number?, number?, number?, number?, number?]>,
-  mode: MeshDrawMode = "fan",
+  verticesOrCount: number | MeshVertex[],
+  mode?: MeshDrawMode,
+  usage?: MeshUsage,
+): Mesh | null;
+export function newMesh(
+  format: VertexAttribute[],
+  verticesOrCount: number | MeshVertex[],
+  mode?: MeshDrawMode,
+  usage?: MeshUsage,
+): Mesh | null;
+export function newMesh(
+  formatOrVertices: VertexAttribute[] | number | MeshVertex[],
+  a?: number | MeshVertex[] | MeshDrawMode,
+  b?: MeshDrawMode | MeshUsage,
+  c?: MeshUsage,
 ): Mesh | null {
   if (!_getRenderer()) return null;
 
-  let _vertexCount: number;
-  let _vertexData: Float32Array;
+  // A vertex format is an array of attribute tables ({ name, ... }); vertices are arrays
+  const hasFormat = Array.isArray(formatOrVertices) && formatOrVertices.length > 0
+    && !Array.isArray(formatOrVertices[0]);
+  const layout = _buildMeshLayout(hasFormat ? formatOrVertices as VertexAttribute[] : DEFAULT_VERTEX_FORMAT);
+  const verticesOrCount = (hasFormat ? a : formatOrVertices) as number | MeshVertex[];
+  const mode = ((hasFormat ? b : a) ?? "fan") as MeshDrawMode;
+  const _usage = ((hasFormat ? c : b) ?? "dynamic") as MeshUsage;
+
+  const stride = layout.offset.length;
+  const _vertexCount = typeof verticesOrCount === "number" ? Math.max(0, Math.floor(verticesOrCount)) : verticesOrCount.length;
+  const _vertexData = new Float32Array(_vertexCount * MESH_FLOATS_PER_VERTEX);
+  const _extraData = new Float32Array(_vertexCount * layout.extraStride);
+  // Bumped on every vertex write so static meshes know when their cache is stale
+  let _version = 0;
+
+  // Default: position 0,0; UV 0,0; color white (1,1,1,1)
+  for (let i = 0; i < _vertexCount; i++) {
+    const base = i * MESH_FLOATS_PER_VERTEX;
+    _vertexData[base + 2] = 1; // r
+    _vertexData[base + 3] = 1; // g
+    _vertexData[base + 4] = 1; // b
+    _vertexData[base + 5] = 1; // a
+  }
 
-  if (typeof verticesOrCount === "number") {
-    _vertexCount = verticesOrCount;
-    _vertexData = new Float32Array(_vertexCount * MESH_FLOATS_PER_VERTEX);
-    // Default: position 0,0; UV 0,0; color white (1,1,1,1)
-    for (let i = 0; i < _vertexCount; i++) {
-      const base = i * MESH_FLOATS_PER_VERTEX;
-      _vertexData[base + 2] = 1; // r
-      _vertexData[base + 3] = 1; // g
-      _vertexData[base + 4] = 1; // b
-      _vertexData[base + 5] = 1; // a
+  /**
+   * Write `count` values of vertex vi (0-based) from src[srcOffset...] in format order.
+   * Components past `count` (or undefined) get their defaults, as in love2d.
+   */
+  function _writeVertex(vi: number, src: ArrayLike<number | undefined>, srcOffset: number, count: number): void {
+    const vbase = vi * MESH_FLOATS_PER_VERTEX;
+    const ebase = vi * layout.extraStride;
+    for (let k = 0; k < stride; k++) {
+      const value = (k < count ? src[srcOffset + k] : undefined) ?? layout.def[k]!;
+      if (layout.extra[k]) _extraData[ebase + layout.offset[k]!] = value;
+      else _vertexData[vbase + layout.offset[k]!] = value;
     }
-  } else {
-    _vertexCount = verticesOrCount.length;
-    _vertexData = new Float32Array(_vertexCount * MESH_FLOATS_PER_VERTEX);
+  }
+
+  function _readComponent(vi: number, k: number): number {
+    return layout.extra[k]
+      ? _extraData[vi * layout.extraStride + layout.offset[k]!]!
+      : _vertexData[vi * MESH_FLOATS_PER_VERTEX + layout.offset[k]!]!;
+  }
+
+  if (typeof verticesOrCount !== "number") {
     for (let i = 0; i < _vertexCount; i++) {
-      const v = verticesOrCount[i];
-      const base = i * MESH_FLOATS_PER_VERTEX;
-      _vertexData[base + 0] = v![0]; // x
-      _vertexData[base + 1] = v![1]; // y
-      _vertexData[base + 2] = v![4] ?? 1; // r (love2d: index 4 = r)
-      _vertexData[base + 3] = v![5] ?? 1; // g
-      _vertexData[base + 4] = v![6] ?? 1; // b
-      _vertexData[base + 5] = v![7] ?? 1; // a
-      _vertexData[base + 6] = v![2] ?? 0; // u (love2d: index 2 = u)
-      _vertexData[base + 7] = v![3] ?? 0; // v (love2d: index 3 = v)
+      const v = verticesOrCount[i]!;
+      _writeVertex(i, v, 0, v.length);
     }
   }
 
@@ -336,23 +591,43 @@ export function newMesh(
   let _drawRangeStart: number | null = null;
   let _drawRangeCount: number | null = null;
 
-  // Build indices for current draw mode + vertex map + draw range
-  function _buildIndices(): Int32Array | null {
-    // Determine the vertex sequence
-    let sequence: number[];
+  // Index buffer for the current draw mode + vertex map + draw range. Rebuilt only when one
+  // of those changes (setVertexMap/setDrawMode/setDrawRange), not per draw.
+  let _indicesDirty = true;
+  let _indices: Int32Array | null = null;
+  // Vertex sequence (0-based) behind _indices — points mode expands it each draw
+  let _sequence = new Int32Array(0);
+  // Points mode: expanded quad vertices, grown as needed and reused across draws
+  let _pointVerts = new Float32Array(0);
+  // Reused result object for _getDrawData()
+  const _drawData = { vertices: _vertexData, indices: new Int32Array(0), numVerts: 0, numIndices: 0, version: 0 };
+
+  function _invalidateIndices(): void {
+    _indicesDirty = true;
+    _version++;
+  }
+
+  /** Vertex sequence after the vertex map and draw range, 0-based. */
+  function _buildSequence(): Int32Array {
+    let sequence: Int32Array;
     if (_vertexMap) {
-      sequence = _vertexMap.map(i => i - 1); // love2d 1-based → 0-based
+      sequence = Int32Array.from(_vertexMap, i => i - 1); // love2d 1-based → 0-based
     } else {
-      sequence = [];
-      for (let i = 0; i < _vertexCount; i++) sequence.push(i);
+      sequence = new Int32Array(_vertexCount);
+      for (let i = 0; i < _vertexCount; i++) sequence[i] = i;
     }
 
     // Apply draw range
     if (_drawRangeStart !== null && _drawRangeCount !== null) {
-      const start = _drawRangeStart - 1; // love2d 1-based
-      sequence = sequence.slice(start, start + _drawRangeCount);
+      const start = Math.max(0, _drawRangeStart - 1); // love2d 1-based
+      sequence = sequence.subarray(start, start + _drawRangeCount);
     }
+    return sequence;
+  }
 
+  // Build indices for current draw mode + vertex map + draw range
+  function _buildIndices(): Int32Array | null {
+    const sequence = _sequence;
     const n = sequence.length;
     if (n < 1) return null;
 
@@ -393,9 +668,9 @@ export function newMesh(
         return indices;
       }
       case "points": {
-        // Points mode: render each vertex as a small quad (2 triangles)
-        // Returns null here — handled specially in _drawMesh
-        return null;
+        // Points mode: each vertex becomes a small quad (2 triangles) — same index
+        // pattern as sprites; the quad corners are expanded per draw in _getDrawData
+        return _buildIndexPattern(n);
       }
       default:
         return null;
@@ -406,52 +681,37 @@ export function newMesh(
     _isMesh: true as const,
     get _texture() { return _textureImage?._texture ?? null; },
 
-    setVertex(index: number, x: number, y: number, u?: number, v?: number, r?: number, g?: number, b?: number, a?: number) {
+    setVertex(index: number, ...values: number[]) {
       const i = index - 1; // love2d 1-based
       if (i < 0 || i >= _vertexCount) return;
-      const base = i * MESH_FLOATS_PER_VERTEX;
-      _vertexData[base + 0] = x;
-      _vertexData[base + 1] = y;
-      _vertexData[base + 2] = r ?? 1;
-      _vertexData[base + 3] = g ?? 1;
-      _vertexData[base + 4] = b ?? 1;
-      _vertexData[base + 5] = a ?? 1;
-      _vertexData[base + 6] = u ?? 0;
-      _vertexData[base + 7] = v ?? 0;
-    },
-
-    getVertex(index: number): [number, number, number, number, number, number, number, number] {
+      _writeVertex(i, values, 0, values.length);
+      _version++;
+    },
+
+    getVertex(index: number): number[] {
       const i = index - 1;
-      if (i < 0 || i >= _vertexCount) return [0, 0, 0, 0, 1, 1, 1, 1];
-      const base = i * MESH_FLOATS_PER_VERTEX;
-      return [
-        _vertexData[base + 0]!, // x
-        _vertexData[base + 1]!, // y
-        _vertexData[base + 6]!, // u (returned in love2d order)
-        _vertexData[base + 7]!, // v
-        _vertexData[base + 2]!, // r
-        _vertexData[base + 3]!, // g
-        _vertexData[base + 4]!, // b
-        _vertexData[base + 5]!, // a
-      ];
+      if (i < 0 || i >= _vertexCount) return Array.from(layout.def);
+      // Returned in vertex-format order (love2d)
+      const out = new Array<number>(stride);
+      for (let k = 0; k < stride; k++) out[k] = _readComponent(i, k);
+      return out;
     },
 
     setVertices(vertices, startIndex = 1) {
       const start = startIndex - 1;
-      for (let i = 0; i < vertices.length; i++) {
-        const vi = start + i;
-        if (vi >= _vertexCount) break;
-        const v = vertices[i]!;
-        const base = vi * MESH_FLOATS_PER_VERTEX;
-        _vertexData[base + 0] = v[0]; // x
-        _vertexData[base + 1] = v[1]; // y
-        _vertexData[base + 2] = v[4] ?? 1; // r
-        _vertexData[base + 3] = v[5] ?? 1; // g
-        _vertexData[base + 4] = v[6] ?? 1; // b
-        _vertexData[base + 5] = v[7] ?? 1; // a
-        _vertexData[base + 6] = v[2] ?? 0; // u
-        _vertexData[base + 7] = v[3] ?? 0; // v
+      if (start < 0) return;
+      if (vertices instanceof Float32Array) {
+        // Bulk path: `stride` floats per vertex in vertex-format order
+        const count = Math.min(Math.floor(vertices.length / stride), _vertexCount - start);
+        for (let i = 0; i < count; i++) _writeVertex(start + i, vertices, i * stride, stride);
+      } else {
+        const count = Math.min(vertices.length, _vertexCount - start);
+        for (let i = 0; i < count; i++) {
+          const v = vertices[i]!;
+          _writeVertex(start + i, v, 0, v.length);
+        }
       }
+      _version++;
     },
 
     setVertexMap(...indices: number[]) {
@@ -461,10 +721,12 @@ export function newMesh(
       } else {
         _vertexMap = indices.slice();
       }
+      _invalidateIndices();
     },
 
     setVertexMapArray(map: number[]) {
       _vertexMap = map.slice();
+      _invalidateIndices();
     },
 
     getVertexMap(): number[] | null {
@@ -480,6 +742,7 @@ export function newMesh(
     },
 
     setDrawMode(mode: MeshDrawMode) {
+      if (mode !== _drawMode) _invalidateIndices();
       _drawMode = mode;
     },
 
@@ -495,6 +758,7 @@ export function newMesh(
         _drawRangeStart = start;
         _drawRangeCount = count ?? _vertexCount;
       }
+      _invalidateIndices();
     },
 
     getDrawRange(): [number, number] | null {
@@ -504,120 +768,111 @@ export function newMesh(
 
     setVertexAttribute(vertexIndex: number, attributeIndex: number, ...values: number[]) {
       const vi = vertexIndex - 1;
-      if (vi < 0 || vi >= _vertexCount) return;
-      const base = vi * MESH_FLOATS_PER_VERTEX;
-      // Attribute 1: position (x,y) at offsets 0,1
-      // Attribute 2: texcoord (u,v) at offsets 6,7
-      // Attribute 3: color (r,g,b,a) at offsets 2,3,4,5
-      const attrOffsets: number[][] = [
-        [0, 1],       // VertexPosition
-        [6, 7],       // VertexTexCoord
-        [2, 3, 4, 5], // VertexColor
-      ];
-      const ai = attributeIndex - 1;
-      if (ai < 0 || ai >= attrOffsets.length) return;
-      const offsets = attrOffsets[ai];
-      for (let i = 0; i < Math.min(values.length, offsets!.length); i++) {
-        _vertexData[base + offsets![i]!] = values[i]!;
+      const ai = attributeIndex - 1; // love2d 1-based, in vertex-format order
+      if (vi < 0 || vi >= _vertexCount || ai < 0 || ai >= layout.format.length) return;
+      const first = layout.attrStart[ai]!;
+      const n = Math.min(values.length, layout.attrStart[ai + 1]! - first);
+      const vbase = vi * MESH_FLOATS_PER_VERTEX;
+      const ebase = vi * layout.extraStride;
+      for (let i = 0; i < n; i++) {
+        const k = first + i;
+        if (layout.extra[k]) _extraData[ebase + layout.offset[k]!] = values[i]!;
+        else _vertexData[vbase + layout.offset[k]!] = values[i]!;
       }
+      _version++;
     },
 
     getVertexAttribute(vertexIndex: number, attributeIndex: number): number[] {
       const vi = vertexIndex - 1;
-      if (vi < 0 || vi >= _vertexCount) return [];
-      const base = vi * MESH_FLOATS_PER_VERTEX;
-      const attrOffsets: number[][] = [
-        [0, 1],       // VertexPosition
-        [6, 7],       // VertexTexCoord
-        [2, 3, 4, 5], // VertexColor
-      ];
       const ai = attributeIndex - 1;
-      if (ai < 0 || ai >= attrOffsets.length) return [];
-      return attrOffsets[ai]!.map(off => _vertexData[base + off]!) as number[];
+      if (vi < 0 || vi >= _vertexCount || ai < 0 || ai >= layout.format.length) return [];
+      const out: number[] = [];
+      for (let k = layout.attrStart[ai]!; k < layout.attrStart[ai + 1]!; k++) out.push(_readComponent(vi, k));
+      return out;
     },
 
     getVertexCount(): number {
       return _vertexCount;
     },
 
-    getVertexFormat() {
-      return [
-        { name: "VertexPosition", type: "float", components: 2 },
-        { name: "VertexTexCoord", type: "float", components: 2 },
-        { name: "VertexColor", type: "byte", components: 4 },
-      ];
+    getVertexFormat(): VertexAttribute[] {
+      return layout.format.map((attr) => ({ ...attr }));
+    },
+
+    getVertexStride(): number {
+      return stride;
     },
 
+    getUsage(): MeshUsage {
+      return _usage;
+    },
+
+    _staticCache: _usage === "static"
+      ? { vertices: new Float32Array(0), key: new Float64Array(MESH_CACHE_KEY_SIZE), version: -1 }
+      : null,
+
     flush() {
-      // No-op — we render directly from JS-side Float32Array each frame
+      // No-op — we render directly from JS-side Float32Array each frame (indices are cached)
     },
 
     release() {
       // Mesh doesn't own the texture, just clear references
       _textureImage = null;
       _vertexMap = null;
+      _indices = null;
+      _sequence = new Int32Array(0);
+      _pointVerts = new Float32Array(0);
+      _invalidateIndices();
     },
 
     _getDrawData() {
       if (_vertexCount === 0) return null;
+      if (_indicesDirty) {
+        _sequence = _buildSequence();
+        _indices = _buildIndices();
+        _indicesDirty = false;
+      }
+      if (!_indices) return null;
       if (_drawMode === "points") {
-        // Build small quads for each point
-        let sequence: number[];
-        if (_vertexMap) {
-          sequence = _vertexMap.map(i => i - 1);
-        } else {
-          sequence = [];
-          for (let i = 0; i < _vertexCount; i++) sequence.push(i);
-        }
-        if (_drawRangeStart !== null && _drawRangeCount !== null) {
-          const start = _drawRangeStart - 1;
-          sequence = sequence.slice(start, start + _drawRangeCount);
-        }
-        const n = sequence.length;
-        if (n === 0) return null;
-        const ps = _getPointSize();
-        const hp = ps / 2;
+        // Expand each point into a quad of half-size hp around it (point size can change
+        // per draw, so the corners are rewritten every time — into a reused buffer)
+        const n = _sequence.length;
+        const hp = _getPointSize() / 2;
         const numVerts = n * 4;
-        const numIndices = n * 6;
-        const verts = new Float32Array(numVerts * MESH_FLOATS_PER_VERTEX);
-        const idxs = new Int32Array(numIndices);
+        if (_pointVerts.length < numVerts * MESH_FLOATS_PER_VERTEX) {
+          _pointVerts = new Float32Array(numVerts * MESH_FLOATS_PER_VERTEX);
+        }
+        const verts = _pointVerts;
         for (let i = 0; i < n; i++) {
-          const si = sequence[i]!;
-          const srcBase = si * MESH_FLOATS_PER_VERTEX;
+          const srcBase = _sequence[i]! * MESH_FLOATS_PER_VERTEX;
           const cx = _vertexData[srcBase + 0]!;
           const cy = _vertexData[srcBase + 1]!;
-          const cr = _vertexData[srcBase + 2]!;
-          const cg = _vertexData[srcBase + 3]!;
-          const cb = _vertexData[srcBase + 4]!;
-          const ca = _vertexData[srcBase + 5]!;
-          const cu = _vertexData[srcBase + 6]!;
-          const cv = _vertexData[srcBase + 7]!;
-          // 4 corners of point quad
-          const corners: [number, number][] = [
-            [cx - hp, cy - hp], [cx + hp, cy - hp],
-            [cx + hp, cy + hp], [cx - hp, cy + hp],
-          ];
           for (let j = 0; j < 4; j++) {
             const dstBase = (i * 4 + j) * MESH_FLOATS_PER_VERTEX;
-            verts[dstBase + 0] = corners[j]![0];
-            verts[dstBase + 1] = corners[j]![1];
-            verts[dstBase + 2] = cr;
-            verts[dstBase + 3] = cg;
-            verts[dstBase + 4] = cb;
-            verts[dstBase + 5] = ca;
-            verts[dstBase + 6] = cu;
-            verts[dstBase + 7] = cv;
+            // Corners clockwise from top-left: (-,-) (+,-) (+,+) (-,+)
+            verts[dstBase + 0] = j === 0 || j === 3 ? cx - hp : cx + hp;
+            verts[dstBase + 1] = j < 2 ? cy - hp : cy + hp;
+            // Color + UV copied from the point
+            verts[dstBase + 2] = _vertexData[srcBase + 2]!;
+            verts[dstBase + 3] = _vertexData[srcBase + 3]!;
+            verts[dstBase + 4] = _vertexData[srcBase + 4]!;
+            verts[dstBase + 5] = _vertexData[srcBase + 5]!;
+            verts[dstBase + 6] = _vertexData[srcBase + 6]!;
+            verts[dstBase + 7] = _vertexData[srcBase + 7]!;
           }
-          const bi = i * 4;
-          const ii = i * 6;
-          idxs[ii + 0] = bi; idxs[ii + 1] = bi + 1; idxs[ii + 2] = bi + 2;
-          idxs[ii + 3] = bi; idxs[ii + 4] = bi + 2; idxs[ii + 5] = bi + 3;
         }
-        return { vertices: verts, indices: idxs, numVerts, numIndices };
+        _drawData.vertices = verts;
+        _drawData.numVerts = numVerts;
+        // Depends on the point size too — never served from the static cache
+        _drawData.version = -1;
+      } else {
+        _drawData.vertices = _vertexData;
+        _drawData.numVerts = _vertexCount;
+        _drawData.version = _version;
       }
-      const indices = _buildIndices();
-      if (!indices) return null;
-      return { vertices: _vertexData, indices, numVerts: _vertexCount, numIndices: indices.length };
+      _drawData.indices = _indices;
+      _drawData.numIndices = _indices.length;
+      return _drawData;
     },
   };
 
@@ -659,9 +914,21 @@ export function _drawSpriteBatch(
   if (!renderer) return;
 
   // Access closure state via the batch interface
-  const count = batch.getCount();
+  let count = batch.getCount();
   if (count === 0) return;
 
+  const buffers = (batch as any)._getBuffers();
+  let vertexData: Float32Array = buffers.vertexData;
+  const indexData: Int32Array = buffers.indexData;
+
+  // Chunked batch: gather only the sprites of visible chunks
+  const chunks: Map<number, SpriteChunk> | null = (batch as any)._getChunks();
+  if (chunks) {
+    count = _gatherVisibleSprites(chunks, vertexData, x, y, r, sx, sy, ox, oy);
+    if (count === 0) return;
+    vertexData = _spriteBatchGather;
+  }
+
   const numVerts = count * 4;
   const numIndices = count * INDICES_PER_SPRITE;
   const numFloats = count * FLOATS_PER_SPRITE;
@@ -675,19 +942,15 @@ export function _drawSpriteBatch(
   const hasBatchTransform = x !== 0 || y !== 0 || r !== 0 || sx !== 1 || sy !== 1 || ox !== 0 || oy !== 0;
   const hasGlobalTransform = !_isIdentity();
 
-  const buffers = (batch as any)._getBuffers();
-  const vertexData: Float32Array = buffers.vertexData;
-  const indexData: Int32Array = buffers.indexData;
-
   if (!hasBatchTransform && !hasGlobalTransform) {
     // Fast path: no transforms needed, render directly
     const [cr, cg, cb, ca] = _getDrawColor();
-    sdl.SDL_SetTextureColorModFloat(batch._texture, cr / 255, cg / 255, cb / 255);
-    sdl.SDL_SetTextureAlphaModFloat(batch._texture, ca / 255);
-    sdl.SDL_RenderGeometry(
+    rc.setTextureColorModFloat(batch._texture, cr / 255, cg / 255, cb / 255);
+    rc.setTextureAlphaModFloat(batch._texture, ca / 255);
+    rc.renderGeometry(
       renderer, batch._texture,
-      ptr(vertexData), numVerts,
-      ptr(indexData), numIndices,
+      vertexData, numVerts,
+      indexData, numIndices,
     );
     return;
   }
@@ -732,17 +995,72 @@ export function _drawSpriteBatch(
 
   // Apply draw color modulation
   const [cr, cg, cb, ca] = _getDrawColor();
-  sdl.SDL_SetTextureColorModFloat(batch._texture, cr / 255, cg / 255, cb / 255);
-  sdl.SDL_SetTextureAlphaModFloat(batch._texture, ca / 255);
+  rc.setTextureColorModFloat(batch._texture, cr / 255, cg / 255, cb / 255);
+  rc.setTextureAlphaModFloat(batch._texture, ca / 255);
 
-  // Call ptr() fresh for each render (bun:ffi caveat — JS wrote to scratch)
-  sdl.SDL_RenderGeometry(
+  rc.renderGeometry(
     renderer, batch._texture,
-    ptr(_spriteBatchScratch), numVerts,
-    ptr(indexData), numIndices,
+    _spriteBatchScratch, numVerts,
+    indexData, numIndices,
   );
 }
 
+/**
+ * Copy the sprites of the chunks that pass the cull test into _spriteBatchGather, in their
+ * original order. Returns the number of sprites gathered.
+ */
+function _gatherVisibleSprites(
+  chunks: Map<number, SpriteChunk>,
+  vertexData: Float32Array,
+  x: number, y: number, r: number,
+  sx: number, sy: number,
+  ox: number, oy: number,
+): number {
+  let n = 0;
+  let culled = 0;
+  for (const chunk of chunks.values()) {
+    if (chunk.dirty) {
+      chunk.minX = chunk.minY = Infinity;
+      chunk.maxX = chunk.maxY = -Infinity;
+      for (const i of chunk.sprites) {
+        _spriteBounds(vertexData, i);
+        chunk.minX = Math.min(chunk.minX, _sb[0]!);
+        chunk.minY = Math.min(chunk.minY, _sb[1]!);
+        chunk.maxX = Math.max(chunk.maxX, _sb[2]!);
+        chunk.maxY = Math.max(chunk.maxY, _sb[3]!);
+      }
+      chunk.dirty = false;
+    }
+    const sprites = chunk.sprites;
+    if (_cullBox(chunk.minX, chunk.minY, chunk.maxX, chunk.maxY, x, y, r, sx, sy, ox, oy)) {
+      culled += sprites.length;
+      continue;
+    }
+    if (_visibleSprites.length < n + sprites.length) {
+      const grown = new Int32Array(Math.max(n + sprites.length, _visibleSprites.length * 2));
+      grown.set(_visibleSprites.subarray(0, n));
+      _visibleSprites = grown;
+    }
+    for (let i = 0; i < sprites.length; i++) _visibleSprites[n + i] = sprites[i]!;
+    n += sprites.length;
+  }
+  _statCull(culled);
+  if (n === 0) return 0;
+
+  // Chunks interleave sprite indices (and set() reorders within one) — restore draw order
+  const visible = _visibleSprites.subarray(0, n);
+  if (n > 1) visible.sort();
+
+  if (_spriteBatchGather.length < n * FLOATS_PER_SPRITE) {
+    _spriteBatchGather = new Float32Array(n * FLOATS_PER_SPRITE);
+  }
+  for (let i = 0; i < n; i++) {
+    const src = visible[i]! * FLOATS_PER_SPRITE;
+    _spriteBatchGather.set(vertexData.subarray(src, src + FLOATS_PER_SPRITE), i * FLOATS_PER_SPRITE);
+  }
+  return n;
+}
+
 // ============================================================
 // ParticleSystem drawing
 // ============================================================
@@ -766,18 +1084,34 @@ export function _drawParticleSystem(
   const { vertices, indices, numVerts, numIndices } = data;
   const numFloats = numVerts * 8;
 
+  if (isCulling() && numVerts > 0) {
+    // Bounds of the emitted particles, in the system's local space
+    let minX = Infinity, minY = Infinity, maxX = -Infinity, maxY = -Infinity;
+    for (let off = 0; off < numFloats; off += 8) {
+      const vx = vertices[off]!, vy = vertices[off + 1]!;
+      if (vx < minX) minX = vx;
+      if (vx > maxX) maxX = vx;
+      if (vy < minY) minY = vy;
+      if (vy > maxY) maxY = vy;
+    }
+    if (_cullBox(minX, minY, maxX, maxY, x, y, r, sx, sy, ox, oy)) {
+      _statCull(numVerts / 4);
+      return;
+    }
+  }
+
   const hasDrawTransform = x !== 0 || y !== 0 || r !== 0 || sx !== 1 || sy !== 1 || ox !== 0 || oy !== 0;
   const hasGlobalTransform = !_isIdentity();
 
   if (!hasDrawTransform && !hasGlobalTransform) {
     // Fast path: no transforms, render directly
     const [cr, cg, cb, ca] = _getDrawColor();
-    sdl.SDL_SetTextureColorModFloat(ps._texture, cr / 255, cg / 255, cb / 255);
-    sdl.SDL_SetTextureAlphaModFloat(ps._texture, ca / 255);
-    sdl.SDL_RenderGeometry(
+    rc.setTextureColorModFloat(ps._texture, cr / 255, cg / 255, cb / 255);
+    rc.setTextureAlphaModFloat(ps._texture, ca / 255);
+    rc.renderGeometry(
       renderer, ps._texture,
-      ptr(vertices), numVerts,
-      ptr(indices), numIndices,
+      vertices, numVerts,
+      indices, numIndices,
     );
     return;
   }
@@ -824,14 +1158,13 @@ export function _drawParticleSystem(
   }
 
   const [cr, cg, cb, ca] = _getDrawColor();
-  sdl.SDL_SetTextureColorModFloat(ps._texture, cr / 255, cg / 255, cb / 255);
-  sdl.SDL_SetTextureAlphaModFloat(ps._texture, ca / 255);
+  rc.setTextureColorModFloat(ps._texture, cr / 255, cg / 255, cb / 255);
+  rc.setTextureAlphaModFloat(ps._texture, ca / 255);
 
-  // Call ptr() fresh for each render (bun:ffi caveat — JS wrote to scratch)
-  sdl.SDL_RenderGeometry(
+  rc.renderGeometry(
     renderer, ps._texture,
-    ptr(_particleScratch), numVerts,
-    ptr(indices), numIndices,
+    _particleScratch, numVerts,
+    indices, numIndices,
   );
 }
 
@@ -851,7 +1184,7 @@ export function _drawMesh(
   const data = mesh._getDrawData();
   if (!data) return;
 
-  const { vertices, indices, numVerts, numIndices } = data;
+  const { vertices, indices, numVerts, numIndices, version } = data;
   const numFloats = numVerts * MESH_FLOATS_PER_VERTEX;
 
   const hasDrawTransform = x !== 0 || y !== 0 || r !== 0 || sx !== 1 || sy !== 1 || ox !== 0 || oy !== 0;
@@ -864,28 +1197,54 @@ export function _drawMesh(
   if (texImg && "_wrapH" in texImg) {
     const u = texImg._wrapH === "repeat" ? SDL_TEXTURE_ADDRESS_WRAP : SDL_TEXTURE_ADDRESS_CLAMP;
     const v = texImg._wrapV === "repeat" ? SDL_TEXTURE_ADDRESS_WRAP : SDL_TEXTURE_ADDRESS_CLAMP;
-    sdl.SDL_SetRenderTextureAddressMode(renderer, u, v);
+    rc.setRenderTextureAddressMode(renderer, u, v);
   }
 
   if (!hasDrawTransform && !hasGlobalTransform) {
     // Fast path: no transforms, render directly
     if (texture) {
       const [cr, cg, cb, ca] = _getDrawColor();
-      sdl.SDL_SetTextureColorModFloat(texture, cr / 255, cg / 255, cb / 255);
-      sdl.SDL_SetTextureAlphaModFloat(texture, ca / 255);
-      sdl.SDL_SetTextureBlendMode(texture, _getEffectiveBlendModeSDL());
+      rc.setTextureColorModFloat(texture, cr / 255, cg / 255, cb / 255);
+      rc.setTextureAlphaModFloat(texture, ca / 255);
+      rc.setTextureBlendMode(texture, _getEffectiveBlendModeSDL());
     }
-    sdl.SDL_RenderGeometry(
+    rc.renderGeometry(
       renderer, texture,
-      ptr(vertices), numVerts,
-      ptr(indices), numIndices,
+      vertices, numVerts,
+      indices, numIndices,
     );
     return;
   }
 
-  // Slow path: transform vertices
-  if (_meshScratch.length < numFloats) {
+  if (texture) {
+    const [cr, cg, cb, ca] = _getDrawColor();
+    rc.setTextureColorModFloat(texture, cr / 255, cg / 255, cb / 255);
+    rc.setTextureAlphaModFloat(texture, ca / 255);
+    rc.setTextureBlendMode(texture, _getEffectiveBlendModeSDL());
+  }
+
+  // Static meshes: reuse last draw's transformed vertices if geometry and transform match
+  const cache = version >= 0 ? mesh._staticCache : null;
+  let out = _meshScratch;
+  if (cache) {
+    const m = _getTransformMatrix();
+    _meshKey[0] = x; _meshKey[1] = y; _meshKey[2] = r;
+    _meshKey[3] = sx; _meshKey[4] = sy; _meshKey[5] = ox; _meshKey[6] = oy;
+    for (let i = 0; i < 6; i++) _meshKey[7 + i] = m[i]!;
+    let hit = cache.version === version;
+    for (let i = 0; hit && i < MESH_CACHE_KEY_SIZE; i++) hit = cache.key[i] === _meshKey[i];
+    if (hit) {
+      rc.renderGeometry(renderer, texture, cache.vertices, numVerts, indices, numIndices);
+      return;
+    }
+    if (cache.vertices.length < numFloats) cache.vertices = new Float32Array(numFloats);
+    cache.key.set(_meshKey);
+    cache.version = version;
+    out = cache.vertices;
+  } else if (_meshScratch.length < numFloats) {
+    // Slow path: transform vertices
     _meshScratch = new Float32Array(numFloats);
+    out = _meshScratch;
   }
 
   const dcos = Math.cos(r);
@@ -913,27 +1272,20 @@ export function _drawMesh(
       vy = ty;
     }
 
-    _meshScratch[dstOff + 0] = vx;
-    _meshScratch[dstOff + 1] = vy;
+    out[dstOff + 0] = vx;
+    out[dstOff + 1] = vy;
     // Copy color + UV unchanged
-    _meshScratch[dstOff + 2] = vertices[srcOff + 2]!;
-    _meshScratch[dstOff + 3] = vertices[srcOff + 3]!;
-    _meshScratch[dstOff + 4] = vertices[srcOff + 4]!;
-    _meshScratch[dstOff + 5] = vertices[srcOff + 5]!;
-    _meshScratch[dstOff + 6] = vertices[srcOff + 6]!;
-    _meshScratch[dstOff + 7] = vertices[srcOff + 7]!;
-  }
-
-  if (texture) {
-    const [cr, cg, cb, ca] = _getDrawColor();
-    sdl.SDL_SetTextureColorModFloat(texture, cr / 255, cg / 255, cb / 255);
-    sdl.SDL_SetTextureAlphaModFloat(texture, ca / 255);
-    sdl.SDL_SetTextureBlendMode(texture, _getEffectiveBlendModeSDL());
+    out[dstOff + 2] = vertices[srcOff + 2]!;
+    out[dstOff + 3] = vertices[srcOff + 3]!;
+    out[dstOff + 4] = vertices[srcOff + 4]!;
+    out[dstOff + 5] = vertices[srcOff + 5]!;
+    out[dstOff + 6] = vertices[srcOff + 6]!;
+    out[dstOff + 7] = vertices[srcOff + 7]!;
   }
 
-  sdl.SDL_RenderGeometry(
+  rc.renderGeometry(
     renderer, texture,
-    ptr(_meshScratch), numVerts,
-    ptr(indices), numIndices,
+    out, numVerts,
+    indices, numIndices,
   );
 }
@@ -0,0 +1,572 @@
+// jove2d graphics command buffer — draw calls recorded in JS, replayed natively
+// Internal to graphics.ts / graphics-batch.ts; the public switches are re-exported from graphics.ts.
+//
+// Every SDL render call the graphics modules make goes through the wrappers below. With
+// command buffering off (the default) they call SDL directly, one FFI call each. With it
+// on they append a compact command to a preallocated word buffer instead, and
+// _flushCommands() hands the whole buffer to jove_render_submit() — one FFI call that
+// issues every recorded SDL call natively. SDL_Renderer is single-threaded, so the replay
+// runs on the main thread at the end of the frame (and before any call that can't be
+// recorded, like texture uploads or text rendering — callers flush first).
+//
+// Layout: each command is a header word (opcode | wordCount << 8, counting the header)
+// followed by float32/uint32 payload words. Pointers are two words (lo, hi).
+// Opcodes must match vendor/jove_render/jove_render.c.
+//
+// State setters (draw color, draw blend mode, texture address mode, and per-texture blend
+// mode, color mod and alpha mod) go through a shadow-state cache in both modes: a call
+// that would set the value already in effect is dropped before it reaches SDL or the
+// buffer. Texture entries must be dropped with _forgetTexture() before the texture is
+// destroyed, since SDL may hand the same pointer to the next texture.
+//
+// appendQuads() collects textured quads from consecutive calls on one texture (Text draws)
+// and issues them as a single RenderGeometry when anything else is drawn or set, or at a
+// flush — so any number of texts sharing a glyph atlas costs one submission. A batch may
+// carry its own GPU render state (SDF text), set just around its RenderGeometry.
+
+import { ptr } from "bun:ffi";
+import type { Pointer } from "bun:ffi";
+import sdl from "../sdl/ffi.ts";
+import { loadRender } from "../sdl/ffi_render.ts";
+import type { SDLRenderer, SDLTexture } from "../sdl/types.ts";
+
+const CMD_DRAW_COLOR = 1;
+const CMD_DRAW_BLEND = 2;
+const CMD_CLEAR = 3;
+const CMD_LINES = 4;
+const CMD_POINT = 5;
+const CMD_LINE = 6;
+const CMD_RECT = 7;
+const CMD_FILL_RECT = 8;
+const CMD_TEX_BLEND = 9;
+const CMD_TEX_COLOR_MOD = 10;
+const CMD_TEX_ALPHA_MOD = 11;
+const CMD_TEXTURE = 12;
+const CMD_GEOMETRY = 13;
+const CMD_ADDRESS_MODE = 14;
+const CMD_TARGET = 15;
+const CMD_CLIP = 16;
+const CMD_GPU_STATE = 17;
+const CMD_RENDER_SCALE = 18;
+
+const INITIAL_WORDS = 1 << 18; // 1 MiB
+const MAX_WORDS = 1 << 24; // flush instead of growing past 64 MiB
+const FLOATS_PER_VERTEX = 8; // SDL_Vertex: x,y,r,g,b,a,u,v
+
+export interface CommandBufferStats {
+  enabled: boolean;
+  /** Commands recorded last frame. */
+  commands: number;
+  /** Bytes of command data submitted last frame. */
+  bytes: number;
+  /** Native submits last frame (1 + one per mid-frame flush). */
+  flushes: number;
+  /** Main-thread JS time last frame, from the start of the frame to the final submit, excluding submits. */
+  recordMs: number;
+  /** Time spent in jove_render_submit() last frame. */
+  submitMs: number;
+  /** Current buffer capacity in bytes. */
+  capacity: number;
+}
+
+let _enabled = false;
+let _renderer: SDLRenderer | null = null;
+
+let _buf = new ArrayBuffer(0);
+let _u32 = new Uint32Array(_buf);
+let _f32 = new Float32Array(_buf);
+let _i32 = new Int32Array(_buf);
+let _len = 0;
+
+// Per-frame counters (current frame) and the last completed frame's stats
+let _commands = 0;
+let _words = 0;
+let _flushes = 0;
+let _submitMs = 0;
+let _frameStart = 0;
+const _last: CommandBufferStats = {
+  enabled: false, commands: 0, bytes: 0, flushes: 0, recordMs: 0, submitMs: 0, capacity: 0,
+};
+
+// Shadow render state — NaN = unknown, so the next set always goes through
+interface TextureState {
+  blend: number;
+  r: number;
+  g: number;
+  b: number;
+  a: number;
+}
+const _textureState = new Map<number, TextureState>();
+const _drawColor = [NaN, NaN, NaN, NaN];
+let _drawBlend = NaN;
+let _addressU = NaN;
+let _addressV = NaN;
+let _stateSets = 0;
+let _stateElided = 0;
+// GPU render state last set through setGPURenderState() (the active shader)
+let _gpuState: Pointer | null = null;
+
+// Pending quads from appendQuads(), all on _quadTexture, drawn with _quadState
+let _quadRenderer: SDLRenderer | null = null;
+let _quadTexture: SDLTexture | null = null;
+let _quadState: Pointer | null = null;
+let _quadVerts = new Float32Array(0);
+let _quadIndices = new Int32Array(0);
+let _quadCount = 0;
+
+function _textureEntry(texture: SDLTexture | null): TextureState {
+  const key = (texture as unknown as number) ?? 0;
+  let state = _textureState.get(key);
+  if (!state) {
+    state = { blend: NaN, r: NaN, g: NaN, b: NaN, a: NaN };
+    _textureState.set(key, state);
+  }
+  return state;
+}
+
+function _allocate(words: number): void {
+  const next = new ArrayBuffer(words * 4);
+  new Uint32Array(next).set(_u32.subarray(0, _len));
+  _buf = next;
+  _u32 = new Uint32Array(next);
+  _f32 = new Float32Array(next);
+  _i32 = new Int32Array(next);
+}
+
+/** Reserve a command of `words` words (header included); returns the offset of its first payload word. */
+function _begin(op: number, words: number): number {
+  if (_len + words > _u32.length) {
+    // Grow (keeping one submit per frame) up to MAX_WORDS, then fall back to flushing early
+    let size = _u32.length;
+    while (size < _len + words && size < MAX_WORDS) size *= 2;
+    if (size >= _len + words) {
+      _allocate(size);
+    } else {
+      _flushCommands();
+      if (words > _u32.length) _allocate(words);
+    }
+  }
+  const at = _len;
+  _u32[at] = op | (words << 8);
+  _len += words;
+  _commands++;
+  return at + 1;
+}
+
+function _putPtr(at: number, p: Pointer | null): void {
+  const n = (p as unknown as number) ?? 0;
+  _u32[at] = n >>> 0;
+  _u32[at + 1] = Math.floor(n / 4294967296);
+}
+
+// ============================================================
+// Control (internal, called by graphics.ts)
+// ============================================================
+
+/** Turn recording on for `renderer`. Returns false if the native render helper is unavailable. */
+export function _setCommandBuffering(renderer: SDLRenderer | null, enable: boolean): boolean {
+  if (!enable) {
+    _flushCommands();
+    _enabled = false;
+    _last.enabled = false;
+    return true;
+  }
+  if (!renderer || !loadRender()) return false;
+  if (_u32.length === 0) _allocate(INITIAL_WORDS);
+  _renderer = renderer;
+  _enabled = true;
+  _last.enabled = true;
+  return true;
+}
+
+export function _isCommandBuffering(): boolean {
+  return _enabled;
+}
+
+/** Submit everything recorded so far. No-op when nothing is pending. */
+export function _flushCommands(): void {
+  if (_quadCount > 0) _emitQuads();
+  if (_len === 0 || !_renderer) return;
+  const lib = loadRender()!;
+  const t0 = performance.now();
+  const n = lib.jove_render_submit(_renderer, ptr(_u32), _len);
+  _submitMs += performance.now() - t0;
+  _words += _len;
+  _flushes++;
+  _len = 0;
+  if (n < 0) throw new Error("jove_render_submit: malformed command buffer");
+}
+
+/** Start of frame: reset per-frame counters. */
+export function _beginCommandFrame(): void {
+  // Renderer state is cheap to re-establish once a frame and may have been set outside the cache
+  _invalidateRenderState();
+  _stateSets = 0;
+  _stateElided = 0;
+  _commands = 0;
+  _words = 0;
+  _flushes = 0;
+  _submitMs = 0;
+  _frameStart = performance.now();
+}
+
+/** End of frame: submit and publish this frame's stats. Call before SDL_RenderPresent. */
+export function _endCommandFrame(): void {
+  if (!_enabled) {
+    if (_quadCount > 0) _emitQuads();
+    return;
+  }
+  const submitBefore = _submitMs;
+  const tEnd = performance.now();
+  _flushCommands();
+  _last.commands = _commands;
+  _last.bytes = _words * 4;
+  _last.flushes = _flushes;
+  _last.recordMs = tEnd - _frameStart - submitBefore;
+  _last.submitMs = _submitMs;
+}
+
+/** Drop pending commands without submitting (renderer teardown). */
+export function _resetCommands(): void {
+  _invalidateRenderState();
+  _textureState.clear();
+  _quadCount = 0;
+  _quadRenderer = null;
+  _quadTexture = null;
+  _quadState = null;
+  _gpuState = null;
+  _len = 0;
+  _enabled = false;
+  _renderer = null;
+  _last.enabled = false;
+}
+
+export function _getCommandBufferStats(): CommandBufferStats {
+  return { ..._last, capacity: _u32.length * 4 };
+}
+
+/** Forget the cached renderer-global state, so the next setters reach SDL. */
+export function _invalidateRenderState(): void {
+  _drawColor.fill(NaN);
+  _drawBlend = NaN;
+  _addressU = NaN;
+  _addressV = NaN;
+}
+
+/** Drop a texture's cached state. Call before SDL_DestroyTexture. */
+export function _forgetTexture(texture: SDLTexture | null): void {
+  if (_quadCount > 0 && texture === _quadTexture) _emitQuads();
+  _textureState.delete((texture as unknown as number) ?? 0);
+}
+
+/** State setter calls this frame: [made, elided by the cache]. */
+export function _getStateCounts(): [number, number] {
+  return [_stateSets, _stateElided];
+}
+
+// ============================================================
+// Render calls — recorded when buffering, direct SDL otherwise
+// ============================================================
+
+export function setRenderDrawColor(r: SDLRenderer | null, red: number, green: number, blue: number, alpha: number): void {
+  const c = _drawColor;
+  if (c[0] === red && c[1] === green && c[2] === blue && c[3] === alpha) {
+    _stateElided++;
+    return;
+  }
+  c[0] = red;
+  c[1] = green;
+  c[2] = blue;
+  c[3] = alpha;
+  _stateSets++;
+  if (_quadCount > 0) _emitQuads();
+  if (!_enabled) {
+    sdl.SDL_SetRenderDrawColor(r, red, green, blue, alpha);
+    return;
+  }
+  const at = _begin(CMD_DRAW_COLOR, 5);
+  _f32[at] = red;
+  _f32[at + 1] = green;
+  _f32[at + 2] = blue;
+  _f32[at + 3] = alpha;
+}
+
+export function setRenderDrawBlendMode(r: SDLRenderer | null, mode: number): void {
+  if (_drawBlend === mode) {
+    _stateElided++;
+    return;
+  }
+  _drawBlend = mode;
+  _stateSets++;
+  if (_quadCount > 0) _emitQuads();
+  if (!_enabled) {
+    sdl.SDL_SetRenderDrawBlendMode(r, mode);
+    return;
+  }
+  _u32[_begin(CMD_DRAW_BLEND, 2)] = mode;
+}
+
+export function renderClear(r: SDLRenderer | null): void {
+  if (_quadCount > 0) _emitQuads();
+  if (!_enabled) {
+    sdl.SDL_RenderClear(r);
+    return;
+  }
+  _begin(CMD_CLEAR, 1);
+}
+
+/** SDL_RenderLines over the first `count` points of `points` (x, y pairs). */
+export function renderLines(r: SDLRenderer | null, points: Float32Array, count: number): void {
+  if (_quadCount > 0) _emitQuads();
+  if (!_enabled) {
+    sdl.SDL_RenderLines(r, ptr(points), count);
+    return;
+  }
+  const at = _begin(CMD_LINES, 2 + count * 2);
+  _u32[at] = count;
+  _f32.set(points.subarray(0, count * 2), at + 1);
+}
+
+export function renderPoint(r: SDLRenderer | null, x: number, y: number): void {
+  if (_quadCount > 0) _emitQuads();
+  if (!_enabled) {
+    sdl.SDL_RenderPoint(r, x, y);
+    return;
+  }
+  const at = _begin(CMD_POINT, 3);
+  _f32[at] = x;
+  _f32[at + 1] = y;
+}
+
+export function renderLine(r: SDLRenderer | null, x1: number, y1: number, x2: number, y2: number): void {
+  if (_quadCount > 0) _emitQuads();
+  if (!_enabled) {
+    sdl.SDL_RenderLine(r, x1, y1, x2, y2);
+    return;
+  }
+  const at = _begin(CMD_LINE, 5);
+  _f32[at] = x1;
+  _f32[at + 1] = y1;
+  _f32[at + 2] = x2;
+  _f32[at + 3] = y2;
+}
+
+/** SDL_RenderRect with an [x, y, w, h] rect. */
+export function renderRect(r: SDLRenderer | null, rect: Float32Array): void {
+  if (_quadCount > 0) _emitQuads();
+  if (!_enabled) {
+    sdl.SDL_RenderRect(r, ptr(rect));
+    return;
+  }
+  _f32.set(rect.subarray(0, 4), _begin(CMD_RECT, 5));
+}
+
+/** SDL_RenderFillRect with an [x, y, w, h] rect. */
+export function renderFillRect(r: SDLRenderer | null, rect: Float32Array): void {
+  if (_quadCount > 0) _emitQuads();
+  if (!_enabled) {
+    sdl.SDL_RenderFillRect(r, ptr(rect));
+    return;
+  }
+  _f32.set(rect.subarray(0, 4), _begin(CMD_FILL_RECT, 5));
+}
+
+/** SDL_RenderTexture; null rects mean the whole texture / whole target. */
+export function renderTexture(r: SDLRenderer | null, texture: SDLTexture | null, src: Float32Array | null, dst: Float32Array | null): void {
+  if (_quadCount > 0) _emitQuads();
+  if (!_enabled) {
+    sdl.SDL_RenderTexture(r, texture, src ? ptr(src) : null, dst ? ptr(dst) : null);
+    return;
+  }
+  const at = _begin(CMD_TEXTURE, 12);
+  _putPtr(at, texture);
+  _u32[at + 2] = (src ? 1 : 0) | (dst ? 2 : 0);
+  if (src) _f32.set(src.subarray(0, 4), at + 3);
+  if (dst) _f32.set(dst.subarray(0, 4), at + 7);
+}
+
+/** SDL_RenderGeometry over `numVerts` SDL_Vertex-layout vertices and optional indices. */
+export function renderGeometry(
+  r: SDLRenderer | null, texture: SDLTexture | null,
+  vertices: Float32Array, numVerts: number,
+  indices: Int32Array | null, numIndices: number,
+): void {
+  if (_quadCount > 0) _emitQuads();
+  if (!_enabled) {
+    sdl.SDL_RenderGeometry(r, texture, ptr(vertices), numVerts, indices ? ptr(indices) : null, numIndices);
+    return;
+  }
+  const ni = indices ? numIndices : 0;
+  const vertWords = numVerts * FLOATS_PER_VERTEX;
+  const at = _begin(CMD_GEOMETRY, 5 + vertWords + ni);
+  _putPtr(at, texture);
+  _u32[at + 2] = numVerts;
+  _u32[at + 3] = ni;
+  _f32.set(vertices.subarray(0, vertWords), at + 4);
+  if (ni > 0) _i32.set(indices!.subarray(0, ni), at + 4 + vertWords);
+}
+
+export function setTextureBlendMode(texture: SDLTexture | null, mode: number): void {
+  const state = _textureEntry(texture);
+  if (state.blend === mode) {
+    _stateElided++;
+    return;
+  }
+  state.blend = mode;
+  _stateSets++;
+  if (_quadCount > 0) _emitQuads();
+  if (!_enabled) {
+    sdl.SDL_SetTextureBlendMode(texture, mode);
+    return;
+  }
+  const at = _begin(CMD_TEX_BLEND, 4);
+  _putPtr(at, texture);
+  _u32[at + 2] = mode;
+}
+
+export function setTextureColorModFloat(texture: SDLTexture | null, red: number, green: number, blue: number): void {
+  const state = _textureEntry(texture);
+  if (state.r === red && state.g === green && state.b === blue) {
+    _stateElided++;
+    return;
+  }
+  state.r = red;
+  state.g = green;
+  state.b = blue;
+  _stateSets++;
+  if (_quadCount > 0) _emitQuads();
+  if (!_enabled) {
+    sdl.SDL_SetTextureColorModFloat(texture, red, green, blue);
+    return;
+  }
+  const at = _begin(CMD_TEX_COLOR_MOD, 6);
+  _putPtr(at, texture);
+  _f32[at + 2] = red;
+  _f32[at + 3] = green;
+  _f32[at + 4] = blue;
+}
+
+export function setTextureAlphaModFloat(texture: SDLTexture | null, alpha: number): void {
+  const state = _textureEntry(texture);
+  if (state.a === alpha) {
+    _stateElided++;
+    return;
+  }
+  state.a = alpha;
+  _stateSets++;
+  if (_quadCount > 0) _emitQuads();
+  if (!_enabled) {
+    sdl.SDL_SetTextureAlphaModFloat(texture, alpha);
+    return;
+  }
+  const at = _begin(CMD_TEX_ALPHA_MOD, 4);
+  _putPtr(at, texture);
+  _f32[at + 2] = alpha;
+}
+
+export function setRenderTextureAddressMode(r: SDLRenderer | null, u: number, v: number): void {
+  if (_addressU === u && _addressV === v) {
+    _stateElided++;
+    return;
+  }
+  _addressU = u;
+  _addressV = v;
+  _stateSets++;
+  if (_quadCount > 0) _emitQuads();
+  if (!_enabled) {
+    sdl.SDL_SetRenderTextureAddressMode(r, u, v);
+    return;
+  }
+  const at = _begin(CMD_ADDRESS_MODE, 3);
+  _u32[at] = u;
+  _u32[at + 1] = v;
+}
+
+export function setRenderTarget(r: SDLRenderer | null, texture: SDLTexture | null): void {
+  if (_quadCount > 0) _emitQuads();
+  if (!_enabled) {
+    sdl.SDL_SetRenderTarget(r, texture);
+    return;
+  }
+  _putPtr(_begin(CMD_TARGET, 3), texture);
+}
+
+/** SDL_SetRenderClipRect with an integer [x, y, w, h] rect, or null to disable clipping. */
+export function setRenderClipRect(r: SDLRenderer | null, rect: Int32Array | null): void {
+  if (_quadCount > 0) _emitQuads();
+  if (!_enabled) {
+    sdl.SDL_SetRenderClipRect(r, rect ? ptr(rect) : null);
+    return;
+  }
+  const at = _begin(CMD_CLIP, 6);
+  _u32[at] = rect ? 1 : 0;
+  if (rect) _i32.set(rect.subarray(0, 4), at + 1);
+}
+
+export function setGPURenderState(r: SDLRenderer | null, state: Pointer | null): void {
+  if (_quadCount > 0) _emitQuads();
+  _gpuState = state;
+  if (!_enabled) {
+    sdl.SDL_SetGPURenderState(r, state);
+    return;
+  }
+  _putPtr(_begin(CMD_GPU_STATE, 3), state);
+}
+
+export function setRenderScale(r: SDLRenderer | null, sx: number, sy: number): void {
+  if (_quadCount > 0) _emitQuads();
+  if (!_enabled) {
+    sdl.SDL_SetRenderScale(r, sx, sy);
+    return;
+  }
+  const at = _begin(CMD_RENDER_SCALE, 3);
+  _f32[at] = sx;
+  _f32[at + 1] = sy;
+}
+
+/**
+ * Queue `count` textured quads (4 SDL_Vertex each, corners in order) on `texture`. Quads
+ * from consecutive calls on the same texture and state are drawn with one RenderGeometry;
+ * set the texture's blend and color mods before calling. `state` is the GPU render state
+ * to draw with — by default the one in effect.
+ */
+export function appendQuads(
+  r: SDLRenderer | null,
+  texture: SDLTexture | null,
+  vertices: Float32Array,
+  count: number,
+  state: Pointer | null = _gpuState,
+): void {
+  if (_quadCount > 0 && (texture !== _quadTexture || r !== _quadRenderer || state !== _quadState)) _emitQuads();
+  const need = (_quadCount + count) * 4 * FLOATS_PER_VERTEX;
+  if (_quadVerts.length < need) {
+    const grown = new Float32Array(Math.max(need, _quadVerts.length * 2));
+    grown.set(_quadVerts.subarray(0, _quadCount * 4 * FLOATS_PER_VERTEX));
+    _quadVerts = grown;
+    const quads = grown.length / (4 * FLOATS_PER_VERTEX);
+    _quadIndices = new Int32Array(quads * 6);
+    for (let i = 0; i < quads; i++) {
+      const v = i * 4, at = i * 6;
+      _quadIndices[at] = v;
+      _quadIndices[at + 1] = v + 1;
+      _quadIndices[at + 2] = v + 2;
+      _quadIndices[at + 3] = v;
+      _quadIndices[at + 4] = v + 2;
+      _quadIndices[at + 5] = v + 3;
+    }
+  }
+  _quadVerts.set(vertices.subarray(0, count * 4 * FLOATS_PER_VERTEX), _quadCount * 4 * FLOATS_PER_VERTEX);
+  _quadCount += count;
+  _quadRenderer = r;
+  _quadTexture = texture;
+  _quadState = state;
+}
+
+function _emitQuads(): void {
+  const n = _quadCount;
+  _quadCount = 0;
+  const restore = _gpuState;
+  if (_quadState !== restore) setGPURenderState(_quadRenderer, _quadState);
+  renderGeometry(_quadRenderer, _quadTexture, _quadVerts, n * 4, _quadIndices, n * 6);
+  if (_quadState !== restore) setGPURenderState(_quadRenderer, restore);
+}
@@ -0,0 +1,555 @@
+// jove2d text module — glyph atlases and the glyph-quad layout behind Text objects
+// Internal to graphics.ts, which owns newText().
+//
+// A Text stores positioned, colored glyph quads that reference a font-wide atlas instead
+// of rendering into a private canvas. Bitmap fonts use their own image as the atlas; TTF
+// fonts rasterize each glyph once, on first use, into shared atlas pages. Changing a
+// Text's string only rebuilds its quad arrays, and drawing goes through
+// rc.appendQuads(), so consecutive Text draws on the same page submit together.
+//
+// SDF fonts (newSDFFont) rasterize each glyph once as a signed distance field, using
+// SDL_ttf's SDF mode, at a fixed raster size. Every size of the same file shares that
+// atlas: layout scales the quads, and a smoothstep shader reconstructs a sharp edge at
+// any scale, so resizing or zooming text never re-rasterizes.
+//
+// Releasing a font drops its atlas, but the pages live on while any Text still has quads
+// on them (see TextAtlasRef); the last Text to relayout or be released frees them.
+
+import { ptr, read } from "bun:ffi";
+import type { Pointer } from "bun:ffi";
+import * as rc from "./graphics-commands.ts";
+import type { SDLTexture } from "../sdl/types.ts";
+import type { Font, SDFSource } from "./font.ts";
+import { _createFont, _createSDFFont } from "./font.ts";
+import { createShader } from "./shader.ts";
+import type { Shader } from "./shader.ts";
+import {
+  _getRenderer,
+  _getDrawColor,
+  _getEffectiveBlendModeSDL,
+  _getTransformMatrix,
+  _getTTF,
+  _getTTFEngine,
+  isCulling,
+  _cullBox,
+  _statCull,
+  newCanvas,
+  setCanvas,
+  getCanvas,
+} from "./graphics.ts";
+import type { Canvas } from "./graphics.ts";
+
+export interface TextSegment {
+  text: string;
+  color: [number, number, number, number];
+  x: number;
+  y: number;
+  wrapLimit: number; // 0 = no wrap
+  align: "left" | "center" | "right";
+}
+
+/** One atlas page's worth of a Text's glyphs: 4 SDL_Vertex per glyph, in text-local space. */
+export interface TextPage {
+  texture: SDLTexture;
+  vertices: Float32Array;
+  count: number;
+  /** GPU render state to draw with (the SDF shader); undefined = the active shader */
+  state?: Pointer;
+}
+
+const FLOATS_PER_GLYPH = 32; // 4 verts × 8 floats (x,y,r,g,b,a,u,v)
+const ATLAS_SIZE = 1024;
+const GLYPH_PAD = 1; // transparent border so linear filtering doesn't pick up neighbours
+const SDF_SPREAD = 8; // FreeType's default SDF spread, in raster pixels
+
+// ============================================================
+// TTF glyph atlas
+// ============================================================
+
+interface Glyph {
+  page: number; // -1 = nothing to draw (whitespace, or too large for a page)
+  x: number;
+  y: number;
+  w: number;
+  h: number;
+  /** Quad offset from the pen position. */
+  ox: number;
+  advance: number;
+}
+
+interface GlyphAtlas {
+  /** TTF_Font the glyphs are rasterized from */
+  font: Pointer;
+  /** Border around each glyph's ink: GLYPH_PAD, plus the spread for distance fields */
+  pad: number;
+  pages: Canvas[];
+  glyphs: Map<number, Glyph>;
+  /** Kerning between two code points, in raster pixels, keyed by _pairKey() */
+  kerning: Map<number, number>;
+  penX: number;
+  penY: number;
+  rowH: number;
+  /** Texts whose quads sample these pages */
+  texts: number;
+  /** The font was released; the pages go when the last Text lets go */
+  released: boolean;
+}
+
+/** A Text's hold on the atlas its quads sample, so its pages outlive the font if need be. */
+export interface TextAtlasRef {
+  atlas: GlyphAtlas | null;
+}
+
+// Keyed by Font for TTF fonts, by the shared SDFSource for SDF fonts
+const _atlases = new Map<object, GlyphAtlas>();
+
+// Out-params for TTF_GetGlyphMetrics / TTF_GetGlyphKerning
+const _metrics = new Int32Array(5);
+const _metricsPtr = ptr(_metrics);
+const _kerning = new Int32Array(1);
+const _kerningPtr = ptr(_kerning);
+
+function _newPage(atlas: GlyphAtlas): Canvas | null {
+  const page = newCanvas(ATLAS_SIZE, ATLAS_SIZE);
+  if (!page) return null;
+  page.setFilter("linear", "linear");
+  // Transparent white: glyph edges blended in keep full-white color, so tinting stays exact
+  const prev = getCanvas();
+  setCanvas(page);
+  const r = _getRenderer();
+  rc.setRenderDrawColor(r, 255, 255, 255, 0);
+  rc.renderClear(r);
+  const [dr, dg, db, da] = _getDrawColor();
+  rc.setRenderDrawColor(r, dr, dg, db, da);
+  setCanvas(prev);
+  atlas.pages.push(page);
+  atlas.penX = atlas.penY = atlas.rowH = 0;
+  return page;
+}
+
+/** Rasterize `cp` into the atlas. Returns null if SDL_ttf can't render it. */
+function _rasterize(atlas: GlyphAtlas, cp: number): Glyph | null {
+  const ttf = _getTTF();
+  const engine = _getTTFEngine();
+  if (!ttf || !engine) return null;
+  const pad = atlas.pad;
+  if (!ttf.TTF_GetGlyphMetrics(
+    atlas.font, cp,
+    _metricsPtr, ptr(_metrics, 4), ptr(_metrics, 8), ptr(_metrics, 12), ptr(_metrics, 16),
+  )) return null;
+  const minx = read.i32(_metricsPtr, 0);
+  const maxx = read.i32(_metricsPtr, 4);
+  const advance = read.i32(_metricsPtr, 16);
+  const left = Math.min(0, minx);
+  const inkW = Math.max(advance, maxx) - left;
+  if (maxx <= minx) {
+    return { page: -1, x: 0, y: 0, w: 0, h: 0, ox: 0, advance };
+  }
+  const w = inkW + pad * 2;
+  const h = ttf.TTF_GetFontHeight(atlas.font) + pad * 2;
+  // Can't fit on a page: keep the advance so layout stays right, and never try again
+  if (w > ATLAS_SIZE || h > ATLAS_SIZE) {
+    return { page: -1, x: 0, y: 0, w: 0, h: 0, ox: 0, advance };
+  }
+
+  // Shelf packing: fill rows left to right, open a new page when one is full
+  if (atlas.penX + w > ATLAS_SIZE) {
+    atlas.penX = 0;
+    atlas.penY += atlas.rowH;
+    atlas.rowH = 0;
+  }
+  let page = atlas.pages[atlas.pages.length - 1];
+  if (!page || atlas.penY + h > ATLAS_SIZE) {
+    page = _newPage(atlas) ?? undefined;
+    if (!page) return null;
+  }
+  const glyph: Glyph = {
+    page: atlas.pages.length - 1,
+    x: atlas.penX, y: atlas.penY, w, h,
+    ox: left - pad,
+    advance,
+  };
+  atlas.penX += w;
+  atlas.rowH = Math.max(atlas.rowH, h);
+
+  // In SDF mode the glyph image carries the distance field out to the spread, inside the pad
+  const text = ttf.TTF_CreateText(engine, atlas.font, Buffer.from(String.fromCodePoint(cp) + "\0"), 0);
+  if (!text) return glyph;
+  const prev = getCanvas();
+  setCanvas(page);
+  rc._flushCommands(); // TTF draws straight to the renderer — the target switch must land first
+  ttf.TTF_SetTextColor(text, 255, 255, 255, 255);
+  ttf.TTF_DrawRendererText(text, glyph.x + pad - left, glyph.y + pad);
+  ttf.TTF_DestroyText(text);
+  setCanvas(prev);
+  return glyph;
+}
+
+function _getAtlas(key: object, font: Pointer, pad: number): GlyphAtlas {
+  let atlas = _atlases.get(key);
+  if (!atlas) {
+    atlas = {
+      font, pad, pages: [], glyphs: new Map(), kerning: new Map(),
+      penX: 0, penY: 0, rowH: 0, texts: 0, released: false,
+    };
+    _atlases.set(key, atlas);
+  }
+  return atlas;
+}
+
+function _getGlyph(atlas: GlyphAtlas, cp: number): Glyph | null {
+  let glyph = atlas.glyphs.get(cp);
+  if (glyph === undefined) {
+    glyph = _rasterize(atlas, cp) ?? undefined;
+    if (!glyph) return null;
+    atlas.glyphs.set(cp, glyph);
+  }
+  return glyph;
+}
+
+// Code points are below 0x110000, so the pair fits well inside a safe integer
+function _pairKey(prev: number, cp: number): number {
+  return prev * 0x110000 + cp;
+}
+
+/** Kerning between `prev` and `cp`, asking SDL_ttf only the first time a pair is seen. */
+function _getKerning(atlas: GlyphAtlas, prev: number, cp: number): number {
+  const key = _pairKey(prev, cp);
+  let kern = atlas.kerning.get(key);
+  if (kern === undefined) {
+    const ttf = _getTTF();
+    kern = ttf && ttf.TTF_GetGlyphKerning(atlas.font, prev, cp, _kerningPtr) ? read.i32(_kerningPtr, 0) : 0;
+    atlas.kerning.set(key, kern);
+  }
+  return kern;
+}
+
+function _freePages(atlas: GlyphAtlas): void {
+  for (const page of atlas.pages) page.release();
+  atlas.pages = [];
+}
+
+/** Point `ref` at `atlas`, letting go of the one it held before. */
+function _holdAtlas(ref: TextAtlasRef, atlas: GlyphAtlas | null): void {
+  if (ref.atlas === atlas) return;
+  if (atlas) atlas.texts++;
+  const old = ref.atlas;
+  ref.atlas = atlas;
+  if (old && --old.texts === 0 && old.released) _freePages(old);
+}
+
+// A Text collected without release() lets go of its atlas here
+const _textRefs = new FinalizationRegistry<TextAtlasRef>((ref) => _holdAtlas(ref, null));
+
+/** Drop `ref`'s atlas hold when `text` is collected. */
+export function _trackTextAtlas(text: object, ref: TextAtlasRef): void {
+  _textRefs.register(text, ref);
+}
+
+/** Let go of the atlas a Text's quads sampled (Text.release()). */
+export function _dropTextAtlas(ref: TextAtlasRef): void {
+  _holdAtlas(ref, null);
+}
+
+/**
+ * Release a TTF font's (or an SDF source's) atlas. Pages that Texts still draw from stay
+ * alive until those Texts relayout or are released.
+ */
+export function _releaseGlyphAtlas(key: object): void {
+  const atlas = _atlases.get(key);
+  if (!atlas) return;
+  _atlases.delete(key);
+  atlas.released = true;
+  if (atlas.texts === 0) _freePages(atlas);
+}
+
+/** Release every atlas, SDF source and the SDF shader (renderer teardown). */
+export function _releaseGlyphAtlases(): void {
+  // The renderer is going away, so the pages go now even if Texts still hold them
+  for (const atlas of _atlases.values()) {
+    atlas.released = true;
+    _freePages(atlas);
+  }
+  _atlases.clear();
+  const ttf = _getTTF();
+  for (const src of _sdfSources.values()) ttf?.TTF_CloseFont(src.font);
+  _sdfSources.clear();
+  _sdfShader?.release();
+  _sdfShader = null;
+  _sdfShaderPending = null;
+}
+
+/** Number of glyphs and atlas pages held for a TTF font (for tests and stats). */
+export function _getGlyphAtlasInfo(font: Font): { glyphs: number; pages: number } {
+  const atlas = _atlases.get(font._sdf ?? font);
+  return { glyphs: atlas?.glyphs.size ?? 0, pages: atlas?.pages.length ?? 0 };
+}
+
+// ============================================================
+// SDF fonts
+// ============================================================
+
+interface SDFEntry extends SDFSource {
+  key: string;
+  /** Raster-size font the scaled metrics come from */
+  base: Font;
+  /** Live SDF fonts using this source */
+  refs: number;
+}
+
+const _sdfSources = new Map<string, SDFEntry>();
+let _sdfShader: Shader | null = null;
+let _sdfShaderPending: Promise<Shader | null> | null = null;
+
+// Distance 0.5 is the glyph edge; fwidth() keeps the ramp about one screen pixel wide at any scale
+const SDF_SHADER = `
+vec4 effect(vec4 color, Image tex, vec2 texture_coords, vec2 screen_coords) {
+    float dist = Texel(tex, texture_coords).a;
+    float w = max(fwidth(dist), 0.0001);
+    return vec4(color.rgb, color.a * smoothstep(0.5 - w, 0.5 + w, dist));
+}
+`;
+
+/** Compile the SDF text shader once. Null if the GPU path can't compile it. */
+export async function _getSDFShader(renderer: Pointer, gpuDevice: Pointer): Promise<Shader | null> {
+  if (_sdfShader) return _sdfShader;
+  if (!_sdfShaderPending) {
+    _sdfShaderPending = createShader(SDF_SHADER, renderer, gpuDevice).then(
+      (shader) => {
+        if (_getRenderer() !== renderer) {
+          shader.release(); // renderer torn down while compiling
+          return null;
+        }
+        _sdfShader = shader;
+        return shader;
+      },
+      () => null,
+    );
+  }
+  return _sdfShaderPending;
+}
+
+/**
+ * Open an SDF font of `size` pixels. The distance-field atlas is shared by every size of
+ * `path` at the same `rasterSize`; `preload` glyphs are rasterized now, others on first use.
+ */
+export function _openSDFFont(path: string, size: number, rasterSize: number, preload: string): Font | null {
+  const ttf = _getTTF();
+  if (!ttf || !_getTTFEngine() || !_sdfShader) return null;
+  const key = `${path}\0${rasterSize}`;
+  let src = _sdfSources.get(key);
+  if (!src) {
+    const fontPtr = ttf.TTF_OpenFont(Buffer.from(path + "\0"), rasterSize) as Pointer | null;
+    if (!fontPtr) return null;
+    if (!ttf.TTF_SetFontSDF(fontPtr, true)) {
+      ttf.TTF_CloseFont(fontPtr);
+      return null;
+    }
+    src = { key, font: fontPtr, rasterSize, spread: SDF_SPREAD, base: _createFont(fontPtr, rasterSize, ttf), refs: 0 };
+    _sdfSources.set(key, src);
+    const atlas = _getAtlas(src, fontPtr, SDF_SPREAD + GLYPH_PAD);
+    for (const ch of preload) _getGlyph(atlas, ch.codePointAt(0)!);
+  }
+  src.refs++;
+  const entry = src;
+  let released = false;
+  return _createSDFFont(entry.base, size, entry, () => {
+    if (released) return;
+    released = true;
+    // Already gone if the renderer was torn down first
+    if (--entry.refs > 0 || _sdfSources.get(entry.key) !== entry) return;
+    _releaseGlyphAtlas(entry);
+    _getTTF()?.TTF_CloseFont(entry.font);
+    _sdfSources.delete(entry.key);
+  });
+}
+
+/** Distance between baselines of consecutive lines in `font`, in pixels. */
+export function _getLineSkip(font: Font): number {
+  if (font._isBitmapFont) return Math.round(font._glyphHeight! * font.getLineHeight());
+  const ttf = _getTTF();
+  if (!ttf) return 0;
+  if (font._sdf) {
+    return ttf.TTF_GetFontLineSkip(font._sdf.font) * (font._size / font._sdf.rasterSize) * font.getLineHeight();
+  }
+  return ttf.TTF_GetFontLineSkip(font._font);
+}
+
+// ============================================================
+// Layout
+// ============================================================
+
+interface PageBuilder {
+  texture: SDLTexture;
+  texW: number;
+  texH: number;
+  vertices: Float32Array;
+  count: number;
+}
+
+/** Push a quad drawing source rect (sx, sy, sw, sh) at (x, y, w, h). */
+function _pushQuad(
+  b: PageBuilder,
+  x: number, y: number, w: number, h: number,
+  sx: number, sy: number, sw: number, sh: number,
+  cr: number, cg: number, cb: number, ca: number,
+): void {
+  if ((b.count + 1) * FLOATS_PER_GLYPH > b.vertices.length) {
+    const grown = new Float32Array(Math.max(FLOATS_PER_GLYPH * 16, b.vertices.length * 2));
+    grown.set(b.vertices);
+    b.vertices = grown;
+  }
+  const u0 = sx / b.texW, v0 = sy / b.texH;
+  const u1 = (sx + sw) / b.texW, v1 = (sy + sh) / b.texH;
+  const v = b.vertices;
+  let off = b.count * FLOATS_PER_GLYPH;
+  for (let i = 0; i < 4; i++) {
+    const right = i === 1 || i === 2;
+    const bottom = i >= 2;
+    v[off] = right ? x + w : x;
+    v[off + 1] = bottom ? y + h : y;
+    v[off + 2] = cr;
+    v[off + 3] = cg;
+    v[off + 4] = cb;
+    v[off + 5] = ca;
+    v[off + 6] = right ? u1 : u0;
+    v[off + 7] = bottom ? v1 : v0;
+    off += 8;
+  }
+  b.count++;
+}
+
+/**
+ * Lay out `segments` in `font` as glyph quads, one TextPage per atlas page used. A Text
+ * passes its `ref`, which then holds the atlas the pages come from; print(), which draws
+ * the pages at once, passes none.
+ */
+export function _layoutText(font: Font, segments: TextSegment[], ref?: TextAtlasRef): TextPage[] {
+  const builders: PageBuilder[] = [];
+  if (!font._isBitmapFont && !_getTTF()) {
+    if (ref) _holdAtlas(ref, null);
+    return [];
+  }
+  const lineSkip = _getLineSkip(font);
+  // SDF fonts lay out raster-size glyphs scaled by k
+  const sdf = font._sdf;
+  const k = sdf ? font._size / sdf.rasterSize : 1;
+  const atlas = font._isBitmapFont
+    ? null
+    : sdf
+      ? _getAtlas(sdf, sdf.font, sdf.spread + GLYPH_PAD)
+      : _getAtlas(font, font._font, GLYPH_PAD);
+
+  function builder(page: number, texture: SDLTexture, texW: number, texH: number): PageBuilder {
+    let b = builders[page];
+    if (!b) {
+      b = { texture, texW, texH, vertices: new Float32Array(0), count: 0 };
+      builders[page] = b;
+    }
+    return b;
+  }
+
+  for (const seg of segments) {
+    const cr = seg.color[0] / 255, cg = seg.color[1] / 255, cb = seg.color[2] / 255, ca = seg.color[3] / 255;
+    const lines = seg.wrapLimit > 0 ? font.getWrap(seg.text, seg.wrapLimit)[1] : seg.text.split("\n");
+
+    for (let i = 0; i < lines.length; i++) {
+      const line = lines[i]!;
+      if (line.length === 0) continue;
+      let penX = seg.x;
+      if (seg.wrapLimit > 0 && seg.align !== "left") {
+        const lineWidth = font.getWidth(line);
+        penX += seg.align === "center" ? (seg.wrapLimit - lineWidth) / 2 : seg.wrapLimit - lineWidth;
+      }
+      const penY = seg.y + i * lineSkip;
+
+      if (font._isBitmapFont) {
+        const glyphH = font._glyphHeight!;
+        const spacing = font._extraSpacing!;
+        for (const ch of line) {
+          const g = font._glyphMap!.get(ch);
+          if (!g) continue;
+          const b = builder(0, font._texture!, font._textureWidth!, font._textureHeight!);
+          _pushQuad(b, penX, penY, g.w, glyphH, g.x, 0, g.w, glyphH, cr, cg, cb, ca);
+          penX += g.w + spacing;
+        }
+        continue;
+      }
+
+      let prev = 0;
+      for (const ch of line) {
+        const cp = ch.codePointAt(0)!;
+        if (prev) penX += _getKerning(atlas!, prev, cp) * k;
+        prev = cp;
+        const g = _getGlyph(atlas!, cp);
+        if (!g) continue;
+        if (g.page >= 0) {
+          const page = atlas!.pages[g.page]!;
+          const b = builder(g.page, page._texture, ATLAS_SIZE, ATLAS_SIZE);
+          _pushQuad(b, penX + g.ox * k, penY - atlas!.pad * k, g.w * k, g.h * k, g.x, g.y, g.w, g.h, cr, cg, cb, ca);
+        }
+        penX += g.advance * k;
+      }
+    }
+  }
+
+  const state = sdf ? _sdfShader?._state : undefined;
+  const pages: TextPage[] = [];
+  for (const b of builders) {
+    if (b && b.count > 0) pages.push({ texture: b.texture, vertices: b.vertices, count: b.count, state });
+  }
+  if (ref) _holdAtlas(ref, pages.length > 0 ? atlas : null);
+  return pages;
+}
+
+// ============================================================
+// Drawing
+// ============================================================
+
+let _textScratch = new Float32Array(0);
+
+/** Draw a Text's glyph pages with a draw transform and the global transform. */
+export function _drawTextPages(
+  pages: TextPage[],
+  w: number, h: number,
+  x: number, y: number, r: number,
+  sx: number, sy: number,
+  ox: number, oy: number,
+): void {
+  const renderer = _getRenderer();
+  if (!renderer || pages.length === 0) return;
+  if (isCulling() && _cullBox(0, 0, w, h, x, y, r, sx, sy, ox, oy)) {
+    _statCull(1);
+    return;
+  }
+
+  const [a, b, c, d, tx, ty] = _getTransformMatrix();
+  const cos = Math.cos(r), sin = Math.sin(r);
+  const [cr, cg, cb, ca] = _getDrawColor();
+  const blend = _getEffectiveBlendModeSDL();
+
+  for (const page of pages) {
+    const numFloats = page.count * FLOATS_PER_GLYPH;
+    if (_textScratch.length < numFloats) _textScratch = new Float32Array(numFloats);
+    const src = page.vertices;
+    for (let off = 0; off < numFloats; off += 8) {
+      const lx = (src[off]! - ox) * sx;
+      const ly = (src[off + 1]! - oy) * sy;
+      const wx = lx * cos - ly * sin + x;
+      const wy = lx * sin + ly * cos + y;
+      _textScratch[off] = a * wx + c * wy + tx;
+      _textScratch[off + 1] = b * wx + d * wy + ty;
+      _textScratch[off + 2] = src[off + 2]!;
+      _textScratch[off + 3] = src[off + 3]!;
+      _textScratch[off + 4] = src[off + 4]!;
+      _textScratch[off + 5] = src[off + 5]!;
+      _textScratch[off + 6] = src[off + 6]!;
+      _textScratch[off + 7] = src[off + 7]!;
+    }
+    rc.setTextureBlendMode(page.texture, blend);
+    rc.setTextureColorModFloat(page.texture, cr / 255, cg / 255, cb / 255);
+    rc.setTextureAlphaModFloat(page.texture, ca / 255);
+    if (page.state) rc.appendQuads(renderer, page.texture, _textScratch, page.count, page.state);
+    else rc.appendQuads(renderer, page.texture, _textScratch, page.count);
+  }
+}
@@ -0,0 +1,383 @@
+// jove2d tilemap module — chunked tile layers built on SpriteBatch
+// Internal to graphics.ts, which re-exports newTilemap() and routes draw(tilemap).
+//
+// Each layer is split into square chunks of tiles. A chunk holds its non-empty tiles in a
+// SpriteBatch whose vertices are in map space, and is rebuilt only when one of its tiles
+// changes. Drawing culls whole chunks against the visible area. Animated tiles don't touch
+// geometry: update() advances a per-tile frame table, and chunks holding animated tiles
+// rewrite just those tiles' UVs from the tileset's UV table when a frame changes.
+
+import { newSpriteBatch, _drawSpriteBatch } from "./graphics-batch.ts";
+import type { SpriteBatch } from "./graphics-batch.ts";
+import type { SDLTexture } from "../sdl/types.ts";
+import { _getRenderer, _cullBox, _statCull, newQuad } from "./graphics.ts";
+import type { Image, Quad } from "./graphics.ts";
+
+const FLOATS_PER_SPRITE = 32; // SpriteBatch vertex layout: 4 × (x,y,r,g,b,a,u,v)
+const DEFAULT_CHUNK_TILES = 16;
+
+export interface Tilemap {
+  _isTilemap: true;
+  _texture: SDLTexture;
+  /**
+   * Set the tile at cell (x, y) of `layer` (1-based). Tiles number the tileset left to
+   * right, top to bottom from 1; 0 clears the cell.
+   */
+  setTile(layer: number, x: number, y: number, tile: number): void;
+  getTile(layer: number, x: number, y: number): number;
+  /** Replace a whole layer from row-major tile ids (width × height). */
+  setTiles(layer: number, tiles: ArrayLike<number>): void;
+  fill(layer: number, tile: number): void;
+  /** Cycle `tile` through `frames` wherever it is placed; durations in seconds. */
+  setAnimation(tile: number, frames: number[], durations: number | number[]): void;
+  clearAnimation(tile: number): void;
+  /** Advance tile animations by `dt` seconds. */
+  update(dt: number): void;
+  setLayerVisible(layer: number, visible: boolean): void;
+  isLayerVisible(layer: number): boolean;
+  getLayerCount(): number;
+  /** Map size in tiles. */
+  getDimensions(): [number, number];
+  getTileDimensions(): [number, number];
+  /** Number of tiles in the tileset image. */
+  getTileCount(): number;
+  /** Chunk edge in tiles. Changing it rebuilds every chunk. */
+  setChunkSize(tiles: number): void;
+  getChunkSize(): number;
+  getImage(): Image;
+  release(): void;
+  /** @internal — chunks that exist, and how many were rebuilt since creation (for tests) */
+  _getChunkInfo(): { chunks: number; rebuilds: number };
+  /** @internal — sprite vertices of the chunk holding cell (x, y); null if not built (for tests) */
+  _getChunkVertices(layer: number, x: number, y: number): Float32Array | null;
+}
+
+interface TileChunk {
+  /** This chunk's tiles, positions in map space; null until the chunk has had a tile */
+  batch: SpriteBatch | null;
+  /** Non-empty cells, kept current as tiles are set (for culling stats) */
+  count: number;
+  /** Tiles changed — rebuild the batch before the next draw */
+  dirty: boolean;
+  /** Animated tiles as (sprite index, tile id) pairs */
+  animated: number[];
+  /** _animVersion the animated UVs were last written for */
+  animVersion: number;
+}
+
+interface TileLayer {
+  tiles: Uint32Array;
+  chunks: TileChunk[];
+  visible: boolean;
+}
+
+interface TileAnimation {
+  frames: number[];
+  /** End time of each frame within the cycle */
+  ends: number[];
+  total: number;
+}
+
+/**
+ * Create a tilemap of `width` × `height` cells of `tileWidth` × `tileHeight` pixels drawn
+ * from the tileset `image`, with `layers` empty layers (jove2d extension).
+ * `spacing` and `margin` describe gaps between and around the tiles in the image.
+ */
+export function newTilemap(
+  image: Image,
+  tileWidth: number,
+  tileHeight: number,
+  width: number,
+  height: number,
+  layers: number = 1,
+  spacing: number = 0,
+  margin: number = 0,
+): Tilemap | null {
+  if (!_getRenderer()) return null;
+  const tw = Math.max(1, Math.floor(tileWidth));
+  const th = Math.max(1, Math.floor(tileHeight));
+  const mapW = Math.max(0, Math.floor(width));
+  const mapH = Math.max(0, Math.floor(height));
+
+  // Tileset: quads for building, and a UV table (u0, v0, u1, v1 per tile) for animation
+  const columns = Math.max(0, Math.floor((image._width - 2 * margin + spacing) / (tw + spacing)));
+  const rows = Math.max(0, Math.floor((image._height - 2 * margin + spacing) / (th + spacing)));
+  const tileCount = columns * rows;
+  const quads: Quad[] = [];
+  const uvs = new Float32Array(tileCount * 4);
+  for (let i = 0; i < tileCount; i++) {
+    const sx = margin + (i % columns) * (tw + spacing);
+    const sy = margin + Math.floor(i / columns) * (th + spacing);
+    quads.push(newQuad(sx, sy, tw, th, image._width, image._height));
+    uvs[i * 4] = sx / image._width;
+    uvs[i * 4 + 1] = sy / image._height;
+    uvs[i * 4 + 2] = (sx + tw) / image._width;
+    uvs[i * 4 + 3] = (sy + th) / image._height;
+  }
+
+  const _layers: TileLayer[] = [];
+  let _chunkTiles = DEFAULT_CHUNK_TILES;
+  let _chunksX = 0;
+  let _chunksY = 0;
+  let _rebuilds = 0;
+
+  // Animation: each tile's frame in effect (itself unless animated), bumped version on change
+  const _animations = new Map<number, TileAnimation>();
+  const _frame = new Uint32Array(tileCount + 1);
+  for (let i = 0; i <= tileCount; i++) _frame[i] = i;
+  let _clock = 0;
+  let _animVersion = 0;
+
+  function _newChunks(): TileChunk[] {
+    const chunks: TileChunk[] = [];
+    for (let i = 0; i < _chunksX * _chunksY; i++) {
+      chunks.push({ batch: null, count: 0, dirty: true, animated: [], animVersion: -1 });
+    }
+    return chunks;
+  }
+
+  function _layoutChunks(): void {
+    _chunksX = Math.ceil(mapW / _chunkTiles);
+    _chunksY = Math.ceil(mapH / _chunkTiles);
+    for (const layer of _layers) {
+      layer.chunks = _newChunks();
+      for (let i = 0; i < layer.tiles.length; i++) {
+        if (layer.tiles[i] !== 0) _chunkAt(layer, i % mapW, Math.floor(i / mapW)).count++;
+      }
+    }
+  }
+
+  function _layer(layer: number): TileLayer | null {
+    return _layers[layer - 1] ?? null;
+  }
+
+  function _chunkAt(layer: TileLayer, x: number, y: number): TileChunk {
+    return layer.chunks[Math.floor(y / _chunkTiles) * _chunksX + Math.floor(x / _chunkTiles)]!;
+  }
+
+  /** Store `tile` at cell index `i`, keeping its chunk's count and dirty flag current. */
+  function _store(layer: TileLayer, i: number, tile: number): void {
+    const prev = layer.tiles[i]!;
+    const next = tile > 0 ? Math.floor(tile) : 0;
+    if (prev === next) return;
+    layer.tiles[i] = next;
+    const chunk = _chunkAt(layer, i % mapW, Math.floor(i / mapW));
+    chunk.dirty = true;
+    if (prev === 0) chunk.count++;
+    else if (next === 0) chunk.count--;
+  }
+
+  function _rebuild(layer: TileLayer, ci: number): void {
+    const chunk = layer.chunks[ci]!;
+    chunk.dirty = false;
+    chunk.animated.length = 0;
+    chunk.animVersion = _animVersion;
+    const cx0 = (ci % _chunksX) * _chunkTiles;
+    const cy0 = Math.floor(ci / _chunksX) * _chunkTiles;
+    const cx1 = Math.min(mapW, cx0 + _chunkTiles);
+    const cy1 = Math.min(mapH, cy0 + _chunkTiles);
+    chunk.batch?.clear();
+    for (let y = cy0; y < cy1; y++) {
+      for (let x = cx0; x < cx1; x++) {
+        const tile = layer.tiles[y * mapW + x]!;
+        if (tile === 0 || tile > tileCount) continue;
+        if (!chunk.batch) {
+          chunk.batch = newSpriteBatch(image, _chunkTiles * _chunkTiles);
+          if (!chunk.batch) return;
+        }
+        const id = chunk.batch.add(quads[_frame[tile]! - 1]!, x * tw, y * th);
+        if (_animations.has(tile)) chunk.animated.push(id - 1, tile);
+      }
+    }
+    _rebuilds++;
+  }
+
+  /** Rewrite the UVs of a chunk's animated tiles for the current frames. */
+  function _patchAnimated(chunk: TileChunk): void {
+    chunk.animVersion = _animVersion;
+    const vertexData: Float32Array = (chunk.batch as any)._getBuffers().vertexData;
+    for (let i = 0; i < chunk.animated.length; i += 2) {
+      const base = chunk.animated[i]! * FLOATS_PER_SPRITE;
+      const uv = (_frame[chunk.animated[i + 1]!]! - 1) * 4;
+      const u0 = uvs[uv]!, v0 = uvs[uv + 1]!, u1 = uvs[uv + 2]!, v1 = uvs[uv + 3]!;
+      // Corner order matches SpriteBatch: TL, TR, BR, BL
+      vertexData[base + 6] = u0; vertexData[base + 7] = v0;
+      vertexData[base + 14] = u1; vertexData[base + 15] = v0;
+      vertexData[base + 22] = u1; vertexData[base + 23] = v1;
+      vertexData[base + 30] = u0; vertexData[base + 31] = v1;
+    }
+  }
+
+  function _applyFrames(): void {
+    let changed = false;
+    for (const [tile, anim] of _animations) {
+      const t = anim.total > 0 ? _clock % anim.total : 0;
+      let f = 0;
+      while (f < anim.frames.length - 1 && t >= anim.ends[f]!) f++;
+      const next = anim.frames[f]!;
+      if (_frame[tile] !== next) {
+        _frame[tile] = next;
+        changed = true;
+      }
+    }
+    if (changed) _animVersion++;
+  }
+
+  const tilemap: Tilemap & {
+    _draw(x: number, y: number, r: number, sx: number, sy: number, ox: number, oy: number): void;
+  } = {
+    _isTilemap: true as const,
+    get _texture() { return image._texture; },
+
+    setTile(layer: number, x: number, y: number, tile: number): void {
+      const l = _layer(layer);
+      if (!l || x < 0 || y < 0 || x >= mapW || y >= mapH) return;
+      _store(l, Math.floor(y) * mapW + Math.floor(x), tile);
+    },
+
+    getTile(layer: number, x: number, y: number): number {
+      const l = _layer(layer);
+      if (!l || x < 0 || y < 0 || x >= mapW || y >= mapH) return 0;
+      return l.tiles[Math.floor(y) * mapW + Math.floor(x)]!;
+    },
+
+    setTiles(layer: number, tiles: ArrayLike<number>): void {
+      const l = _layer(layer);
+      if (!l) return;
+      const n = Math.min(tiles.length, l.tiles.length);
+      for (let i = 0; i < n; i++) _store(l, i, tiles[i]!);
+    },
+
+    fill(layer: number, tile: number): void {
+      const l = _layer(layer);
+      if (!l) return;
+      for (let i = 0; i < l.tiles.length; i++) _store(l, i, tile);
+    },
+
+    setAnimation(tile: number, frames: number[], durations: number | number[]): void {
+      if (tile < 1 || tile > tileCount || frames.length === 0) return;
+      const ends: number[] = [];
+      let total = 0;
+      for (let i = 0; i < frames.length; i++) {
+        const d = typeof durations === "number" ? durations : (durations[i] ?? durations[durations.length - 1] ?? 0);
+        total += Math.max(0, d);
+        ends.push(total);
+      }
+      const valid = frames.map((f) => (f >= 1 && f <= tileCount ? Math.floor(f) : tile));
+      const had = _animations.has(tile);
+      _animations.set(tile, { frames: valid, ends, total });
+      // Chunks only track tiles that were animated when they were built
+      if (!had) for (const l of _layers) for (const chunk of l.chunks) if (chunk.batch) chunk.dirty = true;
+      _applyFrames();
+    },
+
+    clearAnimation(tile: number): void {
+      if (!_animations.delete(tile)) return;
+      _frame[tile] = tile;
+      _animVersion++;
+    },
+
+    update(dt: number): void {
+      if (_animations.size === 0) return;
+      _clock += dt;
+      _applyFrames();
+    },
+
+    setLayerVisible(layer: number, visible: boolean): void {
+      const l = _layer(layer);
+      if (l) l.visible = visible;
+    },
+
+    isLayerVisible(layer: number): boolean {
+      return _layer(layer)?.visible ?? false;
+    },
+
+    getLayerCount(): number {
+      return _layers.length;
+    },
+
+    getDimensions(): [number, number] {
+      return [mapW, mapH];
+    },
+
+    getTileDimensions(): [number, number] {
+      return [tw, th];
+    },
+
+    getTileCount(): number {
+      return tileCount;
+    },
+
+    setChunkSize(tiles: number): void {
+      const next = Math.max(1, Math.floor(tiles));
+      if (next === _chunkTiles) return;
+      _chunkTiles = next;
+      _layoutChunks();
+    },
+
+    getChunkSize(): number {
+      return _chunkTiles;
+    },
+
+    getImage(): Image {
+      return image;
+    },
+
+    release(): void {
+      _layers.length = 0;
+      _animations.clear();
+    },
+
+    _getChunkInfo() {
+      let chunks = 0;
+      for (const l of _layers) for (const chunk of l.chunks) if (chunk.batch) chunks++;
+      return { chunks, rebuilds: _rebuilds };
+    },
+
+    _getChunkVertices(layer: number, x: number, y: number): Float32Array | null {
+      const l = _layer(layer);
+      if (!l || x < 0 || y < 0 || x >= mapW || y >= mapH) return null;
+      const batch = _chunkAt(l, Math.floor(x), Math.floor(y)).batch;
+      return batch ? (batch as any)._getBuffers().vertexData : null;
+    },
+
+    _draw(x: number, y: number, r: number, sx: number, sy: number, ox: number, oy: number): void {
+      const chunkW = _chunkTiles * tw, chunkH = _chunkTiles * th;
+      for (const layer of _layers) {
+        if (!layer.visible) continue;
+        for (let ci = 0; ci < layer.chunks.length; ci++) {
+          const chunk = layer.chunks[ci]!;
+          if (chunk.count === 0) {
+            if (chunk.dirty && chunk.batch) _rebuild(layer, ci); // emptied — drop its sprites
+            continue;
+          }
+          const x0 = (ci % _chunksX) * chunkW, y0 = Math.floor(ci / _chunksX) * chunkH;
+          if (_cullBox(x0, y0, x0 + chunkW, y0 + chunkH, x, y, r, sx, sy, ox, oy)) {
+            _statCull(chunk.count);
+            continue;
+          }
+          if (chunk.dirty) _rebuild(layer, ci);
+          if (!chunk.batch || chunk.batch.getCount() === 0) continue;
+          if (chunk.animated.length > 0 && chunk.animVersion !== _animVersion) _patchAnimated(chunk);
+          _drawSpriteBatch(chunk.batch, x, y, r, sx, sy, ox, oy);
+        }
+      }
+    },
+  };
+
+  for (let i = 0; i < Math.max(1, Math.floor(layers)); i++) {
+    _layers.push({ tiles: new Uint32Array(mapW * mapH), chunks: [], visible: true });
+  }
+  _layoutChunks();
+  return tilemap;
+}
+
+/** Draw every visible layer of a tilemap with a draw transform and the global transform. */
+export function _drawTilemap(
+  tilemap: Tilemap,
+  x: number, y: number, r: number,
+  sx: number, sy: number,
+  ox: number, oy: number,
+): void {
+  (tilemap as any)._draw(x, y, r, sx, sy, ox, oy);
+}
@@ -5,6 +5,8 @@ import { ptr, read, toArrayBuffer } from "bun:ffi";
 import type { Pointer } from "bun:ffi";
 import { resolve } from "path";
 import sdl from "../sdl/ffi.ts";
+import * as rc from "./graphics-commands.ts";
+import type { CommandBufferStats } from "./graphics-commands.ts";
 import { loadTTF } from "../sdl/ffi_ttf.ts";
 import { loadImage } from "../sdl/ffi_image.ts";
 import { _createFont, _createBitmapFont } from "./font.ts";
@@ -51,8 +53,25 @@ import type { Video } from "./video.ts";
 import { newVideo as _newVideoImpl } from "./video.ts";
 import { _drawSpriteBatch, _drawMesh, _drawParticleSystem } from "./graphics-batch.ts";
 import type { SpriteBatch, Mesh } from "./graphics-batch.ts";
+import { _drawTilemap } from "./graphics-tilemap.ts";
+import type { Tilemap } from "./graphics-tilemap.ts";
+import {
+  _layoutText,
+  _drawTextPages,
+  _releaseGlyphAtlas,
+  _releaseGlyphAtlases,
+  _trackTextAtlas,
+  _dropTextAtlas,
+  _getLineSkip,
+  _getSDFShader,
+  _openSDFFont,
+} from "./graphics-text.ts";
+import type { TextSegment, TextPage, TextAtlasRef } from "./graphics-text.ts";
 export { newSpriteBatch, newMesh, _drawSpriteBatch, _drawMesh, _drawParticleSystem } from "./graphics-batch.ts";
-export type { SpriteBatch, Mesh, MeshDrawMode } from "./graphics-batch.ts";
+export type { SpriteBatch, Mesh, MeshDrawMode, MeshUsage, VertexAttribute } from "./graphics-batch.ts";
+export { newTilemap } from "./graphics-tilemap.ts";
+export type { Tilemap } from "./graphics-tilemap.ts";
+export type { CommandBufferStats } from "./graphics-commands.ts";
 
 export type FilterMode = "nearest" | "linear";
 export type WrapMode = "clamp" | "repeat" | "mirroredrepeat" | "clampzero";
@@ -145,7 +164,7 @@ function _recomputeBlendMode(): void {
 
   // Apply to renderer
   if (_renderer) {
-    sdl.SDL_SetRenderDrawBlendMode(_renderer, _effectiveBlendModeSDL);
+    rc.setRenderDrawBlendMode(_renderer, _effectiveBlendModeSDL);
   }
 }
 
@@ -213,6 +232,11 @@ export function _transformPoint(x: number, y: number): [number, number] {
   return [a * x + c * y + tx, b * x + d * y + ty];
 }
 
+/** The current global transform [a, b, c, d, tx, ty] — live, do not mutate. */
+export function _getTransformMatrix(): Readonly<Matrix> {
+  return _transform;
+}
+
 export function _isIdentity(): boolean {
   const [a, b, c, d, tx, ty] = _transform;
   return a === 1 && b === 0 && c === 0 && d === 1 && tx === 0 && ty === 0;
@@ -336,6 +360,7 @@ function _createImageObject(texture: SDLTexture, w: number, h: number): Image {
       _filterMag = mag;
       // Use the mag filter for the SDL scale mode (SDL doesn't distinguish min/mag)
       const mode = mag === "linear" ? SDL_SCALEMODE_LINEAR : SDL_SCALEMODE_NEAREST;
+      rc._flushCommands();
       sdl.SDL_SetTextureScaleMode(texture, mode);
     },
     getFilter() { return [_filterMin, _filterMag]; },
@@ -347,6 +372,8 @@ function _createImageObject(texture: SDLTexture, w: number, h: number): Image {
     replacePixels(imageData: BaseImageData | RichImageData, x?: number, y?: number) {
       const { data, width, height } = imageData;
       const pitch = width * 4;
+      // Recorded draws of this image must see the old pixels
+      rc._flushCommands();
       if (x !== undefined && y !== undefined) {
         const rect = new Int32Array([x, y, width, height]);
         sdl.SDL_UpdateTexture(texture, ptr(rect), ptr(data), pitch);
@@ -355,6 +382,8 @@ function _createImageObject(texture: SDLTexture, w: number, h: number): Image {
       }
     },
     release() {
+      rc._flushCommands();
+      rc._forgetTexture(texture);
       sdl.SDL_DestroyTexture(texture);
     },
   };
@@ -402,7 +431,8 @@ export interface Canvas extends Image {
 
 export interface Text {
   _isText: true;
-  _texture: SDLTexture;
+  /** First glyph page's texture; null when there is nothing to draw */
+  _texture: SDLTexture | null;
   _width: number;
   _height: number;
   set(text: string): void;
@@ -416,17 +446,10 @@ export interface Text {
   getFont(): Font;
   setFont(font: Font): void;
   release(): void;
-  /** @internal — re-render to canvas if dirty */
+  /** @internal — rebuild glyph quads if dirty */
   _flush(): void;
-}
-
-interface TextSegment {
-  text: string;
-  color: [number, number, number, number];
-  x: number;
-  y: number;
-  wrapLimit: number; // 0 = no wrap
-  align: "left" | "center" | "right";
+  /** @internal — draw the glyph quads with a draw transform */
+  _draw(x: number, y: number, r: number, sx: number, sy: number, ox: number, oy: number): void;
 }
 
 let _activeCanvas: Canvas | null = null;
@@ -461,7 +484,16 @@ export function setCanvas(canvas: Canvas | null): void {
   if (!_renderer) return;
   _activeCanvas = canvas;
   _statCanvasSwitches++;
-  sdl.SDL_SetRenderTarget(_renderer, canvas ? canvas._texture : null);
+  // In retained mode "the screen" is the back canvas; with dynamic resolution, the scale canvas
+  rc.setRenderTarget(_renderer, canvas ? canvas._texture : _screenTexture());
+  if (!canvas && _retained) _applyClip();
+}
+
+/** The texture standing in for the window, or null when drawing straight to it. */
+function _screenTexture(): SDLTexture | null {
+  if (_backCanvas) return _backCanvas._texture;
+  if (_scaleCanvas) return _scaleCanvas._texture;
+  return null;
 }
 
 /** Get the active canvas (null = rendering to screen). */
@@ -547,14 +579,14 @@ export function newVideo(path: string, options?: { audio?: boolean }): Video | n
 // ============================================================
 
 /**
- * Draw a drawable (Image, Canvas, SpriteBatch, or ParticleSystem) at the given position with optional transform.
+ * Draw a drawable (Image, Canvas, SpriteBatch, Tilemap, or ParticleSystem) at the given position with optional transform.
  *
  * Overloads:
  * - draw(drawable, x, y, r, sx, sy, ox, oy)
  * - draw(drawable, quad, x, y, r, sx, sy, ox, oy)
  */
 export function draw(
-  drawable: Image | SpriteBatch | ParticleSystem | Mesh | Text | Video,
+  drawable: Image | SpriteBatch | Tilemap | ParticleSystem | Mesh | Text | Video,
   quadOrX?: Quad | number,
   xOrY?: number,
   yOrR?: number,
@@ -566,9 +598,18 @@ export function draw(
 ): void {
   if (!_renderer) return;
 
-  // Text path — flush cached canvas, then fall through to texture drawing
+  // Text path — glyph quads on the font's atlas
   if ("_isText" in drawable) {
-    (drawable as Text)._flush();
+    const x = (quadOrX as number) ?? 0;
+    const y = xOrY ?? 0;
+    const r = yOrR ?? 0;
+    const sx = rOrSx ?? 1;
+    const sy = sxOrSy ?? sx;
+    const ox = syOrOx ?? 0;
+    const oy = oxOrOy ?? 0;
+    _statDrawCalls++;
+    (drawable as Text)._draw(x, y, r, sx, sy, ox, oy);
+    return;
   }
 
   // Mesh path — may be untextured (null _texture is OK)
@@ -589,13 +630,13 @@ export function draw(
 
   // Apply current blend mode to the texture (SDL_RenderGeometry / SDL_RenderTexture
   // use the texture's blend mode, not the renderer's draw blend mode)
-  sdl.SDL_SetTextureBlendMode(drawable._texture, _effectiveBlendModeSDL);
+  rc.setTextureBlendMode(drawable._texture, _effectiveBlendModeSDL);
 
   // Apply wrap mode (SDL3 sets this on the renderer, not per-texture)
   if ("_wrapH" in drawable) {
     const u = (drawable as Image)._wrapH === "repeat" ? SDL_TEXTURE_ADDRESS_WRAP : SDL_TEXTURE_ADDRESS_CLAMP;
     const v = (drawable as Image)._wrapV === "repeat" ? SDL_TEXTURE_ADDRESS_WRAP : SDL_TEXTURE_ADDRESS_CLAMP;
-    sdl.SDL_SetRenderTextureAddressMode(_renderer, u, v);
+    rc.setRenderTextureAddressMode(_renderer, u, v);
   }
 
   // ParticleSystem path — no quad overload, just positional args
@@ -624,6 +665,19 @@ export function draw(
     return;
   }
 
+  // Tilemap path — visible chunks of each layer, no quad overload
+  if ("_isTilemap" in drawable && drawable._isTilemap) {
+    const x = (quadOrX as number) ?? 0;
+    const y = xOrY ?? 0;
+    const r = yOrR ?? 0;
+    const sx = rOrSx ?? 1;
+    const sy = sxOrSy ?? sx;
+    const ox = syOrOx ?? 0;
+    const oy = oxOrOy ?? 0;
+    _drawTilemap(drawable, x, y, r, sx, sy, ox, oy);
+    return;
+  }
+
   let quad: Quad | null = null;
   let x: number, y: number, r: number, sx: number, sy: number, ox: number, oy: number;
 
@@ -661,10 +715,16 @@ export function draw(
     drawH = (drawable as any)._height;
   }
 
+  if (_culling && _cullBox(0, 0, drawW, drawH, x, y, r, sx, sy, ox, oy)) {
+    _statDrawCalls--; // nothing submitted
+    _statCulled++;
+    return;
+  }
+
   // Apply color modulation
   const [cr, cg, cb, ca] = _drawColor;
-  sdl.SDL_SetTextureColorModFloat(drawable._texture, cr / 255, cg / 255, cb / 255);
-  sdl.SDL_SetTextureAlphaModFloat(drawable._texture, ca / 255);
+  rc.setTextureColorModFloat(drawable._texture, cr / 255, cg / 255, cb / 255);
+  rc.setTextureAlphaModFloat(drawable._texture, ca / 255);
 
   // If we have a non-identity transform or rotation/scale, use SDL_RenderGeometry for full control
   if (!_isIdentity() || r !== 0 || sx !== 1 || sy !== 1 || ox !== 0 || oy !== 0) {
@@ -672,11 +732,11 @@ export function draw(
   } else {
     // Simple case: no transform, just blit
     const dstRect = new Float32Array([x, y, drawW, drawH]);
-    sdl.SDL_RenderTexture(
+    rc.renderTexture(
       _renderer,
       drawable._texture,
-      srcRect ? ptr(srcRect) : null,
-      ptr(dstRect),
+      srcRect,
+      dstRect,
     );
   }
 }
@@ -769,10 +829,10 @@ function _drawTexturedQuad(
 
   const indexBuf = new Int32Array([0, 1, 2, 0, 2, 3]);
 
-  sdl.SDL_RenderGeometry(
+  rc.renderGeometry(
     _renderer, texture,
-    ptr(vertBuf), 4,
-    ptr(indexBuf), 6,
+    vertBuf, 4,
+    indexBuf, 6,
   );
 }
 
@@ -825,6 +885,8 @@ export function _createRenderer(): void {
     throw new Error(`SDL_CreateRenderer failed: ${sdl.SDL_GetError()}`);
   }
   sdl.SDL_SetRenderDrawBlendMode(_renderer, SDL_BLENDMODE_BLEND);
+  // Set outside the shadow-state cache: make the next cached setters reach SDL
+  rc._invalidateRenderState();
 
   // Enable vsync by default (matches love2d's default t.window.vsync = 1)
   sdl.SDL_SetRenderVSync(_renderer, 1);
@@ -848,7 +910,8 @@ export function _createRenderer(): void {
         _defaultFontSize,
       ) as Pointer | null;
       if (fontPtr) {
-        _defaultFont = _createFont(fontPtr, _defaultFontSize, _ttf);
+        const font: Font = _createFont(fontPtr, _defaultFontSize, _ttf, () => _releaseGlyphAtlas(font));
+        _defaultFont = font;
         _currentFont = _defaultFont;
       }
     }
@@ -862,6 +925,9 @@ export function _destroyRenderer(): void {
   if (_stencilInvCanvas) { _stencilInvCanvas.release(); _stencilInvCanvas = null; }
   if (_stencilContentCanvas) { _stencilContentCanvas.release(); _stencilContentCanvas = null; }
   _stencilActive = false;
+  _releaseRetained();
+  _releaseDynamic();
+  _frameW = _frameH = 0;
   _stencilCompare = null;
 
   // Clean up active shader
@@ -869,6 +935,7 @@ export function _destroyRenderer(): void {
   _wireframe = false;
 
   // Clean up TTF resources before renderer
+  _releaseGlyphAtlases();
   if (_defaultFont) {
     _defaultFont.release();
     _defaultFont = null;
@@ -882,6 +949,7 @@ export function _destroyRenderer(): void {
     _ttf.TTF_Quit();
     _ttf = null;
   }
+  rc._resetCommands();
   if (_renderer) {
     sdl.SDL_DestroyRenderer(_renderer);
     _renderer = null;
@@ -900,21 +968,36 @@ export function _destroyRenderer(): void {
   _effectiveBlendModeSDL = SDL_BLENDMODE_BLEND;
 }
 
-/** Begin a frame: clear with background color. */
+/** Begin a frame: clear with background color (retained mode: target the back canvas instead). */
 export function _beginFrame(): void {
   if (!_renderer) return;
   _statReset();
+  _sampleFrameSize();
+  rc._beginCommandFrame();
+  if (_retained) {
+    _beginRetainedFrame();
+    return;
+  }
+  if (_dynamic) _beginDynamicFrame();
   const [br, bg, bb, ba] = _bgColor;
-  sdl.SDL_SetRenderDrawColor(_renderer, br, bg, bb, ba);
-  sdl.SDL_RenderClear(_renderer);
+  rc.setRenderDrawColor(_renderer, br, bg, bb, ba);
+  rc.renderClear(_renderer);
   // Restore draw color
   const [dr, dg, db, da] = _drawColor;
-  sdl.SDL_SetRenderDrawColor(_renderer, dr, dg, db, da);
+  rc.setRenderDrawColor(_renderer, dr, dg, db, da);
 }
 
-/** End a frame: flush captures, present. */
+/** End a frame: submit recorded commands, flush captures, present. */
 export function _endFrame(): void {
   if (!_renderer) return;
+  if (_retained && !_endRetainedFrame()) {
+    // Nothing changed — the last presented frame is still on screen
+    rc._endCommandFrame();
+    return;
+  }
+  if (_dynamic) _endDynamicFrame();
+  rc._endCommandFrame();
+  if (_dynamic) _measureDynamicFrame();
   _flushCaptures();
   sdl.SDL_RenderPresent(_renderer);
 }
@@ -924,6 +1007,16 @@ export function _getRenderer(): SDLRenderer | null {
   return _renderer;
 }
 
+/** Get the SDL_ttf symbols, or null without SDL_ttf (for graphics-text module). */
+export function _getTTF(): ReturnType<typeof loadTTF> {
+  return _ttf;
+}
+
+/** Get the renderer text engine (for graphics-text module). */
+export function _getTTFEngine(): Pointer | null {
+  return _ttfEngine;
+}
+
 /** Get the current draw color (for graphics-batch module). */
 export function _getDrawColor(): [number, number, number, number] {
   return _drawColor;
@@ -958,7 +1051,7 @@ export function setColor(r: number, g: number, b: number, a: number = 255): void
     _colorMask[3] ? a : 0,
   ];
   if (_renderer) {
-    sdl.SDL_SetRenderDrawColor(_renderer, _drawColor[0], _drawColor[1], _drawColor[2], _drawColor[3]);
+    rc.setRenderDrawColor(_renderer, _drawColor[0], _drawColor[1], _drawColor[2], _drawColor[3]);
   }
 }
 
@@ -991,18 +1084,38 @@ export function setScissor(x?: number, y?: number, w?: number, h?: number): void
   if (!_renderer) return;
   if (x === undefined) {
     // Disable scissor
-    sdl.SDL_SetRenderClipRect(_renderer, null);
     _scissorEnabled = false;
     _scissor = null;
   } else {
-    _scissorBuf[0] = x!;
-    _scissorBuf[1] = y!;
-    _scissorBuf[2] = w!;
-    _scissorBuf[3] = h!;
-    sdl.SDL_SetRenderClipRect(_renderer, ptr(_scissorBuf));
     _scissorEnabled = true;
     _scissor = [x!, y!, w!, h!];
   }
+  _applyClip();
+}
+
+/** Push the clip rect: the scissor, intersected with the retained-mode region being redrawn. */
+function _applyClip(): void {
+  const region = _activeCanvas ? null : _region;
+  const s = _scissor;
+  if (!s && !region) {
+    rc.setRenderClipRect(_renderer, null);
+    return;
+  }
+  if (s && region) {
+    const x0 = Math.max(s[0], region[0]);
+    const y0 = Math.max(s[1], region[1]);
+    _scissorBuf[0] = x0;
+    _scissorBuf[1] = y0;
+    _scissorBuf[2] = Math.max(0, Math.min(s[0] + s[2], region[0] + region[2]) - x0);
+    _scissorBuf[3] = Math.max(0, Math.min(s[1] + s[3], region[1] + region[3]) - y0);
+  } else {
+    const r = (s ?? region)!;
+    _scissorBuf[0] = r[0];
+    _scissorBuf[1] = r[1];
+    _scissorBuf[2] = r[2];
+    _scissorBuf[3] = r[3];
+  }
+  rc.setRenderClipRect(_renderer, _scissorBuf);
 }
 
 /** Get the current scissor rectangle, or null if not set. */
@@ -1065,8 +1178,8 @@ function _prepareInvertedStencil(): Canvas | null {
   // Draw transparent holes on white background
   setCanvas(_stencilInvCanvas);
   if (!_stencilPendingKeep) {
-    sdl.SDL_SetRenderDrawColor(_renderer, 255, 255, 255, 255);
-    sdl.SDL_RenderClear(_renderer);
+    rc.setRenderDrawColor(_renderer, 255, 255, 255, 255);
+    rc.renderClear(_renderer);
   }
   setColor(0, 0, 0, 0);
   setBlendMode("replace");
@@ -1105,8 +1218,8 @@ export function stencil(
     // Draw white shapes on transparent background to stencil canvas
     setCanvas(_stencilCanvas);
     if (!keepvalues) {
-      sdl.SDL_SetRenderDrawColor(_renderer, 0, 0, 0, 0);
-      sdl.SDL_RenderClear(_renderer);
+      rc.setRenderDrawColor(_renderer, 0, 0, 0, 0);
+      rc.renderClear(_renderer);
     }
     setColor(255, 255, 255, 255);
     setBlendMode("replace");
@@ -1150,8 +1263,8 @@ export function setStencilTest(comparemode?: CompareMode, comparevalue?: number)
       } else if (_stencilCompare === "always") {
         // Everything passes — draw content directly to original target
         setCanvas(_stencilOrigCanvas);
-        sdl.SDL_SetTextureBlendMode(_stencilContentCanvas._texture, SDL_BLENDMODE_BLEND);
-        sdl.SDL_RenderTexture(_renderer, _stencilContentCanvas._texture, null, null);
+        rc.setTextureBlendMode(_stencilContentCanvas._texture, SDL_BLENDMODE_BLEND);
+        rc.renderTexture(_renderer, _stencilContentCanvas._texture, null, null);
       } else {
         // Pick the right mask canvas (normal or inverted)
         let maskCanvas: Canvas | null;
@@ -1165,13 +1278,13 @@ export function setStencilTest(comparemode?: CompareMode, comparevalue?: number)
           // Step 1: Draw content onto mask canvas with MOD blend
           // MOD: result_rgb = content_rgb * mask_rgb, result_alpha = mask_alpha
           setCanvas(maskCanvas);
-          sdl.SDL_SetTextureBlendMode(_stencilContentCanvas._texture, SDL_BLENDMODE_MOD);
-          sdl.SDL_RenderTexture(_renderer, _stencilContentCanvas._texture, null, null);
+          rc.setTextureBlendMode(_stencilContentCanvas._texture, SDL_BLENDMODE_MOD);
+          rc.renderTexture(_renderer, _stencilContentCanvas._texture, null, null);
 
           // Step 2: Draw masked result to original target
           setCanvas(_stencilOrigCanvas);
-          sdl.SDL_SetTextureBlendMode(maskCanvas._texture, SDL_BLENDMODE_BLEND);
-          sdl.SDL_RenderTexture(_renderer, maskCanvas._texture, null, null);
+          rc.setTextureBlendMode(maskCanvas._texture, SDL_BLENDMODE_BLEND);
+          rc.renderTexture(_renderer, maskCanvas._texture, null, null);
         }
       }
     }
@@ -1183,8 +1296,8 @@ export function setStencilTest(comparemode?: CompareMode, comparevalue?: number)
 
     // Restore draw state
     const [dr, dg, db, da] = _drawColor;
-    sdl.SDL_SetRenderDrawColor(_renderer, dr, dg, db, da);
-    sdl.SDL_SetRenderDrawBlendMode(_renderer, _effectiveBlendModeSDL);
+    rc.setRenderDrawColor(_renderer, dr, dg, db, da);
+    rc.setRenderDrawBlendMode(_renderer, _effectiveBlendModeSDL);
     return;
   }
 
@@ -1199,13 +1312,13 @@ export function setStencilTest(comparemode?: CompareMode, comparevalue?: number)
   if (_stencilContentCanvas) {
     // Redirect rendering to content canvas
     setCanvas(_stencilContentCanvas);
-    sdl.SDL_SetRenderDrawColor(_renderer, 0, 0, 0, 0);
-    sdl.SDL_RenderClear(_renderer);
+    rc.setRenderDrawColor(_renderer, 0, 0, 0, 0);
+    rc.renderClear(_renderer);
 
     // Restore draw color/blend for user drawing
     const [dr, dg, db, da] = _drawColor;
-    sdl.SDL_SetRenderDrawColor(_renderer, dr, dg, db, da);
-    sdl.SDL_SetRenderDrawBlendMode(_renderer, _effectiveBlendModeSDL);
+    rc.setRenderDrawColor(_renderer, dr, dg, db, da);
+    rc.setRenderDrawBlendMode(_renderer, _effectiveBlendModeSDL);
   }
 }
 
@@ -1331,7 +1444,7 @@ export function setColorMask(r?: boolean, g?: boolean, b?: boolean, a?: boolean)
     _colorMask[3] ? la : 0,
   ];
   if (_renderer) {
-    sdl.SDL_SetRenderDrawColor(_renderer, _drawColor[0], _drawColor[1], _drawColor[2], _drawColor[3]);
+    rc.setRenderDrawColor(_renderer, _drawColor[0], _drawColor[1], _drawColor[2], _drawColor[3]);
   }
 }
 
@@ -1395,14 +1508,14 @@ export function reset(): void {
   _logicalDrawColor = [255, 255, 255, 255];
   _drawColor = [255, 255, 255, 255];
   if (_renderer) {
-    sdl.SDL_SetRenderDrawColor(_renderer, 255, 255, 255, 255);
+    rc.setRenderDrawColor(_renderer, 255, 255, 255, 255);
   }
   _colorMask = [true, true, true, true];
   _blendMode = "alpha";
   _recomputeBlendMode();
   // Clear active shader
   if (_activeShader && _renderer) {
-    sdl.SDL_SetGPURenderState(_renderer, null);
+    rc.setGPURenderState(_renderer, null);
   }
   _activeShader = null;
   _lineWidth = 1;
@@ -1438,7 +1551,7 @@ function _wireframeIndexedTriangles(vertBuf: Float32Array, idxBuf: Int32Array, n
     triPts[2] = vertBuf[i1! * 8]!; triPts[3] = vertBuf[i1! * 8 + 1]!;
     triPts[4] = vertBuf[i2! * 8]!; triPts[5] = vertBuf[i2! * 8 + 1]!;
     triPts[6] = vertBuf[i0! * 8]!; triPts[7] = vertBuf[i0! * 8 + 1]!;
-    sdl.SDL_RenderLines(_renderer, ptr(triPts), 4);
+    rc.renderLines(_renderer, triPts, 4);
   }
 }
 
@@ -1571,7 +1684,7 @@ function _smoothLines(points: Float32Array, numPoints: number, loop: boolean): v
   if (_wireframe) {
     _wireframeIndexedTriangles(vertBuf, idxBuf, totalIndices);
   } else {
-    sdl.SDL_RenderGeometry(_renderer, null, ptr(vertBuf), totalVerts, ptr(idxBuf), totalIndices);
+    rc.renderGeometry(_renderer, null, vertBuf, totalVerts, idxBuf, totalIndices);
   }
 }
 
@@ -1659,7 +1772,7 @@ function _smoothLinesPerSegment(points: Float32Array, numPoints: number, loop: b
   if (_wireframe) {
     _wireframeIndexedTriangles(vertBuf, idxBuf, numSegments * 18);
   } else {
-    sdl.SDL_RenderGeometry(_renderer, null, ptr(vertBuf), numSegments * 8, ptr(idxBuf), numSegments * 18);
+    rc.renderGeometry(_renderer, null, vertBuf, numSegments * 8, idxBuf, numSegments * 18);
   }
 
   // Emit bevel fill triangles at interior joints as a separate draw call
@@ -1709,7 +1822,7 @@ function _smoothLinesPerSegment(points: Float32Array, numPoints: number, loop: b
       if (_wireframe) {
         _wireframeIndexedTriangles(bvBuf, biBuf, bi);
       } else {
-        sdl.SDL_RenderGeometry(_renderer, null, ptr(bvBuf), bv / 8, ptr(biBuf), bi);
+        rc.renderGeometry(_renderer, null, bvBuf, bv / 8, biBuf, bi);
       }
     }
   }
@@ -1725,15 +1838,17 @@ export function clear(r: number, g: number, b: number, a?: number): void;
 export function clear(r?: number, g?: number, b?: number, a?: number): void {
   if (!_renderer) return;
   if (r !== undefined) {
-    sdl.SDL_SetRenderDrawColor(_renderer, r, g!, b!, a ?? 255);
+    rc.setRenderDrawColor(_renderer, r, g!, b!, a ?? 255);
   } else {
     const [br, bg, bb, ba] = _bgColor;
-    sdl.SDL_SetRenderDrawColor(_renderer, br, bg, bb, ba);
+    rc.setRenderDrawColor(_renderer, br, bg, bb, ba);
   }
-  sdl.SDL_RenderClear(_renderer);
+  // SDL_RenderClear ignores the clip rect — in retained mode only the region being redrawn may change
+  if (_region && !_activeCanvas) _fillRegion(_region);
+  else rc.renderClear(_renderer);
   // Restore draw color
   const [dr, dg, db, da] = _drawColor;
-  sdl.SDL_SetRenderDrawColor(_renderer, dr, dg, db, da);
+  rc.setRenderDrawColor(_renderer, dr, dg, db, da);
 }
 
 /** Draw a rectangle. */
@@ -1745,14 +1860,14 @@ export function rectangle(mode: "fill" | "line", x: number, y: number, w: number
     if (mode === "fill" && _wireframe) {
       // Wireframe: outline + diagonal (triangulation: TL-TR-BR, TL-BR-BL)
       _rectBuf[0] = x; _rectBuf[1] = y; _rectBuf[2] = w; _rectBuf[3] = h;
-      sdl.SDL_RenderRect(_renderer, ptr(_rectBuf));
-      sdl.SDL_RenderLine(_renderer, x, y, x + w, y + h);
+      rc.renderRect(_renderer, _rectBuf);
+      rc.renderLine(_renderer, x, y, x + w, y + h);
     } else if (mode === "fill") {
       _rectBuf[0] = x;
       _rectBuf[1] = y;
       _rectBuf[2] = w;
       _rectBuf[3] = h;
-      sdl.SDL_RenderFillRect(_renderer, ptr(_rectBuf));
+      rc.renderFillRect(_renderer, _rectBuf);
     } else if (_lineStyle === "smooth") {
       const buf = new Float32Array(8);
       buf[0] = x; buf[1] = y;
@@ -1765,7 +1880,7 @@ export function rectangle(mode: "fill" | "line", x: number, y: number, w: number
       _rectBuf[1] = y;
       _rectBuf[2] = w;
       _rectBuf[3] = h;
-      sdl.SDL_RenderRect(_renderer, ptr(_rectBuf));
+      rc.renderRect(_renderer, _rectBuf);
     }
   } else {
     // Transform the 4 corners
@@ -1810,12 +1925,12 @@ export function line(...coords: number[]): void {
   // Rough path
   if (identity) {
     if (coords.length === 4) {
-      sdl.SDL_RenderLine(_renderer, coords[0]!, coords[1]!, coords[2]!, coords[3]!);
+      rc.renderLine(_renderer, coords[0]!, coords[1]!, coords[2]!, coords[3]!);
       return;
     }
     const buf = new Float32Array(numPoints * 2);
     for (let i = 0; i < coords.length; i++) buf[i] = coords[i]!;
-    sdl.SDL_RenderLines(_renderer, ptr(buf), numPoints);
+    rc.renderLines(_renderer, buf, numPoints);
   } else {
     const buf = new Float32Array(numPoints * 2);
     for (let i = 0; i < numPoints; i++) {
@@ -1824,9 +1939,9 @@ export function line(...coords: number[]): void {
       buf[i * 2 + 1] = ty;
     }
     if (numPoints === 2) {
-      sdl.SDL_RenderLine(_renderer, buf[0]!, buf[1]!, buf[2]!, buf[3]!);
+      rc.renderLine(_renderer, buf[0]!, buf[1]!, buf[2]!, buf[3]!);
     } else {
-      sdl.SDL_RenderLines(_renderer, ptr(buf), numPoints);
+      rc.renderLines(_renderer, buf, numPoints);
     }
   }
 }
@@ -1877,7 +1992,7 @@ export function circle(mode: "fill" | "line", cx: number, cy: number, radius: nu
         buf[i * 2] = tx;
         buf[i * 2 + 1] = ty;
       }
-      sdl.SDL_RenderLines(_renderer, ptr(buf), n + 1);
+      rc.renderLines(_renderer, buf, n + 1);
     }
   } else {
     _fillCircle(cx, cy, radius, n, angleStep);
@@ -1935,7 +2050,7 @@ function _fillCircle(cx: number, cy: number, radius: number, n: number, angleSte
     vertBuf[base + 21] = ca;
   }
 
-  sdl.SDL_RenderGeometry(_renderer!, null, ptr(vertBuf), numVerts, null, 0);
+  rc.renderGeometry(_renderer!, null, vertBuf, numVerts, null, 0);
 }
 
 /** Draw an ellipse. */
@@ -1983,7 +2098,7 @@ export function ellipse(mode: "fill" | "line", cx: number, cy: number, rx: numbe
         buf[i * 2] = tx;
         buf[i * 2 + 1] = ty;
       }
-      sdl.SDL_RenderLines(_renderer, ptr(buf), n + 1);
+      rc.renderLines(_renderer, buf, n + 1);
     }
   } else {
     // Triangle fan from center
@@ -2017,7 +2132,7 @@ export function ellipse(mode: "fill" | "line", cx: number, cy: number, rx: numbe
       vertBuf[base + 18] = cr; vertBuf[base + 19] = cg;
       vertBuf[base + 20] = cb; vertBuf[base + 21] = ca;
     }
-    sdl.SDL_RenderGeometry(_renderer, null, ptr(vertBuf), numVerts, null, 0);
+    rc.renderGeometry(_renderer, null, vertBuf, numVerts, null, 0);
   }
 }
 
@@ -2046,7 +2161,7 @@ export function arc(mode: "fill" | "line", cx: number, cy: number, radius: numbe
       pts[i * 2 + 1] = ty;
     }
     // Arc perimeter (open, not closed loop)
-    sdl.SDL_RenderLines(_renderer!, ptr(pts), wn + 1);
+    rc.renderLines(_renderer!, pts, wn + 1);
     // Radial spokes: zigzag center→P0→center→P1→...
     const spokeBuf = new Float32Array((wn + 1) * 4);
     for (let i = 0; i <= wn; i++) {
@@ -2055,7 +2170,7 @@ export function arc(mode: "fill" | "line", cx: number, cy: number, radius: numbe
       spokeBuf[i * 4 + 2] = pts[i * 2]!;
       spokeBuf[i * 4 + 3] = pts[i * 2 + 1]!;
     }
-    sdl.SDL_RenderLines(_renderer!, ptr(spokeBuf), (wn + 1) * 2);
+    rc.renderLines(_renderer!, spokeBuf, (wn + 1) * 2);
   } else if (mode === "line") {
     if (_lineStyle === "smooth") {
       // Build point array based on arc type
@@ -2114,7 +2229,7 @@ export function arc(mode: "fill" | "line", cx: number, cy: number, radius: numbe
         }
         buf[(n + 2) * 2] = tcx;
         buf[(n + 2) * 2 + 1] = tcy;
-        sdl.SDL_RenderLines(_renderer, ptr(buf), n + 3);
+        rc.renderLines(_renderer, buf, n + 3);
       } else if (type === "closed") {
         const buf = new Float32Array((n + 2) * 2);
         for (let i = 0; i <= n; i++) {
@@ -2127,7 +2242,7 @@ export function arc(mode: "fill" | "line", cx: number, cy: number, radius: numbe
         }
         buf[(n + 1) * 2] = buf[0]!;
         buf[(n + 1) * 2 + 1] = buf[1]!;
-        sdl.SDL_RenderLines(_renderer, ptr(buf), n + 2);
+        rc.renderLines(_renderer, buf, n + 2);
       } else {
         const buf = new Float32Array((n + 1) * 2);
         for (let i = 0; i <= n; i++) {
@@ -2138,7 +2253,7 @@ export function arc(mode: "fill" | "line", cx: number, cy: number, radius: numbe
           buf[i * 2] = tx;
           buf[i * 2 + 1] = ty;
         }
-        sdl.SDL_RenderLines(_renderer, ptr(buf), n + 1);
+        rc.renderLines(_renderer, buf, n + 1);
       }
     }
   } else {
@@ -2172,7 +2287,7 @@ export function arc(mode: "fill" | "line", cx: number, cy: number, radius: numbe
       vertBuf[base + 18] = cr; vertBuf[base + 19] = cg;
       vertBuf[base + 20] = cb; vertBuf[base + 21] = ca;
     }
-    sdl.SDL_RenderGeometry(_renderer, null, ptr(vertBuf), numVerts, null, 0);
+    rc.renderGeometry(_renderer, null, vertBuf, numVerts, null, 0);
   }
 }
 
@@ -2199,7 +2314,7 @@ export function polygon(mode: "fill" | "line", ...vertices: number[]): void {
     closedBuf.set(buf);
     closedBuf[numPoints * 2] = buf[0]!;
     closedBuf[numPoints * 2 + 1] = buf[1]!;
-    sdl.SDL_RenderLines(_renderer, ptr(closedBuf), numPoints + 1);
+    rc.renderLines(_renderer, closedBuf, numPoints + 1);
     // Internal fan spokes from v0 to v2..v(n-2) (v0→v1 and v0→v(n-1) are outline edges)
     if (numPoints > 3) {
       const numSpokes = numPoints - 3;
@@ -2210,7 +2325,7 @@ export function polygon(mode: "fill" | "line", ...vertices: number[]): void {
         spokeBuf[i * 4 + 2] = buf[(i + 2) * 2]!;
         spokeBuf[i * 4 + 3] = buf[(i + 2) * 2 + 1]!;
       }
-      sdl.SDL_RenderLines(_renderer, ptr(spokeBuf), numSpokes * 2);
+      rc.renderLines(_renderer, spokeBuf, numSpokes * 2);
     }
   } else if (mode === "line") {
     const buf = new Float32Array(numPoints * 2);
@@ -2229,7 +2344,7 @@ export function polygon(mode: "fill" | "line", ...vertices: number[]): void {
       closedBuf.set(buf);
       closedBuf[numPoints * 2] = buf[0]!;
       closedBuf[numPoints * 2 + 1] = buf[1]!;
-      sdl.SDL_RenderLines(_renderer, ptr(closedBuf), numPoints + 1);
+      rc.renderLines(_renderer, closedBuf, numPoints + 1);
     }
   } else {
     // Triangle fan from first vertex
@@ -2262,7 +2377,7 @@ export function polygon(mode: "fill" | "line", ...vertices: number[]): void {
       vertBuf[base + 18] = cr; vertBuf[base + 19] = cg;
       vertBuf[base + 20] = cb; vertBuf[base + 21] = ca;
     }
-    sdl.SDL_RenderGeometry(_renderer, null, ptr(vertBuf), numVerts, null, 0);
+    rc.renderGeometry(_renderer, null, vertBuf, numVerts, null, 0);
   }
 }
 
@@ -2270,7 +2385,7 @@ export function polygon(mode: "fill" | "line", ...vertices: number[]): void {
 export function point(x: number, y: number): void {
   if (!_renderer) return;
   const [tx, ty] = _isIdentity() ? [x, y] : _transformPoint(x, y);
-  sdl.SDL_RenderPoint(_renderer, tx, ty);
+  rc.renderPoint(_renderer, tx, ty);
 }
 
 /** Draw multiple points with optional per-point colors. */
@@ -2282,7 +2397,7 @@ export function points(...coords: number[]): void {
     const [tx, ty] = identity
       ? [coords[i]!, coords[i + 1]!]
       : _transformPoint(coords[i]!, coords[i + 1]!);
-    sdl.SDL_RenderPoint(_renderer, tx, ty);
+    rc.renderPoint(_renderer, tx, ty);
   }
 }
 
@@ -2291,7 +2406,9 @@ export function print(text: string, x: number, y: number): void {
   if (!_renderer) return;
   _statDrawCalls++;
 
-  if (_currentFont?._isBitmapFont) {
+  if (_currentFont?._sdf) {
+    _printSDF(String(text), x, y, 0, "left");
+  } else if (_currentFont?._isBitmapFont) {
     _printBitmapFont(String(text), x, y);
   } else if (_ttf && _ttfEngine && _currentFont) {
     _printTTF(String(text), x, y);
@@ -2308,7 +2425,9 @@ export function printf(text: string, x: number, y: number, limit: number, align:
   if (!_renderer) return;
   _statDrawCalls++;
 
-  if (_currentFont?._isBitmapFont) {
+  if (_currentFont?._sdf) {
+    _printSDF(String(text), x, y, limit, align);
+  } else if (_currentFont?._isBitmapFont) {
     _printfBitmapFont(String(text), x, y, limit, align);
   } else if (_ttf && _ttfEngine && _currentFont) {
     _printfTTF(String(text), x, y, limit, align);
@@ -2321,17 +2440,31 @@ export function printf(text: string, x: number, y: number, limit: number, align:
 function _printDebug(text: string, x: number, y: number): void {
   const lines = text.split("\n");
   const lineHeight = 8; // SDL debug font is 8px tall
+  rc._flushCommands(); // debug text can't be recorded — keep it in order with earlier draws
   for (let i = 0; i < lines.length; i++) {
     const [tx, ty] = _isIdentity() ? [x, y + i * lineHeight] : _transformPoint(x, y + i * lineHeight);
     sdl.SDL_RenderDebugText(_renderer!, tx, ty, Buffer.from(lines[i] + "\0"));
   }
 }
 
+/** SDF fonts print through the glyph-quad path (there is no SDL_ttf draw for distance fields). */
+function _printSDF(text: string, x: number, y: number, limit: number, align: "left" | "center" | "right"): void {
+  const font = _currentFont!;
+  const lines = limit > 0 ? font.getWrap(text, limit)[1] : text.split("\n");
+  let w = Math.max(0, limit);
+  if (limit <= 0) for (const line of lines) w = Math.max(w, font.getWidth(line));
+  const h = lines.length * _getLineSkip(font);
+  // White glyphs: _drawTextPages applies the draw color
+  const pages = _layoutText(font, [{ text, color: [255, 255, 255, 255], x: 0, y: 0, wrapLimit: Math.max(0, limit), align }]);
+  _drawTextPages(pages, Math.ceil(w), Math.ceil(h), x, y, 0, 1, 1, 0, 0);
+}
+
 function _printTTF(text: string, x: number, y: number): void {
   const font = _currentFont!;
   const lineSkip = _ttf!.TTF_GetFontLineSkip(font._font);
   const lines = text.split("\n");
   const [dr, dg, db, da] = _drawColor;
+  rc._flushCommands(); // TTF text draws straight to the renderer
 
   for (let i = 0; i < lines.length; i++) {
     const lineText = lines[i]!;
@@ -2355,6 +2488,7 @@ function _printfTTF(text: string, x: number, y: number, limit: number, align: "l
   const [, wrappedLines] = font.getWrap(text, limit);
   const lineSkip = _ttf!.TTF_GetFontLineSkip(font._font);
   const [dr, dg, db, da] = _drawColor;
+  rc._flushCommands();
 
   for (let i = 0; i < wrappedLines.length; i++) {
     const lineText = wrappedLines[i]!;
@@ -2395,8 +2529,8 @@ function _printBitmapFont(text: string, x: number, y: number): void {
 
   // Apply color tint via texture color mod
   const [dr, dg, db, da] = _drawColor;
-  sdl.SDL_SetTextureColorModFloat(texture, dr / 255, dg / 255, db / 255);
-  sdl.SDL_SetTextureAlphaModFloat(texture, da / 255);
+  rc.setTextureColorModFloat(texture, dr / 255, dg / 255, db / 255);
+  rc.setTextureAlphaModFloat(texture, da / 255);
 
   const srcRect = new Float32Array(4);
   const dstRect = new Float32Array(4);
@@ -2425,7 +2559,7 @@ function _printBitmapFont(text: string, x: number, y: number): void {
       dstRect[2] = glyph.w;
       dstRect[3] = glyphH;
 
-      sdl.SDL_RenderTexture(_renderer!, texture, ptr(srcRect), ptr(dstRect));
+      rc.renderTexture(_renderer!, texture, srcRect, dstRect);
       xOff += glyph.w + spacing;
     }
   }
@@ -2441,8 +2575,8 @@ function _printfBitmapFont(text: string, x: number, y: number, limit: number, al
   const [, wrappedLines] = font.getWrap(text, limit);
 
   const [dr, dg, db, da] = _drawColor;
-  sdl.SDL_SetTextureColorModFloat(texture, dr / 255, dg / 255, db / 255);
-  sdl.SDL_SetTextureAlphaModFloat(texture, da / 255);
+  rc.setTextureColorModFloat(texture, dr / 255, dg / 255, db / 255);
+  rc.setTextureAlphaModFloat(texture, da / 255);
 
   const srcRect = new Float32Array(4);
   const dstRect = new Float32Array(4);
@@ -2479,7 +2613,7 @@ function _printfBitmapFont(text: string, x: number, y: number, limit: number, al
       dstRect[2] = glyph.w;
       dstRect[3] = glyphH;
 
-      sdl.SDL_RenderTexture(_renderer!, texture, ptr(srcRect), ptr(dstRect));
+      rc.renderTexture(_renderer!, texture, srcRect, dstRect);
       xOff += glyph.w + spacing;
     }
   }
@@ -2516,7 +2650,38 @@ export function newFont(pathOrSize?: string | number, size?: number): Font | nul
   ) as Pointer | null;
   if (!fontPtr) return null;
 
-  return _createFont(fontPtr, fontSize, _ttf);
+  const font: Font = _createFont(fontPtr, fontSize, _ttf, () => _releaseGlyphAtlas(font));
+  return font;
+}
+
+export interface SDFFontOptions {
+  /** Pixel size the distance fields are rasterized at (default 48). */
+  rasterSize?: number;
+  /** Characters to rasterize at load (default printable ASCII); others are added on first use. */
+  preload?: string;
+}
+
+const SDF_PRELOAD = Array.from({ length: 95 }, (_, i) => String.fromCharCode(32 + i)).join("");
+
+/**
+ * Create a signed-distance-field font (jove2d extension). Glyphs are rasterized once as
+ * distance fields into an atlas shared by every size of the same file, and drawn through
+ * a shader that keeps edges sharp at any size, scale or zoom — no re-rasterization.
+ * Works with print, printf and newText like any Font.
+ *
+ * Returns null if the GPU renderer (or a shader compiler) is unavailable. Async because
+ * the SDF shader is compiled on first use.
+ */
+export async function newSDFFont(path?: string, size?: number, options: SDFFontOptions = {}): Promise<Font | null> {
+  if (!_renderer || !_gpuDevice || !_ttf || !_ttfEngine) return null;
+  const shader = await _getSDFShader(_renderer, _gpuDevice);
+  if (!shader || !_renderer) return null;
+  return _openSDFFont(
+    path ?? _defaultFontPath,
+    size ?? _defaultFontSize,
+    Math.max(8, Math.round(options.rasterSize ?? 48)),
+    options.preload ?? SDF_PRELOAD,
+  );
 }
 
 /**
@@ -2607,7 +2772,11 @@ export function newImageFont(
 
   return _createBitmapFont(
     texture, width, height, glyphMap, height, extraSpacing,
-    () => sdl.SDL_DestroyTexture(texture),
+    () => {
+      rc._flushCommands();
+      rc._forgetTexture(texture);
+      sdl.SDL_DestroyTexture(texture);
+    },
   );
 }
 
@@ -2622,8 +2791,9 @@ export function getFont(): Font | null {
 }
 
 /**
- * Create a cached Text object. Renders text to an internal Canvas so
- * subsequent draw() calls are cheap and support full transforms.
+ * Create a cached Text object. Text is laid out once into glyph quads on the font's
+ * shared atlas, so draw() calls are cheap, support full transforms, and consecutive
+ * Text draws on one atlas page are submitted together.
  */
 export function newText(font: Font, text?: string): Text | null {
   if (!_renderer) return null;
@@ -2633,7 +2803,9 @@ export function newText(font: Font, text?: string): Text | null {
   let _font = font;
   let _segments: TextSegment[] = [];
   let _dirty = true;
-  let _canvas: Canvas | null = null;
+  let _pages: TextPage[] = [];
+  // Keeps the atlas pages alive while _pages draws from them, even past font.release()
+  const _atlasRef: TextAtlasRef = { atlas: null };
   let _w = 0;
   let _h = 0;
 
@@ -2650,9 +2822,7 @@ export function newText(font: Font, text?: string): Text | null {
 
   function _computeBounds(): { width: number; height: number } {
     if (_segments.length === 0) return { width: 0, height: 0 };
-    const lineSkip = _font._isBitmapFont
-      ? Math.round(_font._glyphHeight! * _font.getLineHeight())
-      : _ttf!.TTF_GetFontLineSkip(_font._font);
+    const lineSkip = _getLineSkip(_font);
     let maxRight = 0;
     let maxBottom = 0;
 
@@ -2693,68 +2863,18 @@ export function newText(font: Font, text?: string): Text | null {
     const bounds = _computeBounds();
     _w = bounds.width;
     _h = bounds.height;
-
-    if (_w <= 0 || _h <= 0 || _segments.length === 0) {
-      if (_canvas) { _canvas.release(); _canvas = null; }
-      _w = 0;
-      _h = 0;
-      return;
-    }
-
-    // Create or resize canvas
-    if (_canvas && (_canvas._width !== _w || _canvas._height !== _h)) {
-      _canvas.release();
-      _canvas = null;
-    }
-    if (!_canvas) {
-      _canvas = newCanvas(_w, _h);
-      if (!_canvas) return;
-      _canvas.setFilter("linear", "linear");
-    }
-
-    // Save state
-    const savedCanvas = _activeCanvas;
-    const savedColor = [..._drawColor] as [number, number, number, number];
-    const savedFont = _currentFont;
-    const savedBlend = _blendMode;
-    const savedTransform = _transform;
-
-    // Set up for canvas rendering
-    _transform = [1, 0, 0, 1, 0, 0];
-    setCanvas(_canvas);
-    sdl.SDL_SetRenderDrawColor(_renderer!, 0, 0, 0, 0);
-    sdl.SDL_RenderClear(_renderer!);
-    setBlendMode("alpha");
-    _currentFont = _font;
-
-    for (const seg of _segments) {
-      setColor(seg.color[0], seg.color[1], seg.color[2], seg.color[3]);
-      if (seg.wrapLimit > 0) {
-        if (_font._isBitmapFont) {
-          _printfBitmapFont(seg.text, seg.x, seg.y, seg.wrapLimit, seg.align);
-        } else {
-          _printfTTF(seg.text, seg.x, seg.y, seg.wrapLimit, seg.align);
-        }
-      } else {
-        if (_font._isBitmapFont) {
-          _printBitmapFont(seg.text, seg.x, seg.y);
-        } else {
-          _printTTF(seg.text, seg.x, seg.y);
-        }
-      }
+    // Only the quad list is rebuilt — glyphs come from the font's shared atlas
+    if (_w > 0 && _h > 0) {
+      _pages = _layoutText(_font, _segments, _atlasRef);
+    } else {
+      _pages = [];
+      _dropTextAtlas(_atlasRef);
     }
-
-    // Restore state
-    _transform = savedTransform;
-    setCanvas(savedCanvas);
-    _currentFont = savedFont;
-    setColor(savedColor[0], savedColor[1], savedColor[2], savedColor[3]);
-    setBlendMode(savedBlend);
   }
 
   const textObj: Text = {
     _isText: true as const,
-    get _texture() { return _canvas?._texture ?? (null as unknown as SDLTexture); },
+    get _texture() { if (_dirty) _flush(); return _pages[0]?.texture ?? null; },
     get _width() { if (_dirty) _flush(); return _w; },
     get _height() { if (_dirty) _flush(); return _h; },
 
@@ -2834,13 +2954,20 @@ export function newText(font: Font, text?: string): Text | null {
     },
 
     release() {
-      if (_canvas) { _canvas.release(); _canvas = null; }
+      _pages = [];
       _segments = [];
+      _dropTextAtlas(_atlasRef);
     },
 
     _flush,
+
+    _draw(x: number, y: number, r: number, sx: number, sy: number, ox: number, oy: number): void {
+      if (_dirty) _flush();
+      _drawTextPages(_pages, _w, _h, x, y, r, sx, sy, ox, oy);
+    },
   };
 
+  _trackTextAtlas(textObj, _atlasRef);
   return textObj;
 }
 
@@ -2875,7 +3002,7 @@ export async function newShader(
 export function setShader(shader: Shader | null): void {
   if (!_renderer) return;
   _activeShader = shader;
-  sdl.SDL_SetGPURenderState(_renderer, shader ? shader._state : null);
+  rc.setGPURenderState(_renderer, shader ? shader._state : null);
 }
 
 /** Get the active shader, or null if none. */
@@ -2953,13 +3080,25 @@ export function _statDraw(): void { _statDrawCalls++; }
 /** Increment canvas switch counter (called internally). */
 export function _statCanvasSwitch(): void { _statCanvasSwitches++; }
 /** Reset stats at start of frame (called internally). */
-export function _statReset(): void { _statDrawCalls = 0; _statCanvasSwitches = 0; }
+export function _statReset(): void { _statDrawCalls = 0; _statCanvasSwitches = 0; _statCulled = 0; }
 
-/** Get rendering statistics for the current frame. */
-export function getStats(): { drawcalls: number; canvasswitches: number; texturememory: number; images: number; canvases: number; fonts: number } {
+/**
+ * Get rendering statistics for the current frame. `statechanges` counts render-state calls
+ * made (draw color, blend modes, texture color/alpha mod, address mode) and
+ * `statechangeselided` the ones skipped because the state was already set, and `culled` the
+ * sprites skipped by culling (jove2d extensions).
+ */
+export function getStats(): {
+  drawcalls: number; canvasswitches: number; statechanges: number; statechangeselided: number; culled: number;
+  texturememory: number; images: number; canvases: number; fonts: number;
+} {
+  const [stateChanges, stateElided] = rc._getStateCounts();
   return {
     drawcalls: _statDrawCalls,
     canvasswitches: _statCanvasSwitches,
+    statechanges: stateChanges,
+    statechangeselided: stateElided,
+    culled: _statCulled,
     texturememory: 0, // not tracked
     images: 0, // not tracked
     canvases: 0, // not tracked
@@ -2967,6 +3106,25 @@ export function getStats(): { drawcalls: number; canvasswitches: number; texture
   };
 }
 
+/**
+ * Record draw calls into a command buffer and submit them in one native call per frame
+ * (jove2d extension). Returns false if the render helper library (jove_render) is not
+ * available or there is no renderer yet; drawing then keeps calling SDL directly.
+ */
+export function setCommandBuffering(enable: boolean): boolean {
+  return rc._setCommandBuffering(_renderer, enable);
+}
+
+/** Whether draw calls are being recorded into a command buffer (jove2d extension). */
+export function isCommandBuffering(): boolean {
+  return rc._isCommandBuffering();
+}
+
+/** Command buffer statistics for the last frame (jove2d extension). */
+export function getCommandBufferStats(): CommandBufferStats {
+  return rc._getCommandBufferStats();
+}
+
 /** Check if the graphics module is active (renderer initialized). */
 export function isActive(): boolean {
   return _renderer !== null;
@@ -3070,7 +3228,7 @@ function _wireframeFan(tcx: number, tcy: number, points: Float32Array, n: number
   for (let i = 0; i < n * 2; i++) perimBuf[i] = points[i]!;
   perimBuf[n * 2] = points[0]!;
   perimBuf[n * 2 + 1] = points[1]!;
-  sdl.SDL_RenderLines(_renderer, ptr(perimBuf), n + 1);
+  rc.renderLines(_renderer, perimBuf, n + 1);
   // Radial spokes: zigzag center→P0→center→P1→... (one SDL call)
   const spokeBuf = new Float32Array(n * 4);
   for (let i = 0; i < n; i++) {
@@ -3079,7 +3237,7 @@ function _wireframeFan(tcx: number, tcy: number, points: Float32Array, n: number
     spokeBuf[i * 4 + 2] = points[i * 2]!;
     spokeBuf[i * 4 + 3] = points[i * 2 + 1]!;
   }
-  sdl.SDL_RenderLines(_renderer, ptr(spokeBuf), n * 2);
+  rc.renderLines(_renderer, spokeBuf, n * 2);
 }
 
 function _fillQuad(corners: [number, number][]): void {
@@ -3087,7 +3245,7 @@ function _fillQuad(corners: [number, number][]): void {
   if (_wireframe) {
     // Outline + diagonal (matches triangulation: 0-1-2, 0-2-3)
     _strokePolygon(corners);
-    sdl.SDL_RenderLine(_renderer, corners[0]![0], corners[0]![1], corners[2]![0], corners[2]![1]);
+    rc.renderLine(_renderer, corners[0]![0], corners[0]![1], corners[2]![0], corners[2]![1]);
     return;
   }
   const [dr, dg, db, da] = _drawColor;
@@ -3106,7 +3264,7 @@ function _fillQuad(corners: [number, number][]): void {
     vertBuf[base + 4] = cb;
     vertBuf[base + 5] = ca;
   }
-  sdl.SDL_RenderGeometry(_renderer, null, ptr(vertBuf), 6, null, 0);
+  rc.renderGeometry(_renderer, null, vertBuf, 6, null, 0);
 }
 
 function _strokePolygon(corners: [number, number][]): void {
@@ -3123,7 +3281,7 @@ function _strokePolygon(corners: [number, number][]): void {
     closedBuf.set(buf);
     closedBuf[corners.length * 2] = corners[0]![0];
     closedBuf[corners.length * 2 + 1] = corners[0]![1];
-    sdl.SDL_RenderLines(_renderer, ptr(closedBuf), corners.length + 1);
+    rc.renderLines(_renderer, closedBuf, corners.length + 1);
   }
 }
 
@@ -3207,3 +3365,443 @@ export function _flushCaptures(): void {
 
   sdl.SDL_DestroySurface(surface);
 }
+
+// ============================================================
+// Retained mode (dirty-region rendering) — jove2d extension
+// ============================================================
+
+type Rect = [number, number, number, number];
+
+// Regions kept separate before they are merged into one bounding box
+const MAX_DIRTY_REGIONS = 8;
+
+let _retained = false;
+let _backCanvas: Canvas | null = null;
+let _dirty: Rect[] = [];
+let _regions: Rect[] = [];
+let _region: Rect | null = null;
+let _retainedDrawn = false;
+let _presentRequested = false;
+
+/**
+ * Switch retained (dirty-region) rendering on or off (jove2d extension).
+ *
+ * In retained mode frames are drawn into a persistent back canvas that is not cleared.
+ * The game loop only calls draw() for regions marked with invalidate(), once per region,
+ * with the clip rect limited to that region and the region cleared to the background
+ * color. When nothing is invalidated, draw() is skipped and the frame is not presented.
+ * Returns false if the back canvas could not be created or dynamic resolution is on.
+ */
+export function setRetainedMode(enable: boolean): boolean {
+  if (!enable) {
+    if (!_retained) return true;
+    _releaseRetained();
+    if (_renderer) {
+      rc.setRenderTarget(_renderer, _activeCanvas ? _activeCanvas._texture : null);
+      _applyClip();
+    }
+    return true;
+  }
+  if (_retained) return true;
+  if (_dynamic || !_renderer || !_ensureBackCanvas()) return false;
+  _retained = true;
+  return true;
+}
+
+/** Whether retained (dirty-region) rendering is on. */
+export function isRetainedMode(): boolean {
+  return _retained;
+}
+
+/**
+ * Mark a screen rectangle for redrawing in retained mode. With no arguments the whole
+ * screen is marked. Coordinates are screen pixels (the current transform is not applied).
+ */
+export function invalidate(x?: number, y?: number, w?: number, h?: number): void {
+  if (!_retained) return;
+  const sw = getWidth(), sh = getHeight();
+  if (x === undefined) {
+    _dirty = [[0, 0, sw, sh]];
+    return;
+  }
+  // Clip to the screen, snapped outward to whole pixels
+  const x0 = Math.max(0, Math.floor(x));
+  const y0 = Math.max(0, Math.floor(y!));
+  const x1 = Math.min(sw, Math.ceil(x + w!));
+  const y1 = Math.min(sh, Math.ceil(y! + h!));
+  if (x1 <= x0 || y1 <= y0) return;
+  let rect: Rect = [x0, y0, x1 - x0, y1 - y0];
+
+  // Merge with every region it overlaps or touches, until none do
+  for (let i = 0; i < _dirty.length; ) {
+    const d = _dirty[i]!;
+    if (d[0] <= rect[0] + rect[2] && rect[0] <= d[0] + d[2] && d[1] <= rect[1] + rect[3] && rect[1] <= d[1] + d[3]) {
+      rect = _union(rect, d);
+      _dirty.splice(i, 1);
+      i = 0;
+    } else {
+      i++;
+    }
+  }
+  _dirty.push(rect);
+  if (_dirty.length > MAX_DIRTY_REGIONS) _dirty = [_dirty.reduce(_union)];
+}
+
+/** Regions marked for redrawing since the last drawn frame, as [x, y, w, h]. */
+export function getDirtyRegions(): Rect[] {
+  return _dirty.map((r) => [...r] as Rect);
+}
+
+function _union(a: Rect, b: Rect): Rect {
+  const x0 = Math.min(a[0], b[0]);
+  const y0 = Math.min(a[1], b[1]);
+  return [x0, y0, Math.max(a[0] + a[2], b[0] + b[2]) - x0, Math.max(a[1] + a[3], b[1] + b[3]) - y0];
+}
+
+/** (Re)create the back canvas at the current screen size. Returns false if it can't be created. */
+function _ensureBackCanvas(): boolean {
+  const w = getWidth(), h = getHeight();
+  if (_backCanvas && _backCanvas.getWidth() === w && _backCanvas.getHeight() === h) return true;
+  _backCanvas?.release();
+  _backCanvas = w > 0 && h > 0 ? newCanvas(w, h) : null;
+  if (!_backCanvas) return false;
+  // Start from a clean canvas and redraw everything
+  rc.setRenderTarget(_renderer, _backCanvas._texture);
+  rc.setRenderDrawColor(_renderer, _bgColor[0], _bgColor[1], _bgColor[2], _bgColor[3]);
+  rc.renderClear(_renderer);
+  rc.setRenderDrawColor(_renderer, _drawColor[0], _drawColor[1], _drawColor[2], _drawColor[3]);
+  _dirty = [[0, 0, w, h]];
+  return true;
+}
+
+function _releaseRetained(): void {
+  _retained = false;
+  _region = null;
+  _regions = [];
+  _dirty = [];
+  if (_backCanvas) {
+    _backCanvas.release();
+    _backCanvas = null;
+  }
+}
+
+/** Fill `region` with the current draw color, replacing (not blending with) what's there. */
+function _fillRegion(region: Rect): void {
+  _rectBuf[0] = region[0];
+  _rectBuf[1] = region[1];
+  _rectBuf[2] = region[2];
+  _rectBuf[3] = region[3];
+  rc.setRenderDrawBlendMode(_renderer, SDL_BLENDMODE_NONE);
+  rc.renderFillRect(_renderer, _rectBuf);
+  rc.setRenderDrawBlendMode(_renderer, _effectiveBlendModeSDL);
+}
+
+function _beginRetainedFrame(): void {
+  // No back canvas when the screen has no size (minimized) — nothing to draw into
+  if (!_ensureBackCanvas()) return;
+  _region = null;
+  rc.setRenderTarget(_renderer, _activeCanvas ? _activeCanvas._texture : _backCanvas!._texture);
+  _applyClip();
+}
+
+/**
+ * Number of times the game loop should call draw() this frame: once per dirty region in
+ * retained mode (0 when nothing changed), otherwise 1.
+ */
+export function _prepareDraw(): number {
+  if (!_retained) return 1;
+  if (!_backCanvas) return 0;
+  _regions = _dirty;
+  _dirty = [];
+  return _regions.length;
+}
+
+/** Start draw pass `i`: limit drawing to its region and clear it to the background color. */
+export function _beginDrawPass(i: number): void {
+  if (!_retained || !_renderer) return;
+  const region = _regions[i];
+  if (!region) return;
+  if (_activeCanvas) setCanvas(null);
+  _region = region;
+  _applyClip();
+  rc.setRenderDrawColor(_renderer, _bgColor[0], _bgColor[1], _bgColor[2], _bgColor[3]);
+  _fillRegion(region);
+  rc.setRenderDrawColor(_renderer, _drawColor[0], _drawColor[1], _drawColor[2], _drawColor[3]);
+  _retainedDrawn = true;
+}
+
+/** Force the next retained-mode frame to be presented (window exposed, screenshot). */
+export function _requestPresent(): void {
+  _presentRequested = true;
+}
+
+/** Whether the loop has nothing to redraw — retained mode with no dirty regions. */
+export function _isIdle(): boolean {
+  return _retained && _dirty.length === 0 && !_presentRequested;
+}
+
+/** Composite the back canvas onto the window. Returns false when the frame should not be presented. */
+function _endRetainedFrame(): boolean {
+  _region = null;
+  _regions = [];
+  if (!_backCanvas) return false;
+  if (!_retainedDrawn && !_presentRequested && _pendingCaptures.length === 0) {
+    _applyClip();
+    return false;
+  }
+  _retainedDrawn = false;
+  _presentRequested = false;
+  const tex = _backCanvas._texture;
+  rc.setRenderTarget(_renderer, null);
+  rc.setRenderClipRect(_renderer, null);
+  rc.setTextureBlendMode(tex, SDL_BLENDMODE_NONE);
+  rc.setTextureColorModFloat(tex, 1, 1, 1);
+  rc.setTextureAlphaModFloat(tex, 1);
+  rc.renderTexture(_renderer, tex, null, null);
+  // The target stays on the window for captures and present; _beginRetainedFrame() switches back
+  return true;
+}
+
+// ============================================================
+// Dynamic resolution — jove2d extension
+// ============================================================
+
+// Controller tuning, relative to the target frame time T
+const DYN_DOWN_INTERVAL = 1.1; // frame interval above 1.1T → render smaller
+const DYN_DOWN_WORK = 0.95; // or frame work above 0.95T
+const DYN_UP_WORK = 0.7; // frame work below 0.7T (and on pace) → render larger
+const DYN_UP_INTERVAL = 1.05;
+const DYN_STEP_DOWN = 0.1;
+const DYN_STEP_UP = 0.05;
+const DYN_COOLDOWN_MS = 250; // settle time between changes, so the averages catch up
+const DYN_EMA = 0.1;
+
+export interface DynamicResolutionOptions {
+  /** Smallest render scale (default 0.5). */
+  minScale?: number;
+  /** Largest render scale (default 1). */
+  maxScale?: number;
+  /** Frame rate the controller tries to hold (default 60). */
+  targetFps?: number;
+}
+
+let _dynamic = false;
+let _scaleCanvas: Canvas | null = null;
+let _resScale = 1;
+let _minScale = 0.5;
+let _maxScale = 1;
+let _targetMs = 1000 / 60;
+let _frameBegin = 0;
+let _intervalAvg = 0;
+let _workAvg = 0;
+let _lastScaleChange = 0;
+const _scaleSrc = new Float32Array(4);
+
+/**
+ * Switch dynamic resolution on or off (jove2d extension).
+ *
+ * The screen is drawn into an internal canvas at a fraction of the window size, then
+ * upscaled to the window with linear filtering. The fraction follows the measured frame
+ * time: it drops when frames miss the target rate and climbs back when there is headroom.
+ * Game code keeps drawing in window coordinates. Returns false if the internal canvas
+ * can't be created or retained mode is on.
+ */
+export function setDynamicResolution(enable: boolean, options: DynamicResolutionOptions = {}): boolean {
+  if (!enable) {
+    if (!_dynamic) return true;
+    _releaseDynamic();
+    if (_renderer) {
+      rc.setRenderTarget(_renderer, _activeCanvas ? _activeCanvas._texture : null);
+      _applyClip();
+    }
+    return true;
+  }
+  if (_retained || !_renderer) return false;
+  _minScale = Math.max(0.1, Math.min(1, options.minScale ?? 0.5));
+  _maxScale = Math.max(_minScale, Math.min(1, options.maxScale ?? 1));
+  _targetMs = 1000 / Math.max(1, options.targetFps ?? 60);
+  if (!_dynamic) {
+    if (!_ensureScaleCanvas()) return false;
+    _dynamic = true;
+    _resScale = _maxScale;
+    _frameBegin = 0;
+    _intervalAvg = _targetMs;
+    _workAvg = 0;
+  }
+  _resScale = Math.max(_minScale, Math.min(_maxScale, _resScale));
+  return true;
+}
+
+/** Whether dynamic resolution is on. */
+export function isDynamicResolution(): boolean {
+  return _dynamic;
+}
+
+/** Current render scale (1 = full resolution, always 1 when dynamic resolution is off). */
+export function getResolutionScale(): number {
+  return _dynamic ? _resScale : 1;
+}
+
+/** (Re)create the internal canvas at the full screen size. Returns false if it can't be created. */
+function _ensureScaleCanvas(): boolean {
+  const w = getWidth(), h = getHeight();
+  if (_scaleCanvas && _scaleCanvas.getWidth() === w && _scaleCanvas.getHeight() === h) return true;
+  _scaleCanvas?.release();
+  _scaleCanvas = w > 0 && h > 0 ? newCanvas(w, h) : null;
+  if (!_scaleCanvas) return false;
+  _scaleCanvas.setFilter("linear", "linear");
+  return true;
+}
+
+function _releaseDynamic(): void {
+  _dynamic = false;
+  _resScale = 1;
+  if (_scaleCanvas) {
+    _scaleCanvas.release();
+    _scaleCanvas = null;
+  }
+}
+
+/** Adjust the render scale from the running frame interval and frame work averages. */
+function _updateResolutionScale(now: number): void {
+  if (_frameBegin > 0) {
+    _intervalAvg += (now - _frameBegin - _intervalAvg) * DYN_EMA;
+  }
+  _frameBegin = now;
+  if (now - _lastScaleChange < DYN_COOLDOWN_MS) return;
+  const t = _targetMs;
+  let next = _resScale;
+  if (_intervalAvg > t * DYN_DOWN_INTERVAL || _workAvg > t * DYN_DOWN_WORK) {
+    next = Math.max(_minScale, _resScale - DYN_STEP_DOWN);
+  } else if (_workAvg < t * DYN_UP_WORK && _intervalAvg <= t * DYN_UP_INTERVAL) {
+    next = Math.min(_maxScale, _resScale + DYN_STEP_UP);
+  }
+  if (next !== _resScale) {
+    _resScale = next;
+    _lastScaleChange = now;
+  }
+}
+
+function _beginDynamicFrame(): void {
+  _updateResolutionScale(performance.now());
+  // No canvas when the screen has no size (minimized) — draw straight to the window
+  if (!_ensureScaleCanvas()) return;
+  // Render scale is per target: game coordinates stay full size, pixels land top-left
+  rc.setRenderTarget(_renderer, _scaleCanvas!._texture);
+  rc.setRenderScale(_renderer, _resScale, _resScale);
+  if (_activeCanvas) rc.setRenderTarget(_renderer, _activeCanvas._texture);
+  _applyClip();
+}
+
+/** Upscale the drawn part of the internal canvas onto the window. */
+function _endDynamicFrame(): void {
+  if (!_scaleCanvas) return;
+  const tex = _scaleCanvas._texture;
+  _scaleSrc[0] = 0;
+  _scaleSrc[1] = 0;
+  _scaleSrc[2] = Math.min(_scaleCanvas.getWidth(), Math.ceil(_scaleCanvas.getWidth() * _resScale));
+  _scaleSrc[3] = Math.min(_scaleCanvas.getHeight(), Math.ceil(_scaleCanvas.getHeight() * _resScale));
+  rc.setRenderTarget(_renderer, null);
+  rc.setRenderClipRect(_renderer, null);
+  rc.setTextureBlendMode(tex, SDL_BLENDMODE_NONE);
+  rc.setTextureColorModFloat(tex, 1, 1, 1);
+  rc.setTextureAlphaModFloat(tex, 1);
+  rc.renderTexture(_renderer, tex, _scaleSrc, null);
+}
+
+/** Record this frame's work time (begin → submit, before present). */
+function _measureDynamicFrame(): void {
+  if (_frameBegin > 0) _workAvg += (performance.now() - _frameBegin - _workAvg) * DYN_EMA;
+}
+
+// ============================================================
+// Culling — jove2d extension
+// ============================================================
+
+let _culling = false;
+let _statCulled = 0;
+// Screen size, sampled once per frame so culling tests make no FFI calls
+let _frameW = 0;
+let _frameH = 0;
+
+/**
+ * Skip immediate draws that fall entirely outside the visible area (jove2d extension).
+ *
+ * With culling on, draw() of an image, canvas or particle system first transforms its
+ * bounding box by the draw arguments and the current transform, and draws nothing if the
+ * box misses the render target, the scissor and (in retained mode) the region being
+ * redrawn. Off by default. SpriteBatches cull per chunk instead — see setChunkSize().
+ */
+export function setCulling(enable: boolean): void {
+  _culling = enable;
+}
+
+/** Whether immediate draws are culled against the visible area. */
+export function isCulling(): boolean {
+  return _culling;
+}
+
+/** Count sprites skipped by culling (for graphics-batch module). */
+export function _statCull(n: number): void {
+  _statCulled += n;
+}
+
+/** Sample the screen size for this frame's culling tests. */
+function _sampleFrameSize(): void {
+  _frameW = getWidth();
+  _frameH = getHeight();
+}
+
+/**
+ * Whether the local box (x0, y0)–(x1, y1), placed by the draw transform (origin → scale →
+ * rotate → translate) and then the current transform, misses the visible area.
+ */
+export function _cullBox(
+  x0: number, y0: number, x1: number, y1: number,
+  x: number, y: number, r: number,
+  sx: number, sy: number,
+  ox: number, oy: number,
+): boolean {
+  // Visible area: the target, narrowed by the scissor and retained-mode region
+  let vx0 = 0, vy0 = 0, vx1: number, vy1: number;
+  if (_activeCanvas) {
+    vx1 = _activeCanvas.getWidth();
+    vy1 = _activeCanvas.getHeight();
+  } else {
+    if (_frameW === 0) _sampleFrameSize();
+    vx1 = _frameW;
+    vy1 = _frameH;
+    if (_region) {
+      vx0 = _region[0];
+      vy0 = _region[1];
+      vx1 = Math.min(vx1, _region[0] + _region[2]);
+      vy1 = Math.min(vy1, _region[1] + _region[3]);
+    }
+  }
+  const s = _scissor;
+  if (s) {
+    vx0 = Math.max(vx0, s[0]);
+    vy0 = Math.max(vy0, s[1]);
+    vx1 = Math.min(vx1, s[0] + s[2]);
+    vy1 = Math.min(vy1, s[1] + s[3]);
+  }
+
+  // Screen-space AABB of the four transformed corners
+  const cos = Math.cos(r), sin = Math.sin(r);
+  const [a, b, c, d, tx, ty] = _transform;
+  let minX = Infinity, minY = Infinity, maxX = -Infinity, maxY = -Infinity;
+  for (let i = 0; i < 4; i++) {
+    const lx = ((i === 1 || i === 2) ? x1 : x0) - ox;
+    const ly = (i >= 2 ? y1 : y0) - oy;
+    const scx = lx * sx, scy = ly * sy;
+    const wx = scx * cos - scy * sin + x;
+    const wy = scx * sin + scy * cos + y;
+    const px = a * wx + c * wy + tx;
+    const py = b * wx + d * wy + ty;
+    if (px < minX) minX = px;
+    if (px > maxX) maxX = px;
+    if (py < minY) minY = py;
+    if (py > maxY) maxY = py;
+  }
+  return maxX <= vx0 || minX >= vx1 || maxY <= vy0 || minY >= vy1;
+}
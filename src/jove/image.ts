@@ -138,7 +138,7 @@ function _loadImageData(filepath: string): ImageData | null {
   return _createImageData(data, w, h);
 }
 
-function _createImageData(data: Uint8Array, width: number, height: number): ImageData {
+export function _createImageData(data: Uint8Array, width: number, height: number): ImageData {
   return {
     data,
     width,
@@ -18,25 +18,30 @@ import * as physics from "./physics.ts";
 import * as image from "./image.ts";
 import * as sound from "./sound.ts";
 import * as video from "./video.ts";
+import * as thread from "./thread.ts";
+import * as jobs from "./jobs.ts";
 import { quitShaderc } from "./shader.ts";
 import { pollEvents } from "./event.ts";
-import type { GameCallbacks } from "./types.ts";
+import type { GameCallbacks, JoveEvent } from "./types.ts";
+import { readFileSync, writeFileSync } from "fs";
 
-export { window, graphics, keyboard, mouse, timer, filesystem, math, system, audio, data, event, joystick, physics, image, sound, video };
+export { window, graphics, keyboard, mouse, timer, filesystem, math, system, audio, data, event, joystick, physics, image, sound, video, thread, jobs };
 export type { GameCallbacks, WindowFlags, WindowMode, JoveEvent } from "./types.ts";
 export type { ImageData } from "./image.ts";
 export type { Font } from "./font.ts";
 export type { Cursor } from "./mouse.ts";
 export type { BezierCurve } from "./math.ts";
-export type { SpriteBatch, Mesh, Text } from "./graphics.ts";
+export type { SpriteBatch, Mesh, VertexAttribute, Text, CommandBufferStats, DynamicResolutionOptions, SDFFontOptions, Tilemap } from "./graphics.ts";
 export type { ParticleSystem } from "./particles.ts";
 export type { Shader } from "./shader.ts";
-export type { Source, QueueableSource } from "./audio.ts";
+export type { Source, QueueableSource, FilterSettings, EffectSettings, DeviceOptions, DeviceInfo, SoundBank, SoundBankOptions, SynthSource, Envelope } from "./audio.ts";
 export type { SoundData, Decoder } from "./sound.ts";
 export type { ByteData } from "./data.ts";
 export type { File, FileData } from "./filesystem.ts";
-export type { Joystick } from "./joystick.ts";
+export type { Joystick, JoystickSnapshot } from "./joystick.ts";
 export type { Video } from "./video.ts";
+export type { Thread, Channel } from "./thread.ts";
+export type { Job, JobOptions } from "./jobs.ts";
 export type { World, Body, Fixture, Shape, Joint, Contact, DistanceJoint, RevoluteJoint, PrismaticJoint, WeldJoint, MouseJoint, WheelJoint, MotorJoint } from "./physics.ts";
 
 let _initialized = false;
@@ -67,6 +72,8 @@ export function quit(): void {
   video._quit();
   joystick._quit();
   mouse._destroyCursors();
+  mouse._resetSnapshot();
+  keyboard._resetSnapshot();
   audio._quit();
   quitShaderc();
   graphics._destroyRenderer();
@@ -103,6 +110,11 @@ function _errorLoop(error: unknown): void {
   // Log to console as well
   console.error("\njove2d error:\n" + errMsg);
 
+  // The error screen draws with direct SDL calls, straight to the window
+  graphics.setCommandBuffering(false);
+  graphics.setRetainedMode(false);
+  graphics.setDynamicResolution(false);
+
   // If a custom handler is set, call it and return
   if (_customErrorHandler) {
     _customErrorHandler(error);
@@ -137,10 +149,7 @@ function _errorLoop(error: unknown): void {
 
       // Blue background (love2d style)
       graphics.setBackgroundColor(29, 43, 83, 255);
-      sdl.SDL_SetRenderDrawColor(
-        graphics._getRenderer()!, 29, 43, 83, 255,
-      );
-      sdl.SDL_RenderClear(graphics._getRenderer()!);
+      graphics.clear(29, 43, 83, 255);
 
       // Title
       graphics.setColor(255, 255, 255, 255);
@@ -170,11 +179,36 @@ function _gameLoop(callbacks: GameCallbacks): void {
   let running = true;
 
   while (running && window.isOpen()) {
-    // Step the timer (updates dt, FPS)
-    const dt = timer.step();
-
-    // Poll and dispatch events
-    const events = pollEvents();
+    // Retained mode with nothing to redraw: sleep until the next event (event.setIdleWait)
+    event._waitIfIdle(graphics._isIdle());
+
+    let dt: number;
+    let events: JoveEvent[];
+    const replay = event._playbackFrame();
+    if (replay) {
+      // Input playback: recorded dt and events; live input only gets through to quit
+      dt = timer.step(replay.dt);
+      events = replay.events;
+      for (const ev of pollEvents()) {
+        if (ev.type === "quit" || ev.type === "close") events.push(ev);
+      }
+      keyboard._replaySnapshot(events);
+      mouse._replaySnapshot(events);
+      joystick._replaySnapshot(events);
+    } else {
+      // Step the timer (updates dt, FPS)
+      dt = timer.step();
+
+      // Poll and dispatch events
+      events = pollEvents();
+
+      // Snapshot input once — isDown/getPosition/getAxis/wasPressed read these all frame
+      keyboard._snapshot();
+      mouse._snapshot();
+      joystick._snapshot();
+    }
+    event._recordFrame(dt, events);
+    if (event._takeExposed()) graphics._requestPresent();
     for (const ev of events) {
       try {
         switch (ev.type) {
@@ -299,10 +333,14 @@ function _gameLoop(callbacks: GameCallbacks): void {
     // Update video playback (decode frames, upload pixels, feed audio)
     video._updateVideos(dt);
 
-    // Update and draw
+    // Update and draw — in retained mode, draw runs once per dirty region (possibly not at all)
     try {
       callbacks.update?.(dt);
-      callbacks.draw?.();
+      const passes = graphics._prepareDraw();
+      for (let i = 0; i < passes; i++) {
+        graphics._beginDrawPass(i);
+        callbacks.draw?.();
+      }
     } catch (err) {
       graphics._endFrame();
       _errorLoop(err);
@@ -317,6 +355,36 @@ function _gameLoop(callbacks: GameCallbacks): void {
   }
 }
 
+/**
+ * Environment-driven input capture, so any game can be recorded and replayed as a
+ * benchmark without code changes: JOVE_RECORD=<file> records the session, and
+ * JOVE_PLAYBACK=<file> replays one (quitting at its end) and prints frame timings.
+ */
+function _startInputCapture(): void {
+  const playback = process.env.JOVE_PLAYBACK;
+  if (playback) {
+    event.startPlayback(new Uint8Array(readFileSync(playback)), { quitAtEnd: true });
+  } else if (process.env.JOVE_RECORD) {
+    event.startRecording();
+  }
+}
+
+function _finishInputCapture(): void {
+  const recordPath = process.env.JOVE_RECORD;
+  const log = event.stopRecording();
+  if (log && recordPath) {
+    writeFileSync(recordPath, log);
+    console.log(`jove2d: recorded input to ${recordPath} (${log.length} bytes)`);
+  }
+  if (process.env.JOVE_PLAYBACK) {
+    const s = event.getPlaybackStats();
+    console.log(
+      `jove2d: replayed ${s.frames}/${s.totalFrames} frames in ${s.seconds.toFixed(2)} s — ` +
+        `frame mean ${s.meanFrameMs.toFixed(2)} ms, p95 ${s.p95FrameMs.toFixed(2)} ms, max ${s.maxFrameMs.toFixed(2)} ms`,
+    );
+  }
+}
+
 /**
  * Main game loop — mirrors love.run().
  * Auto-initializes SDL and creates a default 800x600 window if none is open.
@@ -348,6 +416,9 @@ export async function run(callbacks: GameCallbacks): Promise<void> {
   // Initialize physics (lazy — just checks if Box2D lib is available)
   physics._init();
 
+  // Start recording/playback before load() so the RNG state matches
+  _startInputCapture();
+
   // Call load() once (may be async)
   if (callbacks.load) {
     try {
@@ -361,6 +432,7 @@ export async function run(callbacks: GameCallbacks): Promise<void> {
 
   // Run the synchronous game loop (JIT-friendly — no async overhead)
   _gameLoop(callbacks);
+  _finishInputCapture();
 
   // Cleanup
   quit();
@@ -0,0 +1,15 @@
+// jove2d job-pool bootstrap — the entry module of every Worker in the jobs pool
+// Attaches the shared heap, then runs and steals tasks until the pool stops.
+
+import { _attachHeap, _releaseViews } from "./thread.ts";
+import { _workerLoop } from "./jobs.ts";
+
+declare const self: Worker;
+
+self.onmessage = (event: MessageEvent<{ heap: SharedArrayBuffer; pool: number; index: number }>) => {
+  const { heap, pool, index } = event.data;
+  _attachHeap(heap);
+  _workerLoop(pool, index);
+  _releaseViews(); // cached kernel args; finalizers never run once the Worker exits
+  process.exit(0);
+};
@@ -0,0 +1,436 @@
+// jove2d jobs module — a work-stealing job system for data-parallel engine and game work
+// Provides parallelFor with dependency chaining over a fixed pool of Workers
+//
+// The pool has one Worker per logical core minus one; the main thread is the last member
+// and helps while it waits. Every member owns a deque of tasks (a job plus an index range)
+// in the jove.thread shared heap. A member pops its own newest task, splits it in half
+// until it is no larger than the job's grain — pushing the upper halves back — and runs
+// the kernel on what is left. Idle members steal the oldest (largest) task from another
+// member's deque, so work spreads without any central queue. The deques are Chase-Lev
+// deques on Atomics; idle members sleep on the pool's epoch word, bumped on every push.
+//
+// A kernel is a module whose default export is `(start, end, args) => void` and handles
+// the indices [start, end). Each member loads it once with require(), and `args` goes
+// through the jove.thread message encoding, so shared ImageData/SoundData/ByteData are
+// handed to every member without copying.
+
+import { availableParallelism } from "os";
+import { resolve } from "path";
+import {
+  _i32, _alloc, _release, _retain, _payload, _lock, _unlock, _getHeap,
+  _encodeMessage, _readMessage, READ_PEEK, _track, _onDrop,
+} from "./thread.ts";
+
+const KIND_POOL = 16;
+const KIND_DEQUE = 17;
+const KIND_JOB = 18;
+const KIND_EDGE = 19;
+
+const MAX_THREADS = 64;
+
+// Pool payload (Int32 slots)
+const P_EPOCH = 0; // bumped on every push and completion; idle members wait on it
+const P_STOP = 1;
+const P_THREADS = 2; // members, including the main thread
+const P_SERIAL = 3; // last job serial
+const P_SLEEPERS = 4;
+const P_LIVE = 5; // members that haven't left; the last one to leave frees the pool
+const P_DEQUES = 8; // deque block of each member
+const POOL_BYTES = (P_DEQUES + MAX_THREADS) * 4;
+
+// Deque payload (Int32 slots): top, bottom, then a ring of (job, start, end, -) tasks
+const D_TOP = 0;
+const D_BOTTOM = 1;
+const D_SLOTS = 4;
+const DEQUE_CAP = 1024; // power of two; halving keeps a member's deque near log2(count)
+const DEQUE_BYTES = (D_SLOTS + DEQUE_CAP * 4) * 4;
+
+// Job payload (Int32 slots)
+const J_STATE = 0;
+const J_DEPS = 1; // unfinished dependencies (+1 while they are being registered)
+const J_REMAINING = 2; // indices not yet run
+const J_COUNT = 3;
+const J_GRAIN = 4;
+const J_ARGS = 5; // message block: [kernel path, args]
+const J_LOCK = 6;
+const J_EDGES = 7; // first edge to a dependent job
+const J_SERIAL = 8;
+const J_ERROR = 9; // message block of the first kernel error, 0 = none
+const JOB_BYTES = 40;
+
+const STATE_WAITING = 0; // for dependencies
+const STATE_SCHEDULED = 1;
+const STATE_DONE = 2;
+
+// Edge payload (Int32 slots)
+const E_NEXT = 0;
+const E_JOB = 1;
+const EDGE_BYTES = 8;
+
+// Tasks handed to several members: grain defaults to count / (members × this)
+const SPLITS_PER_THREAD = 8;
+
+let _pool = 0; // pool block, 0 until the pool starts
+let _index = 0; // this thread's member index
+let _workers: Worker[] = [];
+let _workerCount = Math.max(0, Math.min(MAX_THREADS - 1, availableParallelism() - 1));
+
+// Task popped or stolen by _findTask
+let _tJob = 0;
+let _tStart = 0;
+let _tEnd = 0;
+
+// Kernel of the last job this thread ran a task of, keyed by job serial
+const _kernels = new Map<string, (start: number, end: number, args: any) => void>();
+let _cacheSerial = 0;
+let _cacheKernel: (start: number, end: number, args: any) => void = () => {};
+let _cacheArgs: unknown = undefined;
+
+_onDrop(KIND_POOL, (block) => {
+  const p = _payload(block) >> 2;
+  for (let i = 0; i < _i32[p + P_THREADS]!; i++) _release(_i32[p + P_DEQUES + i]!);
+});
+
+_onDrop(KIND_JOB, (block) => {
+  const j = _payload(block) >> 2;
+  if (_i32[j + J_ARGS]) _release(_i32[j + J_ARGS]!);
+  if (_i32[j + J_ERROR]) _release(_i32[j + J_ERROR]!);
+});
+
+// ============================================================
+// Pool
+// ============================================================
+
+function _ensurePool(): void {
+  if (_pool) return;
+  _getHeap();
+  const threads = _workerCount + 1;
+  _pool = _alloc(POOL_BYTES, KIND_POOL);
+  const p = _payload(_pool) >> 2;
+  _i32[p + P_THREADS] = threads;
+  _i32[p + P_LIVE] = threads;
+  for (let i = 0; i < threads; i++) _i32[p + P_DEQUES + i] = _alloc(DEQUE_BYTES, KIND_DEQUE);
+  _index = threads - 1;
+  const heap = _getHeap();
+  for (let i = 0; i < _workerCount; i++) {
+    const worker = new Worker(new URL("./jobs-worker.ts", import.meta.url).href);
+    worker.postMessage({ heap, pool: _pool, index: i });
+    worker.unref(); // idle workers don't keep the game process alive
+    _workers.push(worker);
+  }
+}
+
+function _stopPool(): void {
+  if (!_pool) return;
+  const p = _payload(_pool) >> 2;
+  Atomics.store(_i32, p + P_STOP, 1);
+  Atomics.add(_i32, p + P_EPOCH, 1);
+  Atomics.notify(_i32, p + P_EPOCH);
+  _leavePool(_pool);
+  _workers = [];
+  _pool = 0;
+  // Job serials restart with the next pool, so the cached kernel would be taken for its jobs
+  _cacheSerial = 0;
+  _cacheArgs = undefined;
+}
+
+/** Leave a stopping pool; the last member out frees it (workers may still be starting up). */
+function _leavePool(pool: number): void {
+  if (Atomics.sub(_i32, (_payload(pool) >> 2) + P_LIVE, 1) === 1) _release(pool);
+}
+
+/**
+ * Set how many Workers the pool uses besides the main thread (default: logical cores − 1).
+ * 0 runs every job on the main thread inside wait(). Call it while no jobs are running.
+ */
+export function setWorkerCount(count: number): void {
+  const n = Math.max(0, Math.min(MAX_THREADS - 1, Math.floor(count)));
+  if (n === _workerCount) return;
+  _stopPool();
+  _workerCount = n;
+}
+
+/** The number of Workers in the pool, besides the main thread. */
+export function getWorkerCount(): number {
+  return _workerCount;
+}
+
+/** Stop the pool's Workers. The next job starts a new pool. */
+export function shutdown(): void {
+  _stopPool();
+}
+
+// ============================================================
+// Deques
+// ============================================================
+
+function _deque(member: number): number {
+  return _payload(_i32[(_payload(_pool) >> 2) + P_DEQUES + member]!) >> 2;
+}
+
+/** Owner: push a task on the bottom. False if the deque is full. */
+function _push(d: number, job: number, start: number, end: number): boolean {
+  const b = Atomics.load(_i32, d + D_BOTTOM);
+  if (b - Atomics.load(_i32, d + D_TOP) >= DEQUE_CAP) return false;
+  const slot = d + D_SLOTS + (b & (DEQUE_CAP - 1)) * 4;
+  _i32[slot] = job;
+  _i32[slot + 1] = start;
+  _i32[slot + 2] = end;
+  Atomics.store(_i32, d + D_BOTTOM, b + 1);
+  return true;
+}
+
+/** Owner: pop the newest task into _tJob/_tStart/_tEnd. */
+function _pop(d: number): boolean {
+  const b = Atomics.load(_i32, d + D_BOTTOM) - 1;
+  Atomics.store(_i32, d + D_BOTTOM, b);
+  const t = Atomics.load(_i32, d + D_TOP);
+  if (t > b) {
+    Atomics.store(_i32, d + D_BOTTOM, b + 1);
+    return false;
+  }
+  const slot = d + D_SLOTS + (b & (DEQUE_CAP - 1)) * 4;
+  _tJob = _i32[slot]!;
+  _tStart = _i32[slot + 1]!;
+  _tEnd = _i32[slot + 2]!;
+  if (t !== b) return true;
+  // Last task: race any thief for it
+  const won = Atomics.compareExchange(_i32, d + D_TOP, t, t + 1) === t;
+  Atomics.store(_i32, d + D_BOTTOM, b + 1);
+  return won;
+}
+
+/** Thief: take the oldest task into _tJob/_tStart/_tEnd. */
+function _steal(d: number): boolean {
+  const t = Atomics.load(_i32, d + D_TOP);
+  if (t >= Atomics.load(_i32, d + D_BOTTOM)) return false;
+  const slot = d + D_SLOTS + (t & (DEQUE_CAP - 1)) * 4;
+  _tJob = Atomics.load(_i32, slot);
+  _tStart = Atomics.load(_i32, slot + 1);
+  _tEnd = Atomics.load(_i32, slot + 2);
+  return Atomics.compareExchange(_i32, d + D_TOP, t, t + 1) === t;
+}
+
+let _victim = 0;
+
+/** Pop from this thread's deque, else steal from the others round-robin. */
+function _findTask(): boolean {
+  if (_pop(_deque(_index))) return true;
+  const threads = _i32[(_payload(_pool) >> 2) + P_THREADS]!;
+  for (let k = 1; k < threads; k++) {
+    _victim = (_victim + 1) % threads;
+    if (_victim === _index) continue;
+    if (_steal(_deque(_victim))) return true;
+  }
+  return false;
+}
+
+function _hasWork(threads: number): boolean {
+  for (let i = 0; i < threads; i++) {
+    const d = _deque(i);
+    if (Atomics.load(_i32, d + D_TOP) < Atomics.load(_i32, d + D_BOTTOM)) return true;
+  }
+  return false;
+}
+
+function _wake(p: number): void {
+  Atomics.add(_i32, p + P_EPOCH, 1);
+  if (Atomics.load(_i32, p + P_SLEEPERS) > 0) Atomics.notify(_i32, p + P_EPOCH);
+}
+
+/** Sleep until work is pushed or a job completes. `job` ends the sleep early once done. */
+function _sleep(p: number, job: number): void {
+  Atomics.add(_i32, p + P_SLEEPERS, 1);
+  const epoch = Atomics.load(_i32, p + P_EPOCH);
+  const done = job !== 0 && Atomics.load(_i32, (_payload(job) >> 2) + J_STATE) === STATE_DONE;
+  if (!done && !Atomics.load(_i32, p + P_STOP) && !_hasWork(_i32[p + P_THREADS]!)) {
+    Atomics.wait(_i32, p + P_EPOCH, epoch);
+  }
+  Atomics.sub(_i32, p + P_SLEEPERS, 1);
+}
+
+// ============================================================
+// Jobs
+// ============================================================
+
+function _setError(j: number, err: unknown): void {
+  if (Atomics.load(_i32, j + J_ERROR)) return;
+  const msg = _encodeMessage(err instanceof Error ? err.message : String(err));
+  if (Atomics.compareExchange(_i32, j + J_ERROR, 0, msg) !== 0) _release(msg);
+}
+
+function _loadKernel(j: number): void {
+  const serial = _i32[j + J_SERIAL]!;
+  if (serial === _cacheSerial) return;
+  const [path, args] = _readMessage(_i32[j + J_ARGS]!, READ_PEEK) as [string, unknown];
+  let kernel = _kernels.get(path);
+  if (!kernel) {
+    const mod = require(path);
+    if (typeof mod.default !== "function") throw new Error(`${path} has no default export function`);
+    kernel = mod.default as (start: number, end: number, args: any) => void;
+    _kernels.set(path, kernel);
+  }
+  _cacheSerial = serial;
+  _cacheKernel = kernel;
+  _cacheArgs = args;
+}
+
+/** Split the task down to the job's grain, run the kernel on the first part, and account for it. */
+function _runTask(job: number, start: number, end: number): void {
+  const j = _payload(job) >> 2;
+  const grain = _i32[j + J_GRAIN]!;
+  const d = _deque(_index);
+  const p = _payload(_pool) >> 2;
+  while (end - start > grain) {
+    const mid = start + ((end - start) >> 1);
+    if (!_push(d, job, mid, end)) break;
+    _wake(p);
+    end = mid;
+  }
+  try {
+    _loadKernel(j);
+    _cacheKernel(start, end, _cacheArgs);
+  } catch (err) {
+    _setError(j, err);
+  }
+  const n = end - start;
+  if (Atomics.sub(_i32, j + J_REMAINING, n) === n) _complete(job);
+}
+
+function _schedule(job: number): void {
+  const j = _payload(job) >> 2;
+  Atomics.store(_i32, j + J_STATE, STATE_SCHEDULED);
+  const count = _i32[j + J_COUNT]!;
+  if (count === 0) return _complete(job);
+  if (_push(_deque(_index), job, 0, count)) _wake(_payload(_pool) >> 2);
+  else _runTask(job, 0, count); // deque full: run it here
+}
+
+function _complete(job: number): void {
+  const j = _payload(job) >> 2;
+  _lock(_i32, j + J_LOCK);
+  Atomics.store(_i32, j + J_STATE, STATE_DONE);
+  let edge = _i32[j + J_EDGES]!;
+  _i32[j + J_EDGES] = 0;
+  _unlock(_i32, j + J_LOCK);
+  Atomics.notify(_i32, j + J_STATE);
+  _wake(_payload(_pool) >> 2);
+  while (edge !== 0) {
+    const e = _payload(edge) >> 2;
+    const next = _i32[e + E_NEXT]!;
+    const dependent = _i32[e + E_JOB]!;
+    _release(edge);
+    if (Atomics.sub(_i32, (_payload(dependent) >> 2) + J_DEPS, 1) === 1) _schedule(dependent);
+    edge = next;
+  }
+  _release(job); // the reference held while it was in flight
+}
+
+export interface JobOptions {
+  /** Largest index range a single kernel call handles (default: count / (threads × 8)). */
+  grain?: number;
+  /** Jobs that must finish before this one starts. */
+  after?: Job | Job[];
+}
+
+export interface Job {
+  _isJob: true;
+  /** @internal — job block in the shared heap */
+  _block: number;
+  isDone(): boolean;
+  /**
+   * Block until the job has finished, running tasks on this thread meanwhile.
+   * Throws if a kernel call threw.
+   */
+  wait(): void;
+  /** The first error a kernel call threw, or null. */
+  getError(): string | null;
+  /** parallelFor() with this job as a dependency. */
+  then(count: number, kernel: string, args?: unknown, options?: JobOptions): Job;
+}
+
+function _jobView(block: number): Job {
+  const j = _payload(block) >> 2;
+  const job: Job = {
+    _isJob: true as const,
+    _block: block,
+
+    isDone(): boolean {
+      return Atomics.load(_i32, j + J_STATE) === STATE_DONE;
+    },
+
+    wait(): void {
+      const p = _payload(_pool) >> 2;
+      while (Atomics.load(_i32, j + J_STATE) !== STATE_DONE) {
+        if (_findTask()) _runTask(_tJob, _tStart, _tEnd);
+        else _sleep(p, block);
+      }
+      const error = job.getError();
+      if (error !== null) throw new Error(`jove.jobs: kernel failed: ${error}`);
+    },
+
+    getError(): string | null {
+      const msg = Atomics.load(_i32, j + J_ERROR);
+      return msg ? (_readMessage(msg, READ_PEEK) as string) : null;
+    },
+
+    then(count: number, kernel: string, args?: unknown, options: JobOptions = {}): Job {
+      const after = options.after === undefined ? [] : Array.isArray(options.after) ? options.after : [options.after];
+      return parallelFor(count, kernel, args, { ...options, after: [job, ...after] });
+    },
+  };
+  _track(job, block);
+  return job;
+}
+
+/**
+ * Run `kernel` (a module path, relative to the working directory) over the indices
+ * [0, count) on the pool. Its default export is called as `(start, end, args)` for
+ * disjoint ranges covering them, in parallel and in no particular order. Returns at once;
+ * wait() on the job to block until it finishes.
+ */
+export function parallelFor(count: number, kernel: string, args?: unknown, options: JobOptions = {}): Job {
+  _ensurePool();
+  const p = _payload(_pool) >> 2;
+  const n = Math.max(0, Math.floor(count));
+  const block = _alloc(JOB_BYTES, KIND_JOB); // this reference belongs to the returned view
+  const j = _payload(block) >> 2;
+  _i32[j + J_ARGS] = _encodeMessage([resolve(kernel), args]);
+  _i32[j + J_COUNT] = n;
+  _i32[j + J_REMAINING] = n;
+  _i32[j + J_GRAIN] = Math.max(1, Math.floor(options.grain ?? Math.ceil(n / (_i32[p + P_THREADS]! * SPLITS_PER_THREAD))));
+  _i32[j + J_SERIAL] = Atomics.add(_i32, p + P_SERIAL, 1) + 1;
+  _retain(block); // held while in flight, released when it completes
+
+  // The extra dependency keeps it from starting while dependencies are being added
+  const after = options.after === undefined ? [] : Array.isArray(options.after) ? options.after : [options.after];
+  _i32[j + J_DEPS] = after.length + 1;
+  for (const dep of after) {
+    const d = _payload(dep._block) >> 2;
+    _lock(_i32, d + J_LOCK);
+    if (Atomics.load(_i32, d + J_STATE) === STATE_DONE) {
+      Atomics.sub(_i32, j + J_DEPS, 1);
+    } else {
+      const edge = _alloc(EDGE_BYTES, KIND_EDGE);
+      const e = _payload(edge) >> 2;
+      _i32[e + E_JOB] = block;
+      _i32[e + E_NEXT] = _i32[d + J_EDGES]!;
+      _i32[d + J_EDGES] = edge;
+    }
+    _unlock(_i32, d + J_LOCK);
+  }
+  if (Atomics.sub(_i32, j + J_DEPS, 1) === 1) _schedule(block);
+  return _jobView(block);
+}
+
+/** Worker side: run and steal tasks until the pool stops. */
+export function _workerLoop(pool: number, index: number): void {
+  _pool = pool;
+  _index = index;
+  const p = _payload(pool) >> 2;
+  while (!Atomics.load(_i32, p + P_STOP)) {
+    if (_findTask()) _runTask(_tJob, _tStart, _tEnd);
+    else _sleep(p, 0);
+  }
+  _leavePool(pool);
+}
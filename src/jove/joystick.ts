@@ -1,8 +1,9 @@
 // jove2d joystick/gamepad module — mirrors love.joystick
 
-import { ptr, read } from "bun:ffi";
+import { ptr, read, toArrayBuffer } from "bun:ffi";
 import type { Pointer } from "bun:ffi";
 import sdl from "../sdl/ffi.ts";
+import { loadInput } from "../sdl/ffi_input.ts";
 import {
   SDL_INIT_GAMEPAD,
   GAMEPAD_BUTTON_NAMES,
@@ -11,11 +12,12 @@ import {
   GAMEPAD_AXIS_FROM_NAME,
   HAT_DIRECTION_NAMES,
 } from "../sdl/types.ts";
+import type { JoveEvent } from "./types.ts";
 
 export interface Joystick {
-  /** Internal SDL_Joystick pointer */
-  readonly _joystick: Pointer;
-  /** Internal SDL_Gamepad pointer (null if not a gamepad) */
+  /** Internal SDL_Joystick pointer (null for a joystick replayed from an input recording) */
+  readonly _joystick: Pointer | null;
+  /** Internal SDL_Gamepad pointer (null if not a gamepad, or replayed) */
   readonly _gamepad: Pointer | null;
   /** SDL instance ID */
   readonly _instanceId: number;
@@ -44,6 +46,10 @@ export interface Joystick {
   getGamepadAxis(axis: string): number;
   /** Check if one or more gamepad buttons are pressed by name. */
   isGamepadDown(...buttons: string[]): boolean;
+  /** Check if any of the gamepad buttons went down since the previous frame (jove2d extension). */
+  wasGamepadPressed(...buttons: string[]): boolean;
+  /** Check if any of the gamepad buttons went up since the previous frame (jove2d extension). */
+  wasGamepadReleased(...buttons: string[]): boolean;
   /** Set vibration (left/right 0-1, duration in seconds, -1 = infinite). */
   setVibration(left?: number, right?: number, duration?: number): boolean;
   /** Check if vibration is supported. */
@@ -52,8 +58,62 @@ export interface Joystick {
   getDeviceInfo(): [number, number, number];
 }
 
-// Active joystick map: instanceId → Joystick
-const _joysticks = new Map<number, Joystick>();
+/**
+ * Packed state of every open joystick, filled once per frame (jove2d extension).
+ * Slot i holds joysticks[i]; its values start at i × stride in each array. Mapped gamepad
+ * values come first (SDL gamepad axis/button order, zero for plain joysticks), then the
+ * raw joystick axes/buttons. Axes are -1..1, buttons 0/1, hats raw SDL hat values.
+ */
+export interface JoystickSnapshot {
+  readonly joysticks: Joystick[];
+  readonly axes: Float32Array;
+  readonly buttons: Uint8Array;
+  /** Buttons at the previous snapshot, same layout — for edge detection. */
+  readonly previousButtons: Uint8Array;
+  readonly hats: Uint8Array;
+  readonly axisStride: number;
+  readonly buttonStride: number;
+  readonly hatStride: number;
+  /** Offset of the first raw joystick axis within a slot. */
+  readonly gamepadAxes: number;
+  /** Offset of the first raw joystick button within a slot. */
+  readonly gamepadButtons: number;
+}
+
+/**
+ * What an input recording keeps of a joystick, so playback can stand in for the device
+ * on machines that don't have it. id 0 marks a device that failed to open.
+ */
+export interface RecordedJoystick {
+  instanceId: number;
+  id: number;
+  gamepad: boolean;
+  name: string;
+  axes: number;
+  buttons: number;
+  hats: number;
+  vendor: number;
+  product: number;
+  version: number;
+}
+
+// Snapshot layout per slot (see vendor/jove_input). Raw values past these caps are
+// still reachable through the getters, which fall back to SDL.
+const GAMEPAD_AXES = 6; // SDL_GAMEPAD_AXIS_COUNT
+const GAMEPAD_BUTTONS = 26; // SDL_GAMEPAD_BUTTON_COUNT
+const JOYSTICK_AXES = 16;
+const JOYSTICK_BUTTONS = 32;
+const JOYSTICK_HATS = 4;
+const AXIS_STRIDE = GAMEPAD_AXES + JOYSTICK_AXES;
+const BUTTON_STRIDE = GAMEPAD_BUTTONS + JOYSTICK_BUTTONS;
+
+// Open devices: instanceId → Joystick
+const _live = new Map<number, Joystick>();
+
+// Active joystick map — the open devices, or the recorded ones during input playback
+let _joysticks = _live;
+// Recorded devices by instance ID while playing back; null for live input
+let _recorded: Map<number, RecordedJoystick> | null = null;
 
 // Sequential ID counter (love2d assigns incrementing IDs)
 let _nextId = 1;
@@ -64,6 +124,244 @@ const _idMap = new Map<number, number>();
 // Out-param buffer for SDL_GetJoysticks count
 const _countBuf = new Int32Array(1);
 
+// Snapshot storage, grown to the number of open joysticks
+let _capacity = 0;
+let _ids = new Uint32Array(0);
+let _axes = new Float32Array(0);
+let _buttons = new Uint8Array(0);
+let _prevButtons = new Uint8Array(0);
+let _hats = new Uint8Array(0);
+let _slots: Joystick[] = [];
+// Views over jove_input's C-side output buffers, mapped on first poll
+let _native: { axes: Float32Array; buttons: Uint8Array; hats: Uint8Array; max: number } | null = null;
+// instanceId → slot in the snapshot arrays
+let _slotOf = new Map<number, number>();
+let _slotsDirty = true;
+// True once the game loop has taken this session's first snapshot
+let _hasSnapshot = false;
+
+/** Slot of a joystick in the frame snapshot, or -1 to read SDL directly. */
+function _slot(instanceId: number): number {
+  return _hasSnapshot ? (_slotOf.get(instanceId) ?? -1) : -1;
+}
+
+function _normalizeAxis(raw: number): number {
+  // Normalize -32768..32767 to -1..1
+  return raw < 0 ? raw / 32768 : raw / 32767;
+}
+
+function _ensureCapacity(count: number): void {
+  if (count <= _capacity) return;
+  const cap = Math.max(8, _capacity * 2, count);
+  const prev = new Uint8Array(cap * BUTTON_STRIDE);
+  prev.set(_prevButtons);
+  const buttons = new Uint8Array(cap * BUTTON_STRIDE);
+  buttons.set(_buttons);
+  _prevButtons = prev;
+  _buttons = buttons;
+  _ids = new Uint32Array(cap);
+  _axes = new Float32Array(cap * AXIS_STRIDE);
+  _hats = new Uint8Array(cap * JOYSTICK_HATS);
+  _capacity = cap;
+}
+
+/** Fill one slot with per-value SDL calls — used when the native helper isn't built. */
+function _pollSlotFallback(slot: number, joy: Joystick): void {
+  const a = slot * AXIS_STRIDE;
+  const b = slot * BUTTON_STRIDE;
+  const h = slot * JOYSTICK_HATS;
+  _axes.fill(0, a, a + AXIS_STRIDE);
+  _buttons.fill(0, b, b + BUTTON_STRIDE);
+  _hats.fill(0, h, h + JOYSTICK_HATS);
+  const jp = joy._joystick;
+  if (!jp || !sdl.SDL_JoystickConnected(jp)) return;
+  const gp = joy._gamepad;
+  if (gp) {
+    for (let i = 0; i < GAMEPAD_AXES; i++) _axes[a + i] = _normalizeAxis(sdl.SDL_GetGamepadAxis(gp, i));
+    for (let i = 0; i < GAMEPAD_BUTTONS; i++) _buttons[b + i] = sdl.SDL_GetGamepadButton(gp, i) ? 1 : 0;
+  }
+  const na = Math.min(JOYSTICK_AXES, sdl.SDL_GetNumJoystickAxes(jp));
+  for (let i = 0; i < na; i++) _axes[a + GAMEPAD_AXES + i] = _normalizeAxis(sdl.SDL_GetJoystickAxis(jp, i));
+  const nb = Math.min(JOYSTICK_BUTTONS, sdl.SDL_GetNumJoystickButtons(jp));
+  for (let i = 0; i < nb; i++) _buttons[b + GAMEPAD_BUTTONS + i] = sdl.SDL_GetJoystickButton(jp, i) ? 1 : 0;
+  const nh = Math.min(JOYSTICK_HATS, sdl.SDL_GetNumJoystickHats(jp));
+  for (let i = 0; i < nh; i++) _hats[h + i] = sdl.SDL_GetJoystickHat(jp, i);
+}
+
+/** Assign snapshot slots to the open joysticks, in map order. */
+function _relayout(): void {
+  _slots = Array.from(_joysticks.values());
+  _slotOf = new Map();
+  for (let i = 0; i < _slots.length; i++) {
+    _slotOf.set(_slots[i]!._instanceId, i);
+    _ids[i] = _slots[i]!._instanceId;
+  }
+  _slotsDirty = false;
+}
+
+/** Read every open joystick into the snapshot arrays, keeping last poll's buttons for edges. */
+function _poll(): void {
+  const count = _joysticks.size;
+  _ensureCapacity(count);
+
+  // Current buttons become previous; remember the slot layout they were taken in
+  const swap = _prevButtons;
+  _prevButtons = _buttons;
+  _buttons = swap;
+  const oldSlotOf = _slotOf;
+  const relayout = _slotsDirty;
+  if (relayout) _relayout();
+
+  const lib = loadInput();
+  let polled = 0;
+  if (lib) {
+    if (!_native) {
+      const table = lib.jove_input_get_buffers() as Pointer;
+      const max = lib.jove_input_get_max_joysticks();
+      _native = {
+        axes: new Float32Array(toArrayBuffer(read.ptr(table, 0) as Pointer, 0, max * AXIS_STRIDE * 4)),
+        buttons: new Uint8Array(toArrayBuffer(read.ptr(table, 8) as Pointer, 0, max * BUTTON_STRIDE)),
+        hats: new Uint8Array(toArrayBuffer(read.ptr(table, 16) as Pointer, 0, max * JOYSTICK_HATS)),
+        max,
+      };
+    }
+    // C fills its own buffers (see bun-ffi-best-practices §3); ptr() taken fresh — _ids is JS-written
+    if (lib.jove_input_poll_joysticks(
+      ptr(_ids), count,
+      GAMEPAD_AXES, JOYSTICK_AXES,
+      GAMEPAD_BUTTONS, JOYSTICK_BUTTONS, JOYSTICK_HATS,
+    ) >= 0) {
+      polled = Math.min(count, _native.max);
+      _axes.set(_native.axes.subarray(0, polled * AXIS_STRIDE));
+      _buttons.set(_native.buttons.subarray(0, polled * BUTTON_STRIDE));
+      _hats.set(_native.hats.subarray(0, polled * JOYSTICK_HATS));
+    }
+  }
+  // Joysticks past the native buffers (or without the lib) are read per value
+  for (let i = polled; i < count; i++) _pollSlotFallback(i, _slots[i]!);
+
+  if (relayout) {
+    // Move each joystick's previous buttons to its new slot; new joysticks get no edges
+    const remapped = new Uint8Array(_capacity * BUTTON_STRIDE);
+    for (let i = 0; i < count; i++) {
+      const old = oldSlotOf.get(_slots[i]!._instanceId);
+      const src = old !== undefined ? _prevButtons : _buttons;
+      const from = (old ?? i) * BUTTON_STRIDE;
+      remapped.set(src.subarray(from, from + BUTTON_STRIDE), i * BUTTON_STRIDE);
+    }
+    _prevButtons = remapped;
+  }
+}
+
+/** Snapshot all joysticks for this frame. Called by the game loop after polling events. */
+export function _snapshot(): void {
+  if (_joysticks.size === 0 && !_slotsDirty) return;
+  const first = !_hasSnapshot;
+  _poll();
+  // First snapshot: don't report buttons already held as new presses
+  if (first) _prevButtons.set(_buttons);
+  _hasSnapshot = true;
+}
+
+// Hat direction name → SDL hat value, for rebuilding snapshots from replayed events
+const HAT_FROM_NAME: Record<string, number> = Object.fromEntries(
+  Object.entries(HAT_DIRECTION_NAMES).map(([value, name]) => [name, Number(value)]),
+);
+
+/**
+ * Rebuild the snapshot from a replayed frame's events instead of SDL (input playback).
+ * State carries over from the previous frame, so it matches what the recording saw as
+ * long as its events started from neutral controllers.
+ */
+export function _replaySnapshot(events: JoveEvent[]): void {
+  const count = _joysticks.size;
+  if (_slotsDirty) {
+    // Devices changed: each one keeps its state in its new slot, new ones start neutral
+    const oldSlotOf = _slotOf;
+    const axes = _axes.slice(), buttons = _buttons.slice(), hats = _hats.slice();
+    _ensureCapacity(count);
+    _relayout();
+    _axes.fill(0);
+    _buttons.fill(0);
+    _hats.fill(0);
+    for (let i = 0; i < count; i++) {
+      const old = oldSlotOf.get(_slots[i]!._instanceId);
+      if (old === undefined) continue;
+      _axes.set(axes.subarray(old * AXIS_STRIDE, (old + 1) * AXIS_STRIDE), i * AXIS_STRIDE);
+      _buttons.set(buttons.subarray(old * BUTTON_STRIDE, (old + 1) * BUTTON_STRIDE), i * BUTTON_STRIDE);
+      _hats.set(hats.subarray(old * JOYSTICK_HATS, (old + 1) * JOYSTICK_HATS), i * JOYSTICK_HATS);
+    }
+  }
+  _prevButtons.set(_buttons);
+  for (const ev of events) {
+    if (!("instanceId" in ev)) continue;
+    const slot = _slotOf.get(ev.instanceId);
+    if (slot === undefined) continue;
+    const a = slot * AXIS_STRIDE, b = slot * BUTTON_STRIDE;
+    switch (ev.type) {
+      case "joystickaxis":
+        if (ev.axis >= 0 && ev.axis < JOYSTICK_AXES) _axes[a + GAMEPAD_AXES + ev.axis] = ev.value;
+        break;
+      case "joystickpressed":
+      case "joystickreleased":
+        if (ev.button >= 1 && ev.button <= JOYSTICK_BUTTONS) {
+          _buttons[b + GAMEPAD_BUTTONS + ev.button - 1] = ev.type === "joystickpressed" ? 1 : 0;
+        }
+        break;
+      case "joystickhat":
+        if (ev.hat >= 1 && ev.hat <= JOYSTICK_HATS) _hats[slot * JOYSTICK_HATS + ev.hat - 1] = HAT_FROM_NAME[ev.direction] ?? 0;
+        break;
+      case "gamepadaxis": {
+        const axis = GAMEPAD_AXIS_FROM_NAME[ev.axis];
+        if (axis !== undefined && axis < GAMEPAD_AXES) _axes[a + axis] = ev.value;
+        break;
+      }
+      case "gamepadpressed":
+      case "gamepadreleased": {
+        const button = GAMEPAD_BUTTON_FROM_NAME[ev.button];
+        if (button !== undefined && button < GAMEPAD_BUTTONS) _buttons[b + button] = ev.type === "gamepadpressed" ? 1 : 0;
+        break;
+      }
+    }
+  }
+  _hasSnapshot = true;
+}
+
+/** Drop the snapshot state. Called when playback starts, so replayed input starts neutral. */
+export function _resetSnapshot(): void {
+  _axes.fill(0);
+  _buttons.fill(0);
+  _prevButtons.fill(0);
+  _hats.fill(0);
+  _slotsDirty = true;
+  _hasSnapshot = false;
+}
+
+/**
+ * Get the packed state of every open joystick (jove2d extension). Inside run() this is
+ * the frame's snapshot; outside it, the joysticks are read now. The arrays are reused and
+ * overwritten by the next snapshot.
+ */
+export function getSnapshot(): JoystickSnapshot {
+  if (_recorded) {
+    if (_slotsDirty) _replaySnapshot([]);
+  } else if (!_hasSnapshot || _slotsDirty) {
+    _poll();
+  }
+  return {
+    joysticks: _slots,
+    axes: _axes,
+    buttons: _buttons,
+    previousButtons: _prevButtons,
+    hats: _hats,
+    axisStride: AXIS_STRIDE,
+    buttonStride: BUTTON_STRIDE,
+    hatStride: JOYSTICK_HATS,
+    gamepadAxes: GAMEPAD_AXES,
+    gamepadButtons: GAMEPAD_BUTTONS,
+  };
+}
+
 /** Get all connected joysticks. */
 export function getJoysticks(): Joystick[] {
   return Array.from(_joysticks.values());
@@ -79,6 +377,16 @@ export function _onJoystickAdded(instanceId: number): Joystick | null {
   // Already tracked?
   if (_joysticks.has(instanceId)) return _joysticks.get(instanceId)!;
 
+  if (_recorded) {
+    // Playback: stand in for the recorded device, whatever is plugged in here
+    const device = _recorded.get(instanceId);
+    if (!device || device.id === 0) return null;
+    const joy = _createRecordedJoystick(device);
+    _joysticks.set(instanceId, joy);
+    _slotsDirty = true;
+    return joy;
+  }
+
   const isGp = sdl.SDL_IsGamepad(instanceId);
   let joystickPtr: Pointer;
   let gamepadPtr: Pointer | null = null;
@@ -103,6 +411,7 @@ export function _onJoystickAdded(instanceId: number): Joystick | null {
 
   const joy = _createJoystick(joystickPtr, gamepadPtr, instanceId, seqId);
   _joysticks.set(instanceId, joy);
+  _slotsDirty = true;
   return joy;
 }
 
@@ -112,11 +421,13 @@ export function _onJoystickRemoved(instanceId: number): Joystick | null {
   if (!joy) return null;
 
   _joysticks.delete(instanceId);
+  _slotOf.delete(instanceId);
+  _slotsDirty = true;
 
   // Close handles
   if (joy._gamepad) {
     sdl.SDL_CloseGamepad(joy._gamepad);
-  } else {
+  } else if (joy._joystick) {
     sdl.SDL_CloseJoystick(joy._joystick);
   }
 
@@ -128,12 +439,62 @@ export function _getByInstanceId(instanceId: number): Joystick | null {
   return _joysticks.get(instanceId) ?? null;
 }
 
+/** Describe a joystick for an input recording. */
+export function _record(joy: Joystick): RecordedJoystick {
+  const [id, instanceId] = joy.getID();
+  const [vendor, product, version] = joy.getDeviceInfo();
+  return {
+    instanceId,
+    id,
+    gamepad: joy.isGamepad(),
+    name: joy.getName(),
+    axes: joy.getAxisCount(),
+    buttons: joy.getButtonCount(),
+    hats: joy.getHatCount(),
+    vendor,
+    product,
+    version,
+  };
+}
+
+/**
+ * Start input playback: the joysticks become stand-ins for the devices open when the
+ * recording started. Their state comes only from replayed events (see _replaySnapshot).
+ */
+export function _startReplay(open: RecordedJoystick[]): void {
+  _recorded = new Map();
+  _joysticks = new Map();
+  for (const device of open) {
+    _recorded.set(device.instanceId, device);
+    _onJoystickAdded(device.instanceId);
+  }
+  _resetSnapshot();
+}
+
+/** Register a device a replayed joystickadded event is about to bring in. */
+export function _addRecorded(device: RecordedJoystick): void {
+  _recorded?.set(device.instanceId, device);
+}
+
+/** End input playback and go back to the open devices. */
+export function _stopReplay(): void {
+  if (!_recorded) return;
+  _recorded = null;
+  _joysticks = _live;
+  _resetSnapshot();
+  // Pick up devices connected while their events were being ignored
+  _enumerate();
+}
+
 /** Initialize: init gamepad subsystem and enumerate already-connected joysticks. */
 export function _init(): void {
   // Init gamepad subsystem separately (non-fatal if it fails)
   const ok = sdl.SDL_Init(SDL_INIT_GAMEPAD);
   if (!ok) return;
+  _enumerate();
+}
 
+function _enumerate(): void {
   const countPtr = ptr(_countBuf);
   const idsPtr = sdl.SDL_GetJoysticks(countPtr);
   if (!idsPtr) return;
@@ -148,16 +509,125 @@ export function _init(): void {
 
 /** Cleanup: close all joysticks. */
 export function _quit(): void {
+  _recorded = null;
+  _joysticks = _live;
   for (const [instanceId, joy] of _joysticks) {
     if (joy._gamepad) {
       sdl.SDL_CloseGamepad(joy._gamepad);
-    } else {
+    } else if (joy._joystick) {
       sdl.SDL_CloseJoystick(joy._joystick);
     }
   }
   _joysticks.clear();
   _idMap.clear();
   _nextId = 1;
+  _slots = [];
+  _slotOf = new Map();
+  _slotsDirty = true;
+  _hasSnapshot = false;
+}
+
+/** True if any named gamepad button is down in `now` but was up in `before`. */
+function _gamepadEdge(slot: number, names: string[], now: Uint8Array, before: Uint8Array): boolean {
+  if (slot < 0) return false;
+  const base = slot * BUTTON_STRIDE;
+  for (const name of names) {
+    const sdlBtn = GAMEPAD_BUTTON_FROM_NAME[name];
+    if (sdlBtn !== undefined && sdlBtn < GAMEPAD_BUTTONS && now[base + sdlBtn] && !before[base + sdlBtn]) return true;
+  }
+  return false;
+}
+
+/** A stand-in for a recorded device: state from the replayed snapshot, details from the log. */
+function _createRecordedJoystick(device: RecordedJoystick): Joystick {
+  const { instanceId, gamepad } = device;
+  return {
+    _joystick: null,
+    _gamepad: null,
+    _instanceId: instanceId,
+
+    getAxisCount(): number {
+      return device.axes;
+    },
+
+    getAxis(axis: number): number {
+      const slot = _slot(instanceId);
+      return slot >= 0 && axis >= 0 && axis < JOYSTICK_AXES ? _axes[slot * AXIS_STRIDE + GAMEPAD_AXES + axis]! : 0;
+    },
+
+    getButtonCount(): number {
+      return device.buttons;
+    },
+
+    isDown(...buttons: number[]): boolean {
+      const slot = _slot(instanceId);
+      if (slot < 0) return false;
+      return buttons.some((b) => b >= 1 && b <= JOYSTICK_BUTTONS && _buttons[slot * BUTTON_STRIDE + GAMEPAD_BUTTONS + b - 1] === 1);
+    },
+
+    getHatCount(): number {
+      return device.hats;
+    },
+
+    getHat(hat: number): string {
+      const slot = _slot(instanceId);
+      const value = slot >= 0 && hat >= 0 && hat < JOYSTICK_HATS ? _hats[slot * JOYSTICK_HATS + hat]! : 0;
+      return HAT_DIRECTION_NAMES[value] ?? "c";
+    },
+
+    getName(): string {
+      return device.name;
+    },
+
+    getID(): [number, number] {
+      return [device.id, instanceId];
+    },
+
+    isConnected(): boolean {
+      return _joysticks.has(instanceId);
+    },
+
+    isGamepad(): boolean {
+      return gamepad;
+    },
+
+    getGamepadAxis(axis: string): number {
+      const sdlAxis = GAMEPAD_AXIS_FROM_NAME[axis];
+      const slot = _slot(instanceId);
+      if (!gamepad || sdlAxis === undefined || slot < 0) return 0;
+      return _axes[slot * AXIS_STRIDE + sdlAxis]!;
+    },
+
+    isGamepadDown(...buttons: string[]): boolean {
+      const slot = _slot(instanceId);
+      if (!gamepad || slot < 0) return false;
+      return buttons.some((name) => {
+        const sdlBtn = GAMEPAD_BUTTON_FROM_NAME[name];
+        return sdlBtn !== undefined && sdlBtn < GAMEPAD_BUTTONS && _buttons[slot * BUTTON_STRIDE + sdlBtn] === 1;
+      });
+    },
+
+    wasGamepadPressed(...buttons: string[]): boolean {
+      return _gamepadEdge(_slot(instanceId), buttons, _buttons, _prevButtons);
+    },
+
+    wasGamepadReleased(...buttons: string[]): boolean {
+      return _gamepadEdge(_slot(instanceId), buttons, _prevButtons, _buttons);
+    },
+
+    // Playback never drives real hardware
+    setVibration(): boolean {
+      return false;
+    },
+
+    isVibrationSupported(): boolean {
+      return false;
+    },
+
+    getDeviceInfo(): [number, number, number] {
+      return [device.vendor, device.product, device.version];
+    },
+  };
 }
 
 function _createJoystick(
@@ -176,9 +646,9 @@ function _createJoystick(
     },
 
     getAxis(axis: number): number {
-      const raw = sdl.SDL_GetJoystickAxis(joystickPtr, axis);
-      // Normalize -32768..32767 to -1..1
-      return raw < 0 ? raw / 32768 : raw / 32767;
+      const slot = _slot(instanceId);
+      if (slot >= 0 && axis >= 0 && axis < JOYSTICK_AXES) return _axes[slot * AXIS_STRIDE + GAMEPAD_AXES + axis]!;
+      return _normalizeAxis(sdl.SDL_GetJoystickAxis(joystickPtr, axis));
     },
 
     getButtonCount(): number {
@@ -186,9 +656,14 @@ function _createJoystick(
     },
 
     isDown(...buttons: number[]): boolean {
+      const slot = _slot(instanceId);
       for (const b of buttons) {
         // love2d uses 1-indexed buttons
-        if (sdl.SDL_GetJoystickButton(joystickPtr, b - 1)) return true;
+        if (slot >= 0 && b >= 1 && b <= JOYSTICK_BUTTONS) {
+          if (_buttons[slot * BUTTON_STRIDE + GAMEPAD_BUTTONS + b - 1]) return true;
+        } else if (sdl.SDL_GetJoystickButton(joystickPtr, b - 1)) {
+          return true;
+        }
       }
       return false;
     },
@@ -198,7 +673,10 @@ function _createJoystick(
     },
 
     getHat(hat: number): string {
-      const value = sdl.SDL_GetJoystickHat(joystickPtr, hat);
+      const slot = _slot(instanceId);
+      const value = slot >= 0 && hat >= 0 && hat < JOYSTICK_HATS
+        ? _hats[slot * JOYSTICK_HATS + hat]!
+        : sdl.SDL_GetJoystickHat(joystickPtr, hat);
       return HAT_DIRECTION_NAMES[value] ?? "c";
     },
 
@@ -225,21 +703,32 @@ function _createJoystick(
       if (!gamepadPtr) return 0;
       const sdlAxis = GAMEPAD_AXIS_FROM_NAME[axis];
       if (sdlAxis === undefined) return 0;
-      const raw = sdl.SDL_GetGamepadAxis(gamepadPtr, sdlAxis);
-      return raw < 0 ? raw / 32768 : raw / 32767;
+      const slot = _slot(instanceId);
+      if (slot >= 0) return _axes[slot * AXIS_STRIDE + sdlAxis]!;
+      return _normalizeAxis(sdl.SDL_GetGamepadAxis(gamepadPtr, sdlAxis));
     },
 
     isGamepadDown(...buttons: string[]): boolean {
       if (!gamepadPtr) return false;
+      const slot = _slot(instanceId);
       for (const name of buttons) {
         const sdlBtn = GAMEPAD_BUTTON_FROM_NAME[name];
-        if (sdlBtn !== undefined && sdl.SDL_GetGamepadButton(gamepadPtr, sdlBtn)) {
+        if (sdlBtn === undefined) continue;
+        if (slot >= 0 ? _buttons[slot * BUTTON_STRIDE + sdlBtn] : sdl.SDL_GetGamepadButton(gamepadPtr, sdlBtn)) {
           return true;
         }
       }
       return false;
     },
 
+    wasGamepadPressed(...buttons: string[]): boolean {
+      return _gamepadEdge(_slot(instanceId), buttons, _buttons, _prevButtons);
+    },
+
+    wasGamepadReleased(...buttons: string[]): boolean {
+      return _gamepadEdge(_slot(instanceId), buttons, _prevButtons, _buttons);
+    },
+
     setVibration(left = 0, right = 0, duration = -1): boolean {
       const lowFreq = Math.round(Math.max(0, Math.min(1, left)) * 0xffff);
       const highFreq = Math.round(Math.max(0, Math.min(1, right)) * 0xffff);
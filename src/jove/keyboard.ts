@@ -1,9 +1,10 @@
 // jove2d keyboard module — mirrors love.keyboard API
 
-import { read } from "bun:ffi";
+import { ptr, read, toArrayBuffer } from "bun:ffi";
 import type { Pointer } from "bun:ffi";
 import sdl from "../sdl/ffi.ts";
 import { SCANCODE_NAMES } from "../sdl/types.ts";
+import type { JoveEvent } from "./types.ts";
 import { _getSDLWindow } from "./window.ts";
 
 // Build reverse lookup: key name → scancode number
@@ -14,35 +15,110 @@ for (const [code, name] of Object.entries(SCANCODE_NAMES)) {
 
 let _keyRepeat = true;
 
+// Per-frame snapshot of SDL's scancode array, taken by the game loop after events are
+// pumped. Queries read these instead of calling into SDL; edge queries compare the two.
+const _state = new Uint8Array(512); // SDL_SCANCODE_COUNT
+const _prevState = new Uint8Array(512);
+let _hasSnapshot = false;
+// View onto SDL's own array (valid for the life of the SDL session)
+let _liveView: Uint8Array | null = null;
+let _livePtr: Pointer | null = null;
+const _numKeysBuf = new Int32Array(1);
+
+function _readLive(): Uint8Array | null {
+  const statePtr = sdl.SDL_GetKeyboardState(ptr(_numKeysBuf)) as Pointer | null;
+  if (!statePtr) return null;
+  if (statePtr !== _livePtr || !_liveView) {
+    const numKeys = Math.min(_state.length, read.i32(ptr(_numKeysBuf), 0));
+    _liveView = new Uint8Array(toArrayBuffer(statePtr, 0, numKeys));
+    _livePtr = statePtr;
+  }
+  return _liveView;
+}
+
+/** Current key state: this frame's snapshot inside the game loop, else SDL's live array. */
+function _current(): Uint8Array | null {
+  return _hasSnapshot ? _state : _readLive();
+}
+
+function _anyDown(state: Uint8Array, names: string[]): boolean {
+  for (let i = 0; i < names.length; i++) {
+    const scancode = NAME_TO_SCANCODE[names[i]!];
+    if (scancode !== undefined && state[scancode] !== 0) return true;
+  }
+  return false;
+}
+
+/** True if any named key is down in `now` but was up in `before`. */
+function _anyEdge(now: Uint8Array, before: Uint8Array, names: string[]): boolean {
+  if (!_hasSnapshot) return false;
+  for (let i = 0; i < names.length; i++) {
+    const scancode = NAME_TO_SCANCODE[names[i]!];
+    if (scancode !== undefined && now[scancode] !== 0 && before[scancode] === 0) return true;
+  }
+  return false;
+}
+
 /**
  * Check if any of the given keys are currently pressed.
- * Uses SDL_GetKeyboardState to read the live scancode array.
+ * Reads the frame's keyboard snapshot (SDL's live array outside the game loop).
  */
 export function isDown(...keys: string[]): boolean {
-  const statePtr = sdl.SDL_GetKeyboardState(null) as Pointer | null;
-  if (!statePtr) return false;
-
-  for (const key of keys) {
-    const scancode = NAME_TO_SCANCODE[key];
-    if (scancode === undefined) continue;
-    if (read.u8(statePtr, scancode) !== 0) return true;
-  }
-  return false;
+  const state = _current();
+  return state !== null && _anyDown(state, keys);
 }
 
 /**
  * Check if any of the given scancodes (by name) are currently pressed.
  */
 export function isScancodeDown(...scancodes: string[]): boolean {
-  const statePtr = sdl.SDL_GetKeyboardState(null) as Pointer | null;
-  if (!statePtr) return false;
+  const state = _current();
+  return state !== null && _anyDown(state, scancodes);
+}
+
+/**
+ * Check if any of the given keys went down since the previous frame (jove2d extension).
+ * Compares consecutive snapshots, so a press and release within one frame is not seen —
+ * use the keypressed callback for those. Always false outside the game loop.
+ */
+export function wasPressed(...keys: string[]): boolean {
+  return _anyEdge(_state, _prevState, keys);
+}
 
-  for (const name of scancodes) {
-    const scancode = NAME_TO_SCANCODE[name];
-    if (scancode === undefined) continue;
-    if (read.u8(statePtr, scancode) !== 0) return true;
+/** Check if any of the given keys went up since the previous frame (jove2d extension). */
+export function wasReleased(...keys: string[]): boolean {
+  return _anyEdge(_prevState, _state, keys);
+}
+
+/** Snapshot the keyboard for this frame. Called by the game loop after polling events. */
+export function _snapshot(): void {
+  const live = _readLive();
+  _prevState.set(_state);
+  if (live) _state.set(live);
+  else _state.fill(0);
+  // First snapshot: nothing was down "before", but don't report held keys as new presses
+  if (!_hasSnapshot) _prevState.set(_state);
+  _hasSnapshot = true;
+}
+
+/** Snapshot for a replayed frame: last frame's state plus the frame's recorded key events. */
+export function _replaySnapshot(events: JoveEvent[]): void {
+  _prevState.set(_state);
+  for (const ev of events) {
+    if (ev.type !== "keypressed" && ev.type !== "keyreleased") continue;
+    const scancode = NAME_TO_SCANCODE[ev.scancode];
+    if (scancode !== undefined) _state[scancode] = ev.type === "keypressed" ? 1 : 0;
   }
-  return false;
+  _hasSnapshot = true;
+}
+
+/** Drop the snapshot and SDL view. Called from quit() and when playback starts. */
+export function _resetSnapshot(): void {
+  _hasSnapshot = false;
+  _state.fill(0);
+  _prevState.fill(0);
+  _liveView = null;
+  _livePtr = null;
 }
 
 /** Map a scancode name to a key name. */
@@ -4,7 +4,7 @@ import { ptr, read, type Pointer } from "bun:ffi";
 import sdl from "../sdl/ffi.ts";
 import { CURSOR_TYPE_TO_SDL, SDL_PIXELFORMAT_ABGR8888 } from "../sdl/types.ts";
 import type { CursorType } from "../sdl/types.ts";
-import type { ImageData } from "./types.ts";
+import type { ImageData, JoveEvent } from "./types.ts";
 import { _getSDLWindow } from "./window.ts";
 import { _getRenderer } from "./graphics.ts";
 
@@ -19,7 +19,15 @@ const _ryBuf = new Float32Array(1);
 const _rxPtr = ptr(_rxBuf);
 const _ryPtr = ptr(_ryBuf);
 
-function _getState(): { x: number; y: number; buttons: number } {
+// Per-frame snapshot [x, y, buttons, previous buttons], taken by the game loop after
+// events are pumped so position/button queries are plain array reads.
+const _snap = new Float64Array(4);
+let _hasSnapshot = false;
+// Snapshot rebuilt from replayed events (input playback) — never overwritten from SDL
+let _replaying = false;
+
+/** Query SDL into _snap[0..2] (render coordinates, button mask). */
+function _readLive(): void {
   const buttons = sdl.SDL_GetMouseState(_xPtr, _yPtr);
   let x = read.f32(_xPtr, 0);
   let y = read.f32(_yPtr, 0);
@@ -30,23 +38,36 @@ function _getState(): { x: number; y: number; buttons: number } {
     x = read.f32(_rxPtr, 0);
     y = read.f32(_ryPtr, 0);
   }
-  return { x, y, buttons };
+  _snap[0] = x;
+  _snap[1] = y;
+  _snap[2] = buttons;
+}
+
+/** Mouse state for this frame: the snapshot inside the game loop, else a live query. */
+function _state(): Float64Array {
+  if (!_hasSnapshot) _readLive();
+  return _snap;
 }
 
 /** Get the current mouse position. */
 export function getPosition(): [number, number] {
-  const { x, y } = _getState();
-  return [x, y];
+  const s = _state();
+  return [s[0]!, s[1]!];
 }
 
 /** Get the current mouse X coordinate. */
 export function getX(): number {
-  return _getState().x;
+  return _state()[0]!;
 }
 
 /** Get the current mouse Y coordinate. */
 export function getY(): number {
-  return _getState().y;
+  return _state()[1]!;
+}
+
+// SDL_BUTTON(x) = 1 << (x - 1)
+function _buttonBit(button: number): number {
+  return 1 << (button - 1);
 }
 
 /**
@@ -54,9 +75,63 @@ export function getY(): number {
  * 1 = left, 2 = middle, 3 = right (matches love2d).
  */
 export function isDown(button: number): boolean {
-  const { buttons } = _getState();
-  // SDL_BUTTON(x) = 1 << (x - 1)
-  return (buttons & (1 << (button - 1))) !== 0;
+  return (_state()[2]! & _buttonBit(button)) !== 0;
+}
+
+/**
+ * Check if a mouse button went down since the previous frame (jove2d extension).
+ * Compares consecutive snapshots; always false outside the game loop.
+ */
+export function wasPressed(button: number): boolean {
+  const bit = _buttonBit(button);
+  return _hasSnapshot && (_snap[2]! & bit) !== 0 && (_snap[3]! & bit) === 0;
+}
+
+/** Check if a mouse button went up since the previous frame (jove2d extension). */
+export function wasReleased(button: number): boolean {
+  const bit = _buttonBit(button);
+  return _hasSnapshot && (_snap[2]! & bit) === 0 && (_snap[3]! & bit) !== 0;
+}
+
+/** Snapshot the mouse for this frame. Called by the game loop after polling events. */
+export function _snapshot(): void {
+  const prev = _snap[2]!;
+  _readLive();
+  _snap[3] = _hasSnapshot ? prev : _snap[2]!;
+  _hasSnapshot = true;
+  _replaying = false;
+}
+
+/** Snapshot for a replayed frame: last frame's state plus the frame's recorded mouse events. */
+export function _replaySnapshot(events: JoveEvent[]): void {
+  _snap[3] = _snap[2]!;
+  for (const ev of events) {
+    switch (ev.type) {
+      case "mousemoved":
+        _snap[0] = ev.x;
+        _snap[1] = ev.y;
+        break;
+      case "mousepressed":
+        _snap[0] = ev.x;
+        _snap[1] = ev.y;
+        _snap[2] = _snap[2]! | _buttonBit(ev.button);
+        break;
+      case "mousereleased":
+        _snap[0] = ev.x;
+        _snap[1] = ev.y;
+        _snap[2] = _snap[2]! & ~_buttonBit(ev.button);
+        break;
+    }
+  }
+  _hasSnapshot = true;
+  _replaying = true;
+}
+
+/** Drop the snapshot. Called from quit() and when playback starts. */
+export function _resetSnapshot(): void {
+  _hasSnapshot = false;
+  _replaying = false;
+  _snap.fill(0);
 }
 
 /** Warp the mouse cursor to the given position within the window. */
@@ -64,6 +139,13 @@ export function setPosition(x: number, y: number): void {
   const win = _getSDLWindow();
   if (!win) return;
   sdl.SDL_WarpMouseInWindow(win, x, y);
+  // Keep this frame's snapshot in step with the warp
+  if (_replaying) {
+    _snap[0] = x;
+    _snap[1] = y;
+  } else if (_hasSnapshot) {
+    _readLive();
+  }
 }
 
 /** Show or hide the mouse cursor. */
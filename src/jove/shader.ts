@@ -4,6 +4,7 @@ import { ptr, toBuffer } from "bun:ffi";
 import type { Pointer } from "bun:ffi";
 import { readFileSync } from "fs";
 import sdl from "../sdl/ffi.ts";
+import { _flushCommands } from "./graphics-commands.ts";
 import {
   GPU_SHADER_CREATE_INFO_SIZE,
   GPU_SHADER_OFFSET_CODE_SIZE,
@@ -452,8 +453,9 @@ export async function createShader(
 
       _writeUniform(uniformBufView, info, values);
 
-      // Push to GPU
+      // Push to GPU — recorded draws still pending must use the old values
       if (totalUniformSize > 0) {
+        _flushCommands();
         sdl.SDL_SetGPURenderStateFragmentUniforms(
           renderState,
           0,
@@ -1,9 +1,9 @@
 // jove2d sound module — mirrors love.sound API
 // Provides SoundData for sample-level audio manipulation + streaming Decoder
 
-import { read, toArrayBuffer } from "bun:ffi";
+import { toArrayBuffer } from "bun:ffi";
 import type { Pointer } from "bun:ffi";
-import { SDL_AUDIO_U8, SDL_AUDIO_S16 } from "../sdl/types.ts";
+import { SDL_AUDIO_U8, SDL_AUDIO_S16, SDL_AUDIO_F32 } from "../sdl/types.ts";
 import { _decodeFile } from "./audio.ts";
 import { loadAudioDecode } from "../sdl/ffi_audio_decode.ts";
 
@@ -16,7 +16,7 @@ export interface SoundData {
   getSampleCount(): number;
   /** Sample rate in Hz (e.g. 44100). */
   getSampleRate(): number;
-  /** Bit depth (8 or 16). */
+  /** Bit depth (8, 16, or 32 for float). */
   getBitDepth(): number;
   /** Number of audio channels (1=mono, 2=stereo). */
   getChannelCount(): number;
@@ -24,6 +24,31 @@ export interface SoundData {
   getDuration(): number;
   /** Raw PCM bytes as a binary string (love2d compat). */
   getString(): string;
+
+  // --- Typed-array access + bulk operations ---
+
+  /** Interleaved samples as a live Int16Array view (16-bit SoundData only). */
+  getInt16Array(): Int16Array;
+  /** Interleaved samples as a live Float32Array view (32-bit float SoundData only). */
+  getFloat32Array(): Float32Array;
+  /**
+   * Add this SoundData's samples into `target`, scaled by gain, starting at target frame
+   * `offset`. Sample rate and channel count must match; bit depths may differ. Clips to -1..1
+   * for integer targets. Returns the number of frames mixed.
+   */
+  mixInto(target: SoundData, gain?: number, offset?: number): number;
+  /** Return a new SoundData resampled to `rate` Hz (linear interpolation). */
+  resample(rate: number): SoundData;
+  /** Return a new SoundData with a different bit depth and/or channel count. */
+  convert(bitDepth: number, channels?: number): SoundData;
+  /** Scale samples in place so the loudest one reaches `peak`. Returns the gain applied. */
+  normalize(peak?: number): number;
+  /**
+   * Multiply samples in place by a piecewise-linear gain envelope given as flat
+   * [time, gain, time, gain, ...] pairs (seconds, ascending). Gain holds before the first
+   * and after the last point.
+   */
+  applyEnvelope(points: ArrayLike<number>): void;
   /** @internal — raw PCM byte data */
   _data: Uint8Array;
   /** @internal — SDL audio format constant */
@@ -53,11 +78,19 @@ export function newSoundData(
   return _fromEmpty(samplesOrPath, rate, bitDepth, channels);
 }
 
+function _formatForBitDepth(bitDepth: number): number {
+  if (bitDepth === 32) return SDL_AUDIO_F32;
+  return bitDepth === 16 ? SDL_AUDIO_S16 : SDL_AUDIO_U8;
+}
+
 function _fromEmpty(samples: number, rate: number, bitDepth: number, channels: number): SoundData {
-  const bytesPerSample = bitDepth === 16 ? 2 : 1;
+  if (bitDepth !== 8 && bitDepth !== 16 && bitDepth !== 32) {
+    throw new Error(`Invalid bit depth: ${bitDepth} (expected 8, 16 or 32)`);
+  }
+  const bytesPerSample = bitDepth / 8;
   const totalBytes = samples * channels * bytesPerSample;
   const data = new Uint8Array(totalBytes);
-  const format = bitDepth === 16 ? SDL_AUDIO_S16 : SDL_AUDIO_U8;
+  const format = _formatForBitDepth(bitDepth);
   // For 8-bit, silence is 128 (unsigned center)
   if (bitDepth === 8) data.fill(128);
   return _createSoundData(data, format, channels, rate, bitDepth);
@@ -66,10 +99,37 @@ function _fromEmpty(samples: number, rate: number, bitDepth: number, channels: n
 function _fromFile(path: string): SoundData {
   const decoded = _decodeFile(path);
   if (!decoded) throw new Error(`Could not load audio file: ${path}`);
-  const bitDepth = decoded.format === SDL_AUDIO_U8 ? 8 : 16;
+  const bitDepth = decoded.format === SDL_AUDIO_U8 ? 8 : decoded.format === SDL_AUDIO_F32 ? 32 : 16;
   return _createSoundData(decoded.data, decoded.format, decoded.channels, decoded.freq, bitDepth);
 }
 
+// --- Bulk sample helpers ---
+// Each SoundData is read through its native typed array plus a (bias, scale) pair that maps
+// raw values to -1..1, so the bulk loops below stay monomorphic and branch-free per sample.
+
+type SampleArray = Uint8Array | Int16Array | Float32Array;
+
+function _samplesOf(sd: SoundData): SampleArray {
+  const d = sd._data;
+  if (sd._bitDepth === 32) return new Float32Array(d.buffer, d.byteOffset, d.length >> 2);
+  if (sd._bitDepth === 16) return new Int16Array(d.buffer, d.byteOffset, d.length >> 1);
+  return d;
+}
+
+function _biasOf(bitDepth: number): number {
+  return bitDepth === 8 ? 128 : 0;
+}
+
+function _scaleOf(bitDepth: number): number {
+  if (bitDepth === 32) return 1;
+  return bitDepth === 16 ? 1 / 32768 : 1 / 128;
+}
+
+/** Largest positive raw value for an integer bit depth (-1..1 maps onto ±this). */
+function _quantizeMax(bitDepth: number): number {
+  return bitDepth === 16 ? 32767 : 127;
+}
+
 export function _createSoundData(
   data: Uint8Array,
   format: number,
@@ -77,15 +137,18 @@ export function _createSoundData(
   sampleRate: number,
   bitDepth: number,
 ): SoundData {
-  const bytesPerSample = bitDepth === 16 ? 2 : 1;
+  const bytesPerSample = bitDepth / 8;
   const frameCount = Math.floor(data.length / (channels * bytesPerSample));
 
-  // Typed view for 16-bit sample access
+  // Typed views for 16-bit / float sample access
   const view16 = bitDepth === 16
     ? new Int16Array(data.buffer, data.byteOffset, Math.floor(data.length / 2))
     : null;
+  const view32 = bitDepth === 32
+    ? new Float32Array(data.buffer, data.byteOffset, Math.floor(data.length / 4))
+    : null;
 
-  return {
+  const sd: SoundData = {
     _data: data,
     _format: format,
     _channels: channels,
@@ -97,6 +160,8 @@ export function _createSoundData(
       if (i < 0 || i >= frameCount || ch < 0 || ch >= channels) return 0;
       if (view16) {
         return view16[i * channels + ch]! / 32768;
+      } else if (view32) {
+        return view32[i * channels + ch]!;
       } else {
         // 8-bit unsigned: 0-255 → -1..1
         return (data[i * channels + ch]! - 128) / 128;
@@ -109,6 +174,8 @@ export function _createSoundData(
       const clamped = Math.max(-1, Math.min(1, value));
       if (view16) {
         view16[i * channels + ch] = Math.round(clamped * 32767);
+      } else if (view32) {
+        view32[i * channels + ch] = clamped;
       } else {
         data[i * channels + ch] = Math.round(clamped * 128 + 128);
       }
@@ -141,7 +208,195 @@ export function _createSoundData(
       }
       return str;
     },
+
+    getInt16Array(): Int16Array {
+      if (!view16) throw new Error(`getInt16Array: SoundData is ${bitDepth}-bit, not 16-bit`);
+      return view16;
+    },
+
+    getFloat32Array(): Float32Array {
+      if (!view32) throw new Error(`getFloat32Array: SoundData is ${bitDepth}-bit, not 32-bit float`);
+      return view32;
+    },
+
+    mixInto(target: SoundData, gain: number = 1, offset: number = 0): number {
+      if (target._channels !== channels) throw new Error("mixInto: channel count mismatch");
+      if (target._sampleRate !== sampleRate) throw new Error("mixInto: sample rate mismatch");
+      const dstOffset = Math.max(0, Math.floor(offset));
+      const frames = Math.min(frameCount, target.getSampleCount() - dstOffset);
+      if (frames <= 0) return 0;
+
+      const src = _samplesOf(sd);
+      const dst = _samplesOf(target);
+      const sBias = _biasOf(bitDepth);
+      const sScale = _scaleOf(bitDepth) * gain;
+      const n = frames * channels;
+      const base = dstOffset * channels;
+
+      if (target._bitDepth === 32) {
+        for (let i = 0; i < n; i++) {
+          dst[base + i] = dst[base + i]! + (src[i]! - sBias) * sScale;
+        }
+      } else {
+        const dBias = _biasOf(target._bitDepth);
+        const dScale = _scaleOf(target._bitDepth);
+        const q = _quantizeMax(target._bitDepth);
+        for (let i = 0; i < n; i++) {
+          let v = (dst[base + i]! - dBias) * dScale + (src[i]! - sBias) * sScale;
+          v = v < -1 ? -1 : v > 1 ? 1 : v;
+          dst[base + i] = Math.round(v * q) + dBias;
+        }
+      }
+      return frames;
+    },
+
+    resample(rate: number): SoundData {
+      if (!(rate > 0)) throw new Error(`resample: invalid sample rate ${rate}`);
+      const outFrames = Math.max(1, Math.round(frameCount * rate / sampleRate));
+      const out = _fromEmpty(outFrames, rate, bitDepth, channels);
+      if (frameCount === 0) return out;
+      const src = _samplesOf(sd);
+      const dst = _samplesOf(out);
+      const step = sampleRate / rate;
+      const last = frameCount - 1;
+      const isFloat = bitDepth === 32;
+
+      for (let f = 0; f < outFrames; f++) {
+        const pos = f * step;
+        let i0 = Math.floor(pos);
+        if (i0 > last) i0 = last;
+        const i1 = i0 < last ? i0 + 1 : last;
+        const t = pos - i0;
+        const a = i0 * channels;
+        const b = i1 * channels;
+        const o = f * channels;
+        for (let c = 0; c < channels; c++) {
+          // Bias cancels out for interpolation between two raw values
+          const v = src[a + c]! + (src[b + c]! - src[a + c]!) * t;
+          dst[o + c] = isFloat ? v : Math.round(v);
+        }
+      }
+      return out;
+    },
+
+    convert(newBitDepth: number, newChannels: number = channels): SoundData {
+      if (newChannels < 1) throw new Error(`convert: invalid channel count ${newChannels}`);
+      const out = _fromEmpty(frameCount, sampleRate, newBitDepth, newChannels);
+      const src = _samplesOf(sd);
+      const dst = _samplesOf(out);
+      const sBias = _biasOf(bitDepth);
+      const sScale = _scaleOf(bitDepth);
+      const dBias = _biasOf(newBitDepth);
+      const isFloat = newBitDepth === 32;
+      const q = isFloat ? 1 : _quantizeMax(newBitDepth);
+      // Downmix to mono averages all channels; otherwise channel c reads min(c, last source channel)
+      const downmix = newChannels === 1 && channels > 1;
+      const avg = 1 / channels;
+
+      for (let f = 0; f < frameCount; f++) {
+        const a = f * channels;
+        const o = f * newChannels;
+        for (let c = 0; c < newChannels; c++) {
+          let v: number;
+          if (downmix) {
+            v = 0;
+            for (let k = 0; k < channels; k++) v += src[a + k]! - sBias;
+            v *= sScale * avg;
+          } else {
+            v = (src[a + (c < channels ? c : channels - 1)]! - sBias) * sScale;
+          }
+          if (isFloat) {
+            dst[o + c] = v;
+          } else {
+            v = v < -1 ? -1 : v > 1 ? 1 : v;
+            dst[o + c] = Math.round(v * q) + dBias;
+          }
+        }
+      }
+      return out;
+    },
+
+    normalize(peak: number = 1): number {
+      const samples = _samplesOf(sd);
+      const bias = _biasOf(bitDepth);
+      const n = samples.length;
+      let max = 0;
+      for (let i = 0; i < n; i++) {
+        const v = Math.abs(samples[i]! - bias);
+        if (v > max) max = v;
+      }
+      if (max === 0) return 1;
+      const gain = Math.max(0, peak) / (max * _scaleOf(bitDepth));
+      _scaleRange(samples, bitDepth, 0, n, gain);
+      return gain;
+    },
+
+    applyEnvelope(points: ArrayLike<number>): void {
+      const count = points.length >> 1;
+      if (count === 0) return;
+      const samples = _samplesOf(sd);
+      // Hold the first gain up to the first point
+      let prevFrame = 0;
+      let prevGain = points[1]!;
+      for (let p = 0; p < count; p++) {
+        const frame = Math.min(frameCount, Math.max(0, Math.round(points[p * 2]! * sampleRate)));
+        const g = points[p * 2 + 1]!;
+        if (p === 0) {
+          _scaleRange(samples, bitDepth, 0, frame * channels, g);
+        } else if (frame > prevFrame) {
+          // Linear ramp prevGain → g across [prevFrame, frame)
+          _rampRange(samples, bitDepth, channels, prevFrame, frame, prevGain, g);
+        }
+        prevFrame = Math.max(prevFrame, frame);
+        prevGain = g;
+      }
+      // Hold the last gain to the end
+      _scaleRange(samples, bitDepth, prevFrame * channels, frameCount * channels, prevGain);
+    },
   };
+  return sd;
+}
+
+/** Multiply samples [start, end) by a constant gain, clipping integer formats. */
+function _scaleRange(samples: SampleArray, bitDepth: number, start: number, end: number, gain: number): void {
+  if (gain === 1) return;
+  if (bitDepth === 32) {
+    for (let i = start; i < end; i++) samples[i] = samples[i]! * gain;
+    return;
+  }
+  const bias = _biasOf(bitDepth);
+  const lo = bitDepth === 16 ? -32768 : 0;
+  const hi = bitDepth === 16 ? 32767 : 255;
+  for (let i = start; i < end; i++) {
+    const v = Math.round((samples[i]! - bias) * gain) + bias;
+    samples[i] = v < lo ? lo : v > hi ? hi : v;
+  }
+}
+
+/** Multiply frames [startFrame, endFrame) by a gain ramping linearly from g0 to g1. */
+function _rampRange(
+  samples: SampleArray, bitDepth: number, channels: number,
+  startFrame: number, endFrame: number, g0: number, g1: number,
+): void {
+  const span = endFrame - startFrame;
+  const dg = (g1 - g0) / span;
+  const isFloat = bitDepth === 32;
+  const bias = _biasOf(bitDepth);
+  const lo = bitDepth === 16 ? -32768 : 0;
+  const hi = bitDepth === 16 ? 32767 : 255;
+  let g = g0;
+  for (let f = startFrame; f < endFrame; f++) {
+    const a = f * channels;
+    for (let c = 0; c < channels; c++) {
+      if (isFloat) {
+        samples[a + c] = samples[a + c]! * g;
+      } else {
+        const v = Math.round((samples[a + c]! - bias) * g) + bias;
+        samples[a + c] = v < lo ? lo : v > hi ? hi : v;
+      }
+    }
+    g += dg;
+  }
 }
 
 // ============================================================
@@ -151,6 +406,12 @@ export function _createSoundData(
 export interface Decoder {
   /** Read next chunk of PCM data. Returns SoundData or null on EOF. */
   decode(): SoundData | null;
+  /**
+   * Decode the next chunk into an existing 16-bit SoundData with the same channel count.
+   * Writes at most min(bufferSize, soundData.getSampleCount()) frames from the start of
+   * the buffer. Returns the number of frames written (0 on EOF). Allocates nothing.
+   */
+  decodeInto(soundData: SoundData): number;
   /** Seek to a PCM frame offset. */
   seek(offset: number): void;
   /** Get current position in frames. */
@@ -173,6 +434,10 @@ export interface Decoder {
   _idx: number;
   /** @internal — buffer size in frames */
   _bufferSize: number;
+  /** @internal — SoundData view over the shared C-side read buffer (decodeInto target with no copy) */
+  _buffer: SoundData;
+  /** @internal — native address of _buffer's data, for passing straight to SDL */
+  _bufPtr: Pointer;
 }
 
 /**
@@ -202,12 +467,23 @@ export function newDecoder(path: string, bufferSize: number = 4096): Decoder {
   // Get C-side buffer pointer (avoids ptr() Windows bug)
   const bufPtr = lib.jove_decoder_get_buf() as Pointer;
 
+  // Persistent view over the C-side buffer, sized to one chunk. decodeInto() copies
+  // out of it with a plain memcpy (TypedArray.set) instead of slicing a new ArrayBuffer.
+  const frameBytes = channels * 2; // S16
+  // Shared read buffer capacity — DECODER_READ_BUF_FRAMES * 2 samples, tunable at build time
+  const bufSamples = lib.jove_decoder_get_buf_samples();
+  const maxFrames = Math.max(1, Math.min(bufferSize, Math.floor(bufSamples / channels)));
+  const bufView = new Uint8Array(toArrayBuffer(bufPtr, 0, maxFrames * frameBytes));
+  const buffer = _createSoundData(bufView, SDL_AUDIO_S16, channels, sampleRate, 16);
+
   let _finished = false;
   let _closed = false;
 
   return {
     _idx: idx,
     _bufferSize: bufferSize,
+    _buffer: buffer,
+    _bufPtr: bufPtr,
 
     decode(): SoundData | null {
       if (_closed || _finished) return null;
@@ -225,6 +501,30 @@ export function newDecoder(path: string, bufferSize: number = 4096): Decoder {
       return _createSoundData(data, SDL_AUDIO_S16, channels, sampleRate, 16);
     },
 
+    decodeInto(soundData: SoundData): number {
+      if (_closed || _finished) return 0;
+      if (soundData._bitDepth !== 16 || soundData._channels !== channels) {
+        throw new Error(`decodeInto: SoundData must be 16-bit with ${channels} channel(s)`);
+      }
+
+      const capacity = Math.floor(soundData._data.length / frameBytes);
+      if (capacity <= 0) return 0;
+
+      const framesRead = lib.jove_decoder_fill(idx, Math.min(maxFrames, capacity));
+      if (framesRead <= 0) {
+        _finished = true;
+        return 0;
+      }
+
+      // Decoding into _buffer is already in place; anything else gets one memcpy
+      const dst = soundData._data;
+      if (dst.buffer !== bufView.buffer) {
+        const byteLen = framesRead * frameBytes;
+        dst.set(byteLen === bufView.length ? bufView : bufView.subarray(0, byteLen));
+      }
+      return framesRead;
+    },
+
     seek(offset: number): void {
       if (_closed) return;
       lib.jove_decoder_seek(idx, BigInt(Math.max(0, Math.floor(offset))));
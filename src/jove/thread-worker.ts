@@ -0,0 +1,12 @@
+// jove2d thread bootstrap — the entry module of every Worker started by Thread.start()
+// Attaches the shared heap, then runs the thread's file with its start() arguments.
+
+import { _attachHeap, _runThread } from "./thread.ts";
+
+declare const self: Worker;
+
+self.onmessage = (event: MessageEvent<{ heap: SharedArrayBuffer; block: number; file: string }>) => {
+  const { heap, block, file } = event.data;
+  _attachHeap(heap);
+  _runThread(block, file).finally(() => process.exit(0));
+};
@@ -0,0 +1,954 @@
+// jove2d thread module — mirrors love.thread on Bun Workers
+// Provides newThread, newChannel/getChannel, and shared ImageData/SoundData/ByteData
+//
+// Every thread shares one SharedArrayBuffer heap, created by the main thread on first use
+// and handed to each Worker when it starts. Channels, their queued messages, and the bytes
+// of shared ImageData / SoundData / ByteData all live in that heap, so after a thread
+// starts nothing is ever transferred: a message holds heap offsets, receiving a shared
+// object makes a view onto the same bytes, and a blocked demand() is Atomics.wait on the
+// channel's sequence word.
+//
+// Heap blocks are reference counted. Each view a thread holds (a received data object or
+// a Channel) owns one reference, dropped by a FinalizationRegistry when the view is
+// collected, and a queued message owns one reference per object it carries.
+
+import { resolve } from "path";
+import { ByteData, _wrapByteData } from "./data.ts";
+import { SDL_AUDIO_U8, SDL_AUDIO_S16, SDL_AUDIO_F32 } from "../sdl/types.ts";
+import type { ImageData } from "./image.ts";
+import type { SoundData } from "./sound.ts";
+
+// ============================================================
+// Shared heap
+// ============================================================
+
+const HEAP_INITIAL = 16 * 1024 * 1024;
+const HEAP_MAX = 1024 * 1024 * 1024; // reserved address space; pages are committed on growth
+
+// Heap header (Int32 slots)
+const H_LOCK = 0; // allocator mutex
+const H_FREE = 1; // first free block (byte offset, address-ordered list), 0 = none
+const H_TOP = 2; // end of the allocated region
+const H_NAMES_LOCK = 3; // named-channel table mutex
+const H_NAMES = 4; // first named-channel entry
+const HEAP_HEADER = 64;
+
+// Block header (Int32 slots from the block start); the payload follows at +BLOCK_HEADER
+const B_SIZE = 0; // whole block in bytes, a multiple of 16
+const B_REFS = 1;
+const B_NEXT = 2; // next free block while free; payload byte length while allocated
+const B_KIND = 3;
+const BLOCK_HEADER = 16;
+const MIN_SPLIT = 64; // smallest remainder worth splitting off a reused free block
+
+const KIND_DATA = 1;
+const KIND_MESSAGE = 2;
+const KIND_CHANNEL = 3;
+const KIND_QUEUE = 4;
+const KIND_NAME = 5;
+const KIND_THREAD = 6;
+
+/** The ES2024 resizable-buffer members of a growable SharedArrayBuffer. */
+interface Growable {
+  readonly byteLength: number;
+  readonly maxByteLength?: number;
+  grow?(newLength: number): void;
+}
+
+let _heap: SharedArrayBuffer | null = null;
+export let _i32: Int32Array = new Int32Array(0);
+let _u8: Uint8Array = new Uint8Array(0);
+let _dv: DataView = new DataView(new ArrayBuffer(0));
+let _isMainThread = true;
+
+// Views over a growable SharedArrayBuffer track its length, so growth by any thread is
+// visible everywhere without re-creating them.
+function _attach(heap: SharedArrayBuffer): void {
+  _heap = heap;
+  _i32 = new Int32Array(heap);
+  _u8 = new Uint8Array(heap);
+  _dv = new DataView(heap);
+}
+
+function _ensureHeap(): void {
+  if (_heap) return;
+  let heap: SharedArrayBuffer;
+  try {
+    const GrowableBuffer = SharedArrayBuffer as unknown as new (length: number, options: { maxByteLength: number }) => SharedArrayBuffer;
+    heap = new GrowableBuffer(HEAP_INITIAL, { maxByteLength: HEAP_MAX });
+  } catch {
+    heap = new SharedArrayBuffer(HEAP_INITIAL * 4); // fixed size without resizable buffers
+  }
+  _attach(heap);
+  _i32[H_TOP] = HEAP_HEADER;
+}
+
+/** Attach the heap handed over by the spawning thread (Worker bootstrap). */
+export function _attachHeap(heap: SharedArrayBuffer): void {
+  _attach(heap);
+  _isMainThread = false;
+}
+
+/** The shared heap, created on first use (for the job system and tests). */
+export function _getHeap(): SharedArrayBuffer {
+  _ensureHeap();
+  return _heap!;
+}
+
+// --- Mutex: 0 = unlocked, 1 = locked, 2 = locked with waiters ---
+
+export function _lock(a: Int32Array, i: number): void {
+  let c = Atomics.compareExchange(a, i, 0, 1);
+  if (c === 0) return;
+  if (c !== 2) c = Atomics.exchange(a, i, 2);
+  while (c !== 0) {
+    Atomics.wait(a, i, 2);
+    c = Atomics.exchange(a, i, 2);
+  }
+}
+
+export function _unlock(a: Int32Array, i: number): void {
+  if (Atomics.sub(a, i, 1) !== 1) {
+    Atomics.store(a, i, 0);
+    Atomics.notify(a, i, 1);
+  }
+}
+
+// --- Allocator: first fit over an address-ordered free list, merging neighbours ---
+
+function _link(prev: number, block: number): void {
+  if (prev === 0) _i32[H_FREE] = block;
+  else _i32[(prev >> 2) + B_NEXT] = block;
+}
+
+function _grow(need: number): void {
+  const heap = _heap as unknown as Growable;
+  const max = heap.maxByteLength ?? 0;
+  if (!heap.grow || need > max) throw new Error("jove.thread: shared heap exhausted");
+  heap.grow(Math.min(max, Math.max(need, heap.byteLength * 2)));
+}
+
+/** Allocate a block with a zeroed `bytes`-byte payload and one reference. Returns the block offset. */
+export function _alloc(bytes: number, kind: number): number {
+  _ensureHeap();
+  const size = (bytes + BLOCK_HEADER + 15) & ~15;
+  let block = 0;
+  _lock(_i32, H_LOCK);
+  try {
+    let prev = 0;
+    let cur = _i32[H_FREE]!;
+    while (cur !== 0) {
+      const curSize = _i32[cur >> 2]!;
+      const next = _i32[(cur >> 2) + B_NEXT]!;
+      if (curSize >= size) {
+        if (curSize - size >= MIN_SPLIT) {
+          const rest = cur + size;
+          _i32[rest >> 2] = curSize - size;
+          _i32[(rest >> 2) + B_NEXT] = next;
+          _link(prev, rest);
+          _i32[cur >> 2] = size;
+        } else {
+          _link(prev, next);
+        }
+        block = cur;
+        break;
+      }
+      prev = cur;
+      cur = next;
+    }
+    if (block === 0) {
+      const top = _i32[H_TOP]!;
+      if (top + size > _heap!.byteLength) _grow(top + size);
+      _i32[H_TOP] = top + size;
+      _i32[top >> 2] = size;
+      block = top;
+    }
+  } finally {
+    _unlock(_i32, H_LOCK);
+  }
+  const b = block >> 2;
+  _i32[b + B_REFS] = 1;
+  _i32[b + B_NEXT] = bytes;
+  _i32[b + B_KIND] = kind;
+  _u8.fill(0, block + BLOCK_HEADER, block + _i32[b]!);
+  return block;
+}
+
+function _free(block: number): void {
+  _lock(_i32, H_LOCK);
+  try {
+    let size = _i32[block >> 2]!;
+    _i32[(block >> 2) + B_KIND] = 0;
+    let prev = 0;
+    let cur = _i32[H_FREE]!;
+    while (cur !== 0 && cur < block) {
+      prev = cur;
+      cur = _i32[(cur >> 2) + B_NEXT]!;
+    }
+    if (cur !== 0 && block + size === cur) {
+      size += _i32[cur >> 2]!;
+      cur = _i32[(cur >> 2) + B_NEXT]!;
+    }
+    if (prev !== 0 && prev + _i32[prev >> 2]! === block) {
+      _i32[prev >> 2] = _i32[prev >> 2]! + size;
+      _i32[(prev >> 2) + B_NEXT] = cur;
+    } else {
+      _i32[block >> 2] = size;
+      _i32[(block >> 2) + B_NEXT] = cur;
+      _link(prev, block);
+    }
+  } finally {
+    _unlock(_i32, H_LOCK);
+  }
+}
+
+/** Payload byte offset of a block. */
+export function _payload(block: number): number {
+  return block + BLOCK_HEADER;
+}
+
+/** Payload byte length a block was allocated with. */
+function _length(block: number): number {
+  return _i32[(block >> 2) + B_NEXT]!;
+}
+
+export function _retain(block: number): void {
+  Atomics.add(_i32, (block >> 2) + B_REFS, 1);
+}
+
+/** Drop one reference; the block (and whatever it holds) is freed at zero. */
+export function _release(block: number): void {
+  if (Atomics.sub(_i32, (block >> 2) + B_REFS, 1) !== 1) return;
+  const kind = _i32[(block >> 2) + B_KIND];
+  if (kind === KIND_MESSAGE) _dropMessage(block);
+  else if (kind === KIND_CHANNEL) _dropChannel(block);
+  else if (kind === KIND_THREAD) _dropThread(block);
+  else if (kind !== undefined) _dropHandlers.get(kind)?.(block);
+  _free(block);
+}
+
+// Cleanup for block kinds defined by other modules (jobs)
+const _dropHandlers = new Map<number, (block: number) => void>();
+
+/** Run `drop` before a block of `kind` (16 and up) is freed, to release what it holds. */
+export function _onDrop(kind: number, drop: (block: number) => void): void {
+  _dropHandlers.set(kind, drop);
+}
+
+// Views own a reference until they're collected. The live set lets a Worker release
+// the references of views still alive when it exits, since finalizers never run then.
+const _live = new Set<{ block: number }>();
+const _views = new FinalizationRegistry<{ block: number }>((held) => {
+  if (_heap && _live.delete(held)) _release(held.block);
+});
+
+/** Make `view` own one (already counted) reference to `block`, dropped when it is collected. */
+export function _track(view: object, block: number): void {
+  const held = { block };
+  _live.add(held);
+  _views.register(view, held, held);
+}
+
+/** Release the references of every live view (a Worker about to exit). */
+export function _releaseViews(): void {
+  for (const held of _live) {
+    _views.unregister(held);
+    _release(held.block);
+  }
+  _live.clear();
+}
+
+// ============================================================
+// Shared data objects
+// ============================================================
+
+/** The data block behind `view` if it is the full payload of one, else 0. */
+function _dataBlockOf(view: Uint8Array): number {
+  if (view.buffer !== _heap || (view.byteOffset & 15) !== 0) return 0;
+  const block = view.byteOffset - BLOCK_HEADER;
+  if (block < HEAP_HEADER || _i32[(block >> 2) + B_KIND] !== KIND_DATA) return 0;
+  return _length(block) === view.byteLength ? block : 0;
+}
+
+/** A view on a data block's payload, holding one reference (already counted). */
+function _dataView(block: number): Uint8Array {
+  const view = new Uint8Array(_heap!, _payload(block), _length(block));
+  _track(view, block);
+  return view;
+}
+
+function _newDataBlock(bytes: number): Uint8Array {
+  return _dataView(_alloc(bytes, KIND_DATA));
+}
+
+function _soundFormat(bitDepth: number): number {
+  if (bitDepth === 32) return SDL_AUDIO_F32;
+  return bitDepth === 16 ? SDL_AUDIO_S16 : SDL_AUDIO_U8;
+}
+
+function _wrapImage(view: Uint8Array, width: number, height: number): ImageData {
+  const { _createImageData } = require("./image.ts");
+  return _createImageData(view, width, height);
+}
+
+function _wrapSound(view: Uint8Array, channels: number, rate: number, bitDepth: number): SoundData {
+  const { _createSoundData } = require("./sound.ts");
+  return _createSoundData(view, _soundFormat(bitDepth), channels, rate, bitDepth);
+}
+
+/** Create an ImageData in shared memory: it crosses channels and threads without copying. */
+export function newImageData(width: number, height: number): ImageData | null {
+  if (width <= 0 || height <= 0) return null;
+  return _wrapImage(_newDataBlock(width * height * 4), width, height);
+}
+
+/** Create a SoundData in shared memory: it crosses channels and threads without copying. */
+export function newSoundData(samples: number, rate: number = 44100, bitDepth: number = 16, channels: number = 1): SoundData {
+  if (bitDepth !== 8 && bitDepth !== 16 && bitDepth !== 32) {
+    throw new Error(`Invalid bit depth: ${bitDepth} (expected 8, 16 or 32)`);
+  }
+  const view = _newDataBlock(samples * channels * (bitDepth / 8));
+  if (bitDepth === 8) view.fill(128);
+  return _wrapSound(view, channels, rate, bitDepth);
+}
+
+/** Create a ByteData in shared memory: it crosses channels and threads without copying. */
+export function newByteData(sizeOrData: number | Uint8Array | string): ByteData {
+  const src = typeof sizeOrData === "string" ? _encoder.encode(sizeOrData) : typeof sizeOrData === "number" ? null : sizeOrData;
+  const view = _newDataBlock(src ? src.length : Math.max(0, sizeOrData as number));
+  if (src) view.set(src);
+  return _wrapByteData(view);
+}
+
+/**
+ * Return a shared copy of an ImageData, SoundData or ByteData (or the object itself if it
+ * is already shared), so that sending it on afterwards costs no copy.
+ */
+export function share<T extends ImageData | SoundData | ByteData>(data: T): T {
+  _ensureHeap();
+  const bytes = _dataBytes(data);
+  if (_dataBlockOf(bytes)) return data;
+  const view = _newDataBlock(bytes.length);
+  view.set(bytes);
+  return _rewrap(data, view) as T;
+}
+
+function _dataBytes(data: ImageData | SoundData | ByteData): Uint8Array {
+  if (data instanceof ByteData) return data._data;
+  return "_bitDepth" in data ? data._data : data.data;
+}
+
+function _rewrap(data: ImageData | SoundData | ByteData, view: Uint8Array): ImageData | SoundData | ByteData {
+  if (data instanceof ByteData) return _wrapByteData(view);
+  if ("_bitDepth" in data) return _wrapSound(view, data._channels, data._sampleRate, data._bitDepth);
+  return _wrapImage(view, data.width, data.height);
+}
+
+// ============================================================
+// Messages
+// ============================================================
+
+// Values are encoded into a message block; shared objects are stored as block offsets
+const T_UNDEFINED = 0;
+const T_NULL = 1;
+const T_FALSE = 2;
+const T_TRUE = 3;
+const T_NUMBER = 4;
+const T_STRING = 5;
+const T_ARRAY = 6;
+const T_OBJECT = 7;
+const T_IMAGE = 8;
+const T_SOUND = 9;
+const T_BYTES = 10;
+const T_CHANNEL = 11;
+
+const _encoder = new TextEncoder();
+const _decoder = new TextDecoder();
+let _w = new Uint8Array(256);
+let _wv = new DataView(_w.buffer);
+let _wlen = 0;
+// Blocks referenced by the message being written (released if encoding fails)
+const _wrefs: number[] = [];
+
+function _reserve(n: number): void {
+  if (_wlen + n <= _w.length) return;
+  const grown = new Uint8Array(Math.max(_wlen + n, _w.length * 2));
+  grown.set(_w.subarray(0, _wlen));
+  _w = grown;
+  _wv = new DataView(grown.buffer);
+}
+
+function _writeU8(v: number): void {
+  _reserve(1);
+  _w[_wlen++] = v;
+}
+
+function _writeU32(v: number): void {
+  _reserve(4);
+  _wv.setUint32(_wlen, v, true);
+  _wlen += 4;
+}
+
+function _writeString(s: string): void {
+  _reserve(4 + s.length * 3);
+  const { written } = _encoder.encodeInto(s, _w.subarray(_wlen + 4));
+  _wv.setUint32(_wlen, written, true);
+  _wlen += 4 + written;
+}
+
+/** Reference a data object's block from the message, copying it into the heap if needed. */
+function _writeData(bytes: Uint8Array): void {
+  let block = _dataBlockOf(bytes);
+  if (block) {
+    _retain(block);
+  } else {
+    block = _alloc(bytes.length, KIND_DATA);
+    _u8.set(bytes, _payload(block));
+  }
+  _wrefs.push(block);
+  _writeU32(block);
+}
+
+function _write(value: unknown, depth: number): void {
+  if (depth > 64) throw new TypeError("jove.thread: value is nested too deeply");
+  if (value === undefined) return _writeU8(T_UNDEFINED);
+  if (value === null) return _writeU8(T_NULL);
+  switch (typeof value) {
+    case "boolean":
+      return _writeU8(value ? T_TRUE : T_FALSE);
+    case "number":
+      _writeU8(T_NUMBER);
+      _reserve(8);
+      _wv.setFloat64(_wlen, value, true);
+      _wlen += 8;
+      return;
+    case "string":
+      _writeU8(T_STRING);
+      return _writeString(value);
+  }
+  if (Array.isArray(value)) {
+    _writeU8(T_ARRAY);
+    _writeU32(value.length);
+    for (const item of value) _write(item, depth + 1);
+    return;
+  }
+  if (typeof value === "object") {
+    const v = value as Record<string, any>;
+    if (v._isChannel === true) {
+      _writeU8(T_CHANNEL);
+      _retain(v._block);
+      _wrefs.push(v._block);
+      return _writeU32(v._block);
+    }
+    if (v instanceof ByteData) {
+      _writeU8(T_BYTES);
+      return _writeData(v._data);
+    }
+    if (v._data instanceof Uint8Array && typeof v._bitDepth === "number") {
+      _writeU8(T_SOUND);
+      _writeData(v._data);
+      _writeU8(v._bitDepth);
+      _writeU8(v._channels);
+      return _writeU32(v._sampleRate);
+    }
+    if (v.data instanceof Uint8Array && v.format === "rgba8888") {
+      _writeU8(T_IMAGE);
+      _writeData(v.data);
+      _writeU32(v.width);
+      return _writeU32(v.height);
+    }
+    const proto = Object.getPrototypeOf(v);
+    if (proto === Object.prototype || proto === null) {
+      const keys = Object.keys(v);
+      _writeU8(T_OBJECT);
+      _writeU32(keys.length);
+      for (const key of keys) {
+        _writeString(key);
+        _write(v[key], depth + 1);
+      }
+      return;
+    }
+  }
+  throw new TypeError(`jove.thread: can't send a value of type ${typeof value === "object" ? (value as object).constructor?.name ?? "object" : typeof value}`);
+}
+
+/** Encode `value` into a new message block. */
+export function _encodeMessage(value: unknown): number {
+  _ensureHeap();
+  _wlen = 0;
+  _wrefs.length = 0;
+  try {
+    _write(value, 0);
+  } catch (err) {
+    for (const block of _wrefs) _release(block);
+    throw err;
+  }
+  let block: number;
+  try {
+    block = _alloc(_wlen, KIND_MESSAGE);
+  } catch (err) {
+    for (const ref of _wrefs) _release(ref);
+    throw err;
+  } finally {
+    _wrefs.length = 0;
+  }
+  _u8.set(_w.subarray(0, _wlen), _payload(block));
+  return block;
+}
+
+// Read modes: a peek takes new references for the views it makes, a take hands the
+// message's references to them, and a drop releases them.
+export const READ_PEEK = 0;
+const READ_TAKE = 1;
+const READ_DROP = 2;
+
+let _rpos = 0;
+
+function _readShared(mode: number): number {
+  const block = _dv.getUint32(_rpos, true);
+  _rpos += 4;
+  if (mode === READ_PEEK) _retain(block);
+  else if (mode === READ_DROP) _release(block);
+  return block;
+}
+
+function _readString(): string {
+  const n = _dv.getUint32(_rpos, true);
+  // TextDecoder can't read shared memory directly
+  const s = _decoder.decode(_u8.slice(_rpos + 4, _rpos + 4 + n));
+  _rpos += 4 + n;
+  return s;
+}
+
+function _read(mode: number): unknown {
+  const tag = _u8[_rpos++];
+  switch (tag) {
+    case T_UNDEFINED: return undefined;
+    case T_NULL: return null;
+    case T_FALSE: return false;
+    case T_TRUE: return true;
+    case T_NUMBER: {
+      const v = _dv.getFloat64(_rpos, true);
+      _rpos += 8;
+      return v;
+    }
+    case T_STRING:
+      return _readString();
+    case T_ARRAY: {
+      const n = _dv.getUint32(_rpos, true);
+      _rpos += 4;
+      const out: unknown[] = new Array(n);
+      for (let i = 0; i < n; i++) out[i] = _read(mode);
+      return out;
+    }
+    case T_OBJECT: {
+      const n = _dv.getUint32(_rpos, true);
+      _rpos += 4;
+      const out: Record<string, unknown> = {};
+      for (let i = 0; i < n; i++) {
+        const key = _readString();
+        out[key] = _read(mode);
+      }
+      return out;
+    }
+    case T_BYTES: {
+      const block = _readShared(mode);
+      return mode === READ_DROP ? undefined : _wrapByteData(_dataView(block));
+    }
+    case T_SOUND: {
+      const block = _readShared(mode);
+      const bitDepth = _u8[_rpos]!, channels = _u8[_rpos + 1]!;
+      const rate = _dv.getUint32(_rpos + 2, true);
+      _rpos += 6;
+      return mode === READ_DROP ? undefined : _wrapSound(_dataView(block), channels, rate, bitDepth);
+    }
+    case T_IMAGE: {
+      const block = _readShared(mode);
+      const width = _dv.getUint32(_rpos, true), height = _dv.getUint32(_rpos + 4, true);
+      _rpos += 8;
+      return mode === READ_DROP ? undefined : _wrapImage(_dataView(block), width, height);
+    }
+    case T_CHANNEL: {
+      const block = _readShared(mode);
+      return mode === READ_DROP ? undefined : _channelView(block);
+    }
+  }
+  throw new Error(`jove.thread: corrupt message (tag ${tag})`);
+}
+
+export function _readMessage(block: number, mode: number): unknown {
+  // Reads nest: dropping a message that holds the last reference to a channel drops the
+  // channel's queued messages from inside this read, so the cursor must be restored
+  const saved = _rpos;
+  _rpos = _payload(block);
+  try {
+    return _read(mode);
+  } finally {
+    _rpos = saved;
+  }
+}
+
+/** Decode a message and free it, handing its references to the returned views. */
+function _takeMessage(block: number): unknown {
+  const value = _readMessage(block, READ_TAKE);
+  _free(block);
+  return value;
+}
+
+/** Release what an unread message references (its block is freed by the caller). */
+function _dropMessage(block: number): void {
+  _readMessage(block, READ_DROP);
+}
+
+// ============================================================
+// Channels
+// ============================================================
+
+// Channel payload (Int32 slots)
+const C_LOCK = 0;
+const C_COUNT = 1;
+const C_HEAD = 2;
+const C_CAP = 3;
+const C_QUEUE = 4; // queue block: ring of message block offsets
+const C_PUSHED = 5; // id of the last pushed message
+const C_READ = 6; // messages read (or cleared) so far
+const C_SEQ = 7; // bumped on every push and read; demand/supply wait on it
+const CHANNEL_BYTES = 32;
+const QUEUE_INITIAL = 16;
+
+export interface Channel {
+  _isChannel: true;
+  /** @internal — channel block in the shared heap */
+  _block: number;
+  /** Add a value to the end of the queue. Returns its id for hasRead(). */
+  push(value: unknown): number;
+  /** Remove and return the first value, or undefined if the queue is empty. */
+  pop(): unknown;
+  /** Like pop(), but wait up to `timeout` seconds (forever if omitted) for a value. */
+  demand(timeout?: number): unknown;
+  /** Return the first value without removing it. */
+  peek(): unknown;
+  /** push(), then wait up to `timeout` seconds (forever if omitted) until it is read. */
+  supply(value: unknown, timeout?: number): boolean;
+  /** Whether the value pushed with `id` has been read. */
+  hasRead(id: number): boolean;
+  getCount(): number;
+  clear(): void;
+}
+
+function _channelView(block: number): Channel {
+  const c = _payload(block) >> 2;
+
+  /** Remove the head message under the channel lock. Returns 0 when empty. */
+  function _shift(): number {
+    _lock(_i32, c + C_LOCK);
+    const count = _i32[c + C_COUNT]!;
+    if (count === 0) {
+      _unlock(_i32, c + C_LOCK);
+      return 0;
+    }
+    const head = _i32[c + C_HEAD]!;
+    const msg = _i32[(_payload(_i32[c + C_QUEUE]!) >> 2) + head]!;
+    _i32[c + C_HEAD] = (head + 1) % _i32[c + C_CAP]!;
+    _i32[c + C_COUNT] = count - 1;
+    _i32[c + C_READ] = _i32[c + C_READ]! + 1;
+    Atomics.add(_i32, c + C_SEQ, 1);
+    _unlock(_i32, c + C_LOCK);
+    Atomics.notify(_i32, c + C_SEQ);
+    return msg;
+  }
+
+  /** Wait until the sequence word moves past `seq` or `deadline` passes. False on timeout. */
+  function _waitSeq(seq: number, deadline: number): boolean {
+    const remaining = deadline - performance.now();
+    if (remaining <= 0) return false;
+    Atomics.wait(_i32, c + C_SEQ, seq, remaining === Infinity ? undefined : remaining);
+    return true;
+  }
+
+  const channel: Channel = {
+    _isChannel: true as const,
+    _block: block,
+
+    push(value: unknown): number {
+      const msg = _encodeMessage(value);
+      _lock(_i32, c + C_LOCK);
+      try {
+        let cap = _i32[c + C_CAP]!;
+        const count = _i32[c + C_COUNT]!;
+        if (count === cap) {
+          // Grow the ring, unwrapping it into the new queue
+          const oldQueue = _i32[c + C_QUEUE]!;
+          const queue = _alloc((cap * 2) << 2, KIND_QUEUE);
+          const from = _payload(oldQueue) >> 2, to = _payload(queue) >> 2;
+          const head = _i32[c + C_HEAD]!;
+          for (let i = 0; i < count; i++) _i32[to + i] = _i32[from + ((head + i) % cap)]!;
+          _free(oldQueue);
+          cap *= 2;
+          _i32[c + C_QUEUE] = queue;
+          _i32[c + C_CAP] = cap;
+          _i32[c + C_HEAD] = 0;
+        }
+        const q = _payload(_i32[c + C_QUEUE]!) >> 2;
+        _i32[q + ((_i32[c + C_HEAD]! + count) % cap)] = msg;
+        _i32[c + C_COUNT] = count + 1;
+        const id = _i32[c + C_PUSHED]! + 1;
+        _i32[c + C_PUSHED] = id;
+        Atomics.add(_i32, c + C_SEQ, 1);
+        return id;
+      } finally {
+        _unlock(_i32, c + C_LOCK);
+        Atomics.notify(_i32, c + C_SEQ);
+      }
+    },
+
+    pop(): unknown {
+      const msg = _shift();
+      return msg ? _takeMessage(msg) : undefined;
+    },
+
+    demand(timeout?: number): unknown {
+      const deadline = timeout === undefined ? Infinity : performance.now() + Math.max(0, timeout) * 1000;
+      for (;;) {
+        const seq = Atomics.load(_i32, c + C_SEQ);
+        const msg = _shift();
+        if (msg) return _takeMessage(msg);
+        if (!_waitSeq(seq, deadline)) return undefined;
+      }
+    },
+
+    peek(): unknown {
+      _lock(_i32, c + C_LOCK);
+      try {
+        if (_i32[c + C_COUNT] === 0) return undefined;
+        const msg = _i32[(_payload(_i32[c + C_QUEUE]!) >> 2) + _i32[c + C_HEAD]!]!;
+        return _readMessage(msg, READ_PEEK);
+      } finally {
+        _unlock(_i32, c + C_LOCK);
+      }
+    },
+
+    supply(value: unknown, timeout?: number): boolean {
+      const deadline = timeout === undefined ? Infinity : performance.now() + Math.max(0, timeout) * 1000;
+      const id = channel.push(value);
+      for (;;) {
+        const seq = Atomics.load(_i32, c + C_SEQ);
+        if (channel.hasRead(id)) return true;
+        if (!_waitSeq(seq, deadline)) return channel.hasRead(id);
+      }
+    },
+
+    hasRead(id: number): boolean {
+      return Atomics.load(_i32, c + C_READ) >= id;
+    },
+
+    getCount(): number {
+      return Atomics.load(_i32, c + C_COUNT);
+    },
+
+    clear(): void {
+      const msgs: number[] = [];
+      _lock(_i32, c + C_LOCK);
+      const count = _i32[c + C_COUNT]!, cap = _i32[c + C_CAP]!, head = _i32[c + C_HEAD]!;
+      const q = _payload(_i32[c + C_QUEUE]!) >> 2;
+      for (let i = 0; i < count; i++) msgs.push(_i32[q + ((head + i) % cap)]!);
+      _i32[c + C_COUNT] = 0;
+      _i32[c + C_HEAD] = 0;
+      _i32[c + C_READ] = _i32[c + C_PUSHED]!; // cleared values count as read for supply()
+      Atomics.add(_i32, c + C_SEQ, 1);
+      _unlock(_i32, c + C_LOCK);
+      Atomics.notify(_i32, c + C_SEQ);
+      for (const msg of msgs) _release(msg);
+    },
+  };
+  _track(channel, block);
+  return channel;
+}
+
+function _newChannelBlock(): number {
+  const block = _alloc(CHANNEL_BYTES, KIND_CHANNEL);
+  const c = _payload(block) >> 2;
+  _i32[c + C_QUEUE] = _alloc(QUEUE_INITIAL << 2, KIND_QUEUE);
+  _i32[c + C_CAP] = QUEUE_INITIAL;
+  return block;
+}
+
+/** Release a channel's unread messages and its queue (its block is freed by the caller). */
+function _dropChannel(block: number): void {
+  const c = _payload(block) >> 2;
+  const count = _i32[c + C_COUNT]!, cap = _i32[c + C_CAP]!, head = _i32[c + C_HEAD]!;
+  const q = _payload(_i32[c + C_QUEUE]!) >> 2;
+  for (let i = 0; i < count; i++) _release(_i32[q + ((head + i) % cap)]!);
+  _free(_i32[c + C_QUEUE]!);
+}
+
+/** Create an unnamed channel. Pass it to a thread through start() or another channel. */
+export function newChannel(): Channel {
+  _ensureHeap();
+  return _channelView(_newChannelBlock());
+}
+
+// Named-channel entry payload: next entry, channel block, name byte length, name bytes
+const N_NEXT = 0;
+const N_CHANNEL = 1;
+const N_LENGTH = 2;
+const NAME_HEADER = 12;
+
+/** Get the channel called `name`, creating it on first use. Every thread sees the same one. */
+export function getChannel(name: string): Channel {
+  _ensureHeap();
+  const bytes = _encoder.encode(name);
+  _lock(_i32, H_NAMES_LOCK);
+  try {
+    for (let entry = _i32[H_NAMES]!; entry !== 0; entry = _i32[(_payload(entry) >> 2) + N_NEXT]!) {
+      const e = _payload(entry) >> 2;
+      if (_i32[e + N_LENGTH] !== bytes.length) continue;
+      const at = _payload(entry) + NAME_HEADER;
+      let same = true;
+      for (let i = 0; i < bytes.length && same; i++) same = _u8[at + i] === bytes[i];
+      if (!same) continue;
+      _retain(_i32[e + N_CHANNEL]!);
+      return _channelView(_i32[e + N_CHANNEL]!);
+    }
+    // Named channels live as long as the heap: the entry keeps one reference
+    const block = _newChannelBlock();
+    const entry = _alloc(NAME_HEADER + bytes.length, KIND_NAME);
+    const e = _payload(entry) >> 2;
+    _i32[e + N_NEXT] = _i32[H_NAMES]!;
+    _i32[e + N_CHANNEL] = block;
+    _i32[e + N_LENGTH] = bytes.length;
+    _u8.set(bytes, _payload(entry) + NAME_HEADER);
+    _i32[H_NAMES] = entry;
+    _retain(block);
+    return _channelView(block);
+  } finally {
+    _unlock(_i32, H_NAMES_LOCK);
+  }
+}
+
+// ============================================================
+// Threads
+// ============================================================
+
+// Thread payload (Int32 slots)
+const TH_STATE = 0; // 0 = not started, 1 = running, 2 = finished
+const TH_ARGS = 1; // message block of start() arguments, taken by the thread
+const TH_ERROR = 2; // message block of the error string, 0 = none
+const THREAD_BYTES = 12;
+
+const STATE_IDLE = 0;
+const STATE_RUNNING = 1;
+const STATE_DONE = 2;
+
+export interface Thread {
+  /**
+   * Run the thread's file in a new Worker. If the module's default export is a function,
+   * it is called with `args` (shared data and channels arrive as views, not copies).
+   * Returns false if the thread is already running.
+   */
+  start(...args: unknown[]): boolean;
+  /** Block until the thread finishes. */
+  wait(): void;
+  isRunning(): boolean;
+  /** The error that ended the thread, or null. */
+  getError(): string | null;
+  /** Drop this handle. A running thread is not stopped; it runs until its function returns. */
+  release(): void;
+}
+
+function _dropThread(block: number): void {
+  const t = _payload(block) >> 2;
+  if (_i32[t + TH_ARGS]) _release(_i32[t + TH_ARGS]!);
+  if (_i32[t + TH_ERROR]) _release(_i32[t + TH_ERROR]!);
+}
+
+/** Store `message` as the thread's error. */
+function _setThreadError(t: number, message: string): void {
+  if (_i32[t + TH_ERROR]) return;
+  _i32[t + TH_ERROR] = _encodeMessage(message);
+}
+
+/** Mark the thread finished. False if it already was (the Worker failed and reported it). */
+function _finishThread(t: number): boolean {
+  if (Atomics.compareExchange(_i32, t + TH_STATE, STATE_RUNNING, STATE_DONE) !== STATE_RUNNING) return false;
+  Atomics.notify(_i32, t + TH_STATE);
+  return true;
+}
+
+/** Create a thread that runs `file` (a module path, relative to the working directory). */
+export function newThread(file: string): Thread {
+  _ensureHeap();
+  const path = resolve(file);
+  const block = _alloc(THREAD_BYTES, KIND_THREAD);
+  const t = _payload(block) >> 2;
+  let worker: Worker | null = null;
+
+  const thread: Thread = {
+    start(...args: unknown[]): boolean {
+      if (Atomics.load(_i32, t + TH_STATE) === STATE_RUNNING) return false;
+      if (_i32[t + TH_ERROR]) {
+        _release(_i32[t + TH_ERROR]!);
+        _i32[t + TH_ERROR] = 0;
+      }
+      if (_i32[t + TH_ARGS]) _release(_i32[t + TH_ARGS]!);
+      _i32[t + TH_ARGS] = _encodeMessage(args);
+      Atomics.store(_i32, t + TH_STATE, STATE_RUNNING);
+      _retain(block); // held by the running thread until it finishes
+      worker = new Worker(new URL("./thread-worker.ts", import.meta.url).href);
+      worker.addEventListener("error", (event) => {
+        // The bootstrap reports the thread's own errors; this catches the Worker failing
+        if (Atomics.load(_i32, t + TH_STATE) !== STATE_RUNNING) return;
+        _setThreadError(t, (event as ErrorEvent).message ?? "Worker error");
+        if (_finishThread(t)) _release(block);
+      });
+      worker.postMessage({ heap: _heap, block, file: path });
+      worker.unref(); // a running thread doesn't keep the game process alive
+      return true;
+    },
+
+    wait(): void {
+      while (Atomics.load(_i32, t + TH_STATE) === STATE_RUNNING) {
+        Atomics.wait(_i32, t + TH_STATE, STATE_RUNNING);
+      }
+    },
+
+    isRunning(): boolean {
+      return Atomics.load(_i32, t + TH_STATE) === STATE_RUNNING;
+    },
+
+    getError(): string | null {
+      const msg = _i32[t + TH_ERROR];
+      return msg ? (_readMessage(msg, READ_PEEK) as string) : null;
+    },
+
+    release(): void {
+      // Never terminate: a Worker killed while holding a heap or channel lock would leave
+      // every other thread blocked on it
+      worker = null;
+    },
+  };
+  _track(thread, block);
+  return thread;
+}
+
+/** Worker side: take the start() arguments, run the module, and record how it ended. */
+export async function _runThread(block: number, file: string): Promise<void> {
+  const t = _payload(block) >> 2;
+  const argsMsg = _i32[t + TH_ARGS]!;
+  _i32[t + TH_ARGS] = 0;
+  try {
+    const args = _takeMessage(argsMsg) as unknown[];
+    const mod = await import(file);
+    if (typeof mod.default === "function") await mod.default(...args);
+  } catch (err) {
+    _setThreadError(t, err instanceof Error ? (err.stack ?? err.message) : String(err));
+  } finally {
+    _releaseViews(); // the Worker exits next, before any finalizer could run
+    if (_finishThread(t)) _release(block);
+  }
+}
+
+/** Whether this is the main thread (not a thread started with newThread). */
+export function isMainThread(): boolean {
+  return _isMainThread;
+}
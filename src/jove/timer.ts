@@ -23,10 +23,13 @@ export function _init(): void {
   _dtHistory.length = 0;
 }
 
-/** Advance the timer by one frame. Called internally by the game loop. Returns dt. */
-export function step(): number {
+/**
+ * Advance the timer by one frame. Called internally by the game loop. Returns dt.
+ * Pass `fixedDt` to use it instead of the measured time (input playback).
+ */
+export function step(fixedDt?: number): number {
   const now = performance.now() / 1000;
-  _dt = now - _lastTime;
+  _dt = fixedDt ?? now - _lastTime;
   _lastTime = now;
 
   // Track dt history for getAverageDelta
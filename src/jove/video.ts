@@ -12,6 +12,7 @@ import {
 } from "../sdl/types.ts";
 import { _ensureDevice, _getDeviceId } from "./audio.ts";
 import { _getRenderer } from "./graphics.ts";
+import { _flushCommands, _forgetTexture } from "./graphics-commands.ts";
 
 type SDLTexture = Pointer;
 
@@ -188,6 +189,7 @@ export function newVideo(path: string, options?: { audio?: boolean }): Video | n
       internal.filterMin = min;
       internal.filterMag = mag;
       const mode = mag === "linear" ? 1 : 0;
+      _flushCommands();
       sdl.SDL_SetTextureScaleMode(video._texture, mode);
     },
 
@@ -213,6 +215,8 @@ export function newVideo(path: string, options?: { audio?: boolean }): Video | n
         internal.audioStream = null;
       }
       if (video._texture) {
+        _flushCommands();
+        _forgetTexture(video._texture);
         sdl.SDL_DestroyTexture(video._texture);
       }
       vlib.jove_video_close(idx);
@@ -254,6 +258,8 @@ export function _updateVideos(dt: number): void {
             const mode = internal.filterMag === "linear" ? 1 : 0;
             sdl.SDL_SetTextureScaleMode(newTex, mode);
             // Swap textures
+            _flushCommands();
+            _forgetTexture(video._texture);
             sdl.SDL_DestroyTexture(video._texture);
             video._texture = newTex;
           }
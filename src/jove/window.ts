@@ -23,6 +23,7 @@ import {
 } from "../sdl/types.ts";
 import type { WindowFlags, WindowMode } from "./types.ts";
 import { _getRenderer } from "./graphics.ts";
+import { _flushCommands } from "./graphics-commands.ts";
 import { SDL_PIXELFORMAT_ABGR8888 } from "../sdl/types.ts";
 
 // Pre-allocated out-param buffers to avoid per-call allocation.
@@ -490,6 +491,7 @@ export function updateMode(
   // Update logical presentation to match new logical size
   const renderer = _getRenderer();
   if (renderer) {
+    _flushCommands();
     sdl.SDL_SetRenderLogicalPresentation(renderer, width, height, SDL_LOGICAL_PRESENTATION_LETTERBOX);
   }
 
@@ -204,6 +204,11 @@ const { symbols: sdl } = dlopen(libPath("SDL3", "SDL3"), {
     args: [FFIType.pointer],
     returns: FFIType.bool,
   },
+  // bool SDL_WaitEventTimeout(SDL_Event* event, Sint32 timeoutMS)
+  SDL_WaitEventTimeout: {
+    args: [FFIType.pointer, FFIType.i32],
+    returns: FFIType.bool,
+  },
 
   // --- Surface / Screenshot ---
 
@@ -574,6 +579,11 @@ const { symbols: sdl } = dlopen(libPath("SDL3", "SDL3"), {
     args: [FFIType.pointer, FFIType.pointer, FFIType.pointer],
     returns: FFIType.bool,
   },
+  // bool SDL_SetRenderScale(SDL_Renderer* renderer, float scaleX, float scaleY)
+  SDL_SetRenderScale: {
+    args: [FFIType.pointer, FFIType.f32, FFIType.f32],
+    returns: FFIType.bool,
+  },
   // bool SDL_SetRenderLogicalPresentation(SDL_Renderer* renderer, int w, int h, SDL_RendererLogicalPresentation mode)
   SDL_SetRenderLogicalPresentation: {
     args: [FFIType.pointer, FFIType.i32, FFIType.i32, FFIType.i32],
@@ -728,6 +738,29 @@ const { symbols: sdl } = dlopen(libPath("SDL3", "SDL3"), {
     args: [FFIType.pointer],
     returns: FFIType.i32,
   },
+  // int SDL_GetAudioStreamQueued(SDL_AudioStream* stream)
+  SDL_GetAudioStreamQueued: {
+    args: [FFIType.pointer],
+    returns: FFIType.i32,
+  },
+  // const char* SDL_GetCurrentAudioDriver(void)
+  SDL_GetCurrentAudioDriver: {
+    args: [],
+    returns: FFIType.cstring,
+  },
+
+  // --- Hints ---
+
+  // bool SDL_SetHint(const char* name, const char* value)
+  SDL_SetHint: {
+    args: [FFIType.cstring, FFIType.cstring],
+    returns: FFIType.bool,
+  },
+  // bool SDL_ResetHint(const char* name)
+  SDL_ResetHint: {
+    args: [FFIType.cstring],
+    returns: FFIType.bool,
+  },
 
   // --- Memory ---
 
@@ -19,6 +19,34 @@ function _load() {
       args: [FFIType.pointer],
       returns: FFIType.void,
     },
+    // int jove_audio_decode_memory(const void* data, int size, int16_t** out_data, int* out_ch, int* out_rate)
+    jove_audio_decode_memory: {
+      args: [FFIType.pointer, FFIType.i32, FFIType.pointer, FFIType.pointer, FFIType.pointer],
+      returns: FFIType.i32,
+    },
+
+    // --- Background decode jobs ---
+
+    // int jove_audio_job_start(const void* data, int size)
+    jove_audio_job_start: {
+      args: [FFIType.pointer, FFIType.i32],
+      returns: FFIType.i32,
+    },
+    // int jove_audio_job_poll(int idx)
+    jove_audio_job_poll: {
+      args: [FFIType.i32],
+      returns: FFIType.i32,
+    },
+    // int jove_audio_job_take(int idx, int16_t** out_data, int* out_ch, int* out_rate)
+    jove_audio_job_take: {
+      args: [FFIType.i32, FFIType.pointer, FFIType.pointer, FFIType.pointer],
+      returns: FFIType.i32,
+    },
+    // void jove_audio_job_cancel(int idx)
+    jove_audio_job_cancel: {
+      args: [FFIType.i32],
+      returns: FFIType.void,
+    },
 
     // --- Streaming Decoder API ---
 
@@ -37,6 +65,11 @@ function _load() {
       args: [FFIType.i32, FFIType.i32],
       returns: FFIType.i64,
     },
+    // int jove_decoder_fill(int idx, int max_frames)
+    jove_decoder_fill: {
+      args: [FFIType.i32, FFIType.i32],
+      returns: FFIType.i32,
+    },
     // void jove_decoder_seek(int idx, int64_t frame)
     jove_decoder_seek: {
       args: [FFIType.i32, FFIType.i64],
@@ -57,6 +90,11 @@ function _load() {
       args: [],
       returns: FFIType.pointer,
     },
+    // int jove_decoder_get_buf_samples()
+    jove_decoder_get_buf_samples: {
+      args: [],
+      returns: FFIType.i32,
+    },
   });
   return symbols;
 }
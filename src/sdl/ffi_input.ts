@@ -0,0 +1,53 @@
+// Native input helper FFI bindings (jove_input — bulk joystick/gamepad reads) via bun:ffi
+// Separate from ffi.ts so the engine works even without the input lib installed.
+
+import { dlopen, FFIType } from "bun:ffi";
+import { libPath } from "./lib-path";
+
+let lib: ReturnType<typeof _load> | null = null;
+let _tried = false;
+
+function _load() {
+  const { symbols } = dlopen(libPath("jove_input", "jove_input"), {
+    // int jove_input_poll_joysticks(const uint32_t* ids, int count,
+    //     int gamepad_axes, int joystick_axes,
+    //     int gamepad_buttons, int joystick_buttons, int joystick_hats)
+    jove_input_poll_joysticks: {
+      args: [
+        FFIType.pointer, FFIType.i32,
+        FFIType.i32, FFIType.i32,
+        FFIType.i32, FFIType.i32, FFIType.i32,
+      ],
+      returns: FFIType.i32,
+    },
+    // void* jove_input_get_buffers(void) — pointer table: axes, buttons, hats
+    jove_input_get_buffers: {
+      args: [],
+      returns: FFIType.pointer,
+    },
+    // int jove_input_get_max_joysticks(void)
+    jove_input_get_max_joysticks: {
+      args: [],
+      returns: FFIType.i32,
+    },
+  });
+  return symbols;
+}
+
+/**
+ * Try to load the native input helper. Returns the symbols or null if unavailable.
+ * Safe to call multiple times — caches the result.
+ */
+export function loadInput(): typeof lib {
+  if (_tried) return lib;
+  _tried = true;
+  try {
+    lib = _load();
+  } catch {
+    // Input lib not available — joystick snapshots fall back to per-value SDL calls
+    lib = null;
+  }
+  return lib;
+}
+
+export default loadInput;
@@ -0,0 +1,277 @@
+// Native audio mixer FFI bindings (jove_mixer — voices, filters, effects) via bun:ffi
+// Separate from ffi.ts so the engine works even without the mixer lib installed.
+
+import { dlopen, FFIType } from "bun:ffi";
+import { libPath } from "./lib-path";
+
+let lib: ReturnType<typeof _load> | null = null;
+let _tried = false;
+
+function _load() {
+  const { symbols } = dlopen(libPath("audio_mixer", "jove_mixer"), {
+    // --- Lifecycle ---
+
+    // int jove_mixer_open(uint32_t device)
+    jove_mixer_open: {
+      args: [FFIType.u32],
+      returns: FFIType.i32,
+    },
+    // int jove_mixer_open_offline(int rate)
+    jove_mixer_open_offline: {
+      args: [FFIType.i32],
+      returns: FFIType.i32,
+    },
+    // const float* jove_mixer_render_offline(int frames)
+    jove_mixer_render_offline: {
+      args: [FFIType.i32],
+      returns: FFIType.pointer,
+    },
+    // void jove_mixer_close()
+    jove_mixer_close: {
+      args: [],
+      returns: FFIType.void,
+    },
+    // int jove_mixer_get_rate()
+    jove_mixer_get_rate: {
+      args: [],
+      returns: FFIType.i32,
+    },
+    // double jove_mixer_get_clock()
+    jove_mixer_get_clock: {
+      args: [],
+      returns: FFIType.f64,
+    },
+    // int jove_mixer_get_queued_frames()
+    jove_mixer_get_queued_frames: {
+      args: [],
+      returns: FFIType.i32,
+    },
+    // int jove_mixer_get_max_effects()
+    jove_mixer_get_max_effects: {
+      args: [],
+      returns: FFIType.i32,
+    },
+    // int jove_mixer_get_max_sends()
+    jove_mixer_get_max_sends: {
+      args: [],
+      returns: FFIType.i32,
+    },
+
+    // --- Buffers ---
+
+    // int jove_mixer_buffer_create(const void* pcm, int bytes, int format, int channels, int rate)
+    jove_mixer_buffer_create: {
+      args: [FFIType.pointer, FFIType.i32, FFIType.i32, FFIType.i32, FFIType.i32],
+      returns: FFIType.i32,
+    },
+    // void jove_mixer_buffer_free(int idx)
+    jove_mixer_buffer_free: {
+      args: [FFIType.i32],
+      returns: FFIType.void,
+    },
+    // int jove_mixer_buffer_get_frames(int idx)
+    jove_mixer_buffer_get_frames: {
+      args: [FFIType.i32],
+      returns: FFIType.i32,
+    },
+    // const int16_t* jove_mixer_buffer_get_data(int idx)
+    jove_mixer_buffer_get_data: {
+      args: [FFIType.i32],
+      returns: FFIType.pointer,
+    },
+
+    // --- Voices ---
+
+    // int jove_mixer_voice_create(int buffer)
+    jove_mixer_voice_create: {
+      args: [FFIType.i32],
+      returns: FFIType.i32,
+    },
+    // void jove_mixer_voice_free(int idx)
+    jove_mixer_voice_free: {
+      args: [FFIType.i32],
+      returns: FFIType.void,
+    },
+    // void jove_mixer_voice_play(int idx, int seq)
+    jove_mixer_voice_play: {
+      args: [FFIType.i32, FFIType.i32],
+      returns: FFIType.void,
+    },
+    // void jove_mixer_voice_play_at(int idx, int seq, double clock)
+    jove_mixer_voice_play_at: {
+      args: [FFIType.i32, FFIType.i32, FFIType.f64],
+      returns: FFIType.void,
+    },
+    // void jove_mixer_voice_pause(int idx)
+    jove_mixer_voice_pause: {
+      args: [FFIType.i32],
+      returns: FFIType.void,
+    },
+    // void jove_mixer_voice_stop(int idx)
+    jove_mixer_voice_stop: {
+      args: [FFIType.i32],
+      returns: FFIType.void,
+    },
+    // void jove_mixer_voice_seek(int idx, double frame)
+    jove_mixer_voice_seek: {
+      args: [FFIType.i32, FFIType.f64],
+      returns: FFIType.void,
+    },
+    // void jove_mixer_voice_set_gain(int idx, float gain)
+    jove_mixer_voice_set_gain: {
+      args: [FFIType.i32, FFIType.f32],
+      returns: FFIType.void,
+    },
+    // void jove_mixer_voice_set_pitch(int idx, float pitch)
+    jove_mixer_voice_set_pitch: {
+      args: [FFIType.i32, FFIType.f32],
+      returns: FFIType.void,
+    },
+    // void jove_mixer_voice_set_looping(int idx, int looping)
+    jove_mixer_voice_set_looping: {
+      args: [FFIType.i32, FFIType.i32],
+      returns: FFIType.void,
+    },
+    // void jove_mixer_voice_set_loop_points(int idx, double start, double end)
+    jove_mixer_voice_set_loop_points: {
+      args: [FFIType.i32, FFIType.f64, FFIType.f64],
+      returns: FFIType.void,
+    },
+    // void jove_mixer_voice_set_filter(int idx, int type, float volume, float lowgain, float highgain, float freq, float q)
+    jove_mixer_voice_set_filter: {
+      args: [FFIType.i32, FFIType.i32, FFIType.f32, FFIType.f32, FFIType.f32, FFIType.f32, FFIType.f32],
+      returns: FFIType.void,
+    },
+    // void jove_mixer_voice_set_send(int idx, int slot, int effect, int filter_type,
+    //                                float volume, float lowgain, float highgain, float freq, float q)
+    jove_mixer_voice_set_send: {
+      args: [
+        FFIType.i32, FFIType.i32, FFIType.i32, FFIType.i32,
+        FFIType.f32, FFIType.f32, FFIType.f32, FFIType.f32, FFIType.f32,
+      ],
+      returns: FFIType.void,
+    },
+    // int jove_mixer_voice_ended(int idx)
+    jove_mixer_voice_ended: {
+      args: [FFIType.i32],
+      returns: FFIType.i32,
+    },
+    // int32_t* jove_mixer_get_ended_table()
+    jove_mixer_get_ended_table: {
+      args: [],
+      returns: FFIType.pointer,
+    },
+    // int32_t* jove_mixer_get_ended_counter()
+    jove_mixer_get_ended_counter: {
+      args: [],
+      returns: FFIType.pointer,
+    },
+    // int jove_mixer_get_active_voice_count()
+    jove_mixer_get_active_voice_count: {
+      args: [],
+      returns: FFIType.i32,
+    },
+    // double jove_mixer_voice_tell(int idx)
+    jove_mixer_voice_tell: {
+      args: [FFIType.i32],
+      returns: FFIType.f64,
+    },
+
+    // --- Synth voices ---
+
+    // int jove_mixer_synth_create(int waveform)
+    jove_mixer_synth_create: {
+      args: [FFIType.i32],
+      returns: FFIType.i32,
+    },
+    // void jove_mixer_voice_set_waveform(int idx, int waveform, float pulse_width)
+    jove_mixer_voice_set_waveform: {
+      args: [FFIType.i32, FFIType.i32, FFIType.f32],
+      returns: FFIType.void,
+    },
+    // void jove_mixer_voice_set_frequency(int idx, float hz, float glide)
+    jove_mixer_voice_set_frequency: {
+      args: [FFIType.i32, FFIType.f32, FFIType.f32],
+      returns: FFIType.void,
+    },
+    // void jove_mixer_voice_set_envelope(int idx, int enabled, float attack, float decay, float sustain, float release)
+    jove_mixer_voice_set_envelope: {
+      args: [FFIType.i32, FFIType.i32, FFIType.f32, FFIType.f32, FFIType.f32, FFIType.f32],
+      returns: FFIType.void,
+    },
+    // void jove_mixer_voice_note_off(int idx, double clock)
+    jove_mixer_voice_note_off: {
+      args: [FFIType.i32, FFIType.f64],
+      returns: FFIType.void,
+    },
+
+    // --- Positional audio ---
+
+    // void jove_mixer_voice_set_position(int idx, float x, float y, float z)
+    jove_mixer_voice_set_position: {
+      args: [FFIType.i32, FFIType.f32, FFIType.f32, FFIType.f32],
+      returns: FFIType.void,
+    },
+    // void jove_mixer_voice_set_positions(const int* voices, const float* xyz, int count)
+    jove_mixer_voice_set_positions: {
+      args: [FFIType.pointer, FFIType.pointer, FFIType.i32],
+      returns: FFIType.void,
+    },
+    // void jove_mixer_voice_set_spatial(int idx, int relative, float ref_dist, float max_dist, float rolloff)
+    jove_mixer_voice_set_spatial: {
+      args: [FFIType.i32, FFIType.i32, FFIType.f32, FFIType.f32, FFIType.f32],
+      returns: FFIType.void,
+    },
+    // void jove_mixer_set_listener(float x, float y, float z, float fx, float fy, float fz, float ux, float uy, float uz)
+    jove_mixer_set_listener: {
+      args: [
+        FFIType.f32, FFIType.f32, FFIType.f32,
+        FFIType.f32, FFIType.f32, FFIType.f32,
+        FFIType.f32, FFIType.f32, FFIType.f32,
+      ],
+      returns: FFIType.void,
+    },
+    // void jove_mixer_set_distance_model(int model, int clamped)
+    jove_mixer_set_distance_model: {
+      args: [FFIType.i32, FFIType.i32],
+      returns: FFIType.void,
+    },
+
+    // --- Effects ---
+
+    // int jove_mixer_effect_create(int type)
+    jove_mixer_effect_create: {
+      args: [FFIType.i32],
+      returns: FFIType.i32,
+    },
+    // void jove_mixer_effect_free(int idx)
+    jove_mixer_effect_free: {
+      args: [FFIType.i32],
+      returns: FFIType.void,
+    },
+    // void jove_mixer_effect_set_params(int idx, float p0, float p1, float p2, float p3, float p4, float p5)
+    jove_mixer_effect_set_params: {
+      args: [FFIType.i32, FFIType.f32, FFIType.f32, FFIType.f32, FFIType.f32, FFIType.f32, FFIType.f32],
+      returns: FFIType.void,
+    },
+  });
+  return symbols;
+}
+
+/**
+ * Try to load the native mixer library. Returns the symbols or null if unavailable.
+ * Safe to call multiple times — caches the result.
+ */
+export function loadMixer(): typeof lib {
+  if (_tried) return lib;
+  _tried = true;
+  try {
+    lib = _load();
+  } catch {
+    // Mixer lib not available — static sources fall back to one SDL stream each
+    lib = null;
+  }
+  return lib;
+}
+
+export default loadMixer;
@@ -0,0 +1,37 @@
+// Native render helper FFI bindings (jove_render — command buffer replay) via bun:ffi
+// Separate from ffi.ts so the engine works even without the render lib installed.
+
+import { dlopen, FFIType } from "bun:ffi";
+import { libPath } from "./lib-path";
+
+let lib: ReturnType<typeof _load> | null = null;
+let _tried = false;
+
+function _load() {
+  const { symbols } = dlopen(libPath("jove_render", "jove_render"), {
+    // int jove_render_submit(SDL_Renderer* renderer, const uint32_t* words, int word_count)
+    jove_render_submit: {
+      args: [FFIType.pointer, FFIType.pointer, FFIType.i32],
+      returns: FFIType.i32,
+    },
+  });
+  return symbols;
+}
+
+/**
+ * Try to load the native render helper. Returns the symbols or null if unavailable.
+ * Safe to call multiple times — caches the result.
+ */
+export function loadRender(): typeof lib {
+  if (_tried) return lib;
+  _tried = true;
+  try {
+    lib = _load();
+  } catch {
+    // Render lib not available — command buffering stays off, draws call SDL directly
+    lib = null;
+  }
+  return lib;
+}
+
+export default loadRender;
@@ -59,11 +59,26 @@ function _load() {
       args: [FFIType.pointer, FFIType.i32],
       returns: FFIType.void,
     },
+    // bool TTF_SetFontSDF(TTF_Font* font, bool enabled)
+    TTF_SetFontSDF: {
+      args: [FFIType.pointer, FFIType.bool],
+      returns: FFIType.bool,
+    },
     // bool TTF_GetStringSize(TTF_Font* font, const char* text, size_t length, int* w, int* h)
     TTF_GetStringSize: {
       args: [FFIType.pointer, FFIType.cstring, FFIType.u64, FFIType.pointer, FFIType.pointer],
       returns: FFIType.bool,
     },
+    // bool TTF_GetGlyphMetrics(TTF_Font* font, Uint32 ch, int* minx, int* maxx, int* miny, int* maxy, int* advance)
+    TTF_GetGlyphMetrics: {
+      args: [FFIType.pointer, FFIType.u32, FFIType.pointer, FFIType.pointer, FFIType.pointer, FFIType.pointer, FFIType.pointer],
+      returns: FFIType.bool,
+    },
+    // bool TTF_GetGlyphKerning(TTF_Font* font, Uint32 previous_ch, Uint32 ch, int* kerning)
+    TTF_GetGlyphKerning: {
+      args: [FFIType.pointer, FFIType.u32, FFIType.u32, FFIType.pointer],
+      returns: FFIType.bool,
+    },
     // bool TTF_GetStringSizeWrapped(TTF_Font* font, const char* text, size_t length, int wrap_width, int* w, int* h)
     TTF_GetStringSizeWrapped: {
       args: [FFIType.pointer, FFIType.cstring, FFIType.u64, FFIType.i32, FFIType.pointer, FFIType.pointer],
@@ -0,0 +1,11 @@
+// Job kernel fixture for jobs.test.ts: adds `add` to every index it is given in `out`
+// (a shared ByteData of Int32 counters), and throws on index `fail` if set.
+import type { ByteData } from "../../src/jove/data.ts";
+
+export default function (start: number, end: number, args: { out: ByteData; add: number; fail?: number }) {
+  const counts = new Int32Array(args.out._data.buffer, args.out._data.byteOffset, args.out._data.length >> 2);
+  for (let i = start; i < end; i++) {
+    if (i === args.fail) throw new Error(`failed at ${i}`);
+    Atomics.add(counts, i, args.add);
+  }
+}
@@ -0,0 +1,17 @@
+// Thread fixture for thread.test.ts: echoes values from `input` to `output`, inverting
+// shared ImageData in place, until it receives null.
+import type { Channel } from "../../src/jove/thread.ts";
+import { getChannel } from "../../src/jove/thread.ts";
+
+export default function (input: Channel, output: Channel) {
+  getChannel("thread-test").push("started");
+  for (;;) {
+    const value = input.demand() as any;
+    if (value === null) break;
+    if (value === "throw") throw new Error("asked to throw");
+    if (value?.format === "rgba8888") {
+      value.mapPixel((_x: number, _y: number, r: number, g: number, b: number, a: number) => [255 - r, 255 - g, 255 - b, a]);
+    }
+    output.push(value);
+  }
+}
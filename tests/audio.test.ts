@@ -3,10 +3,12 @@ import * as audio from "../src/jove/audio.ts";
 import type { Source } from "../src/jove/audio.ts";
 import { SDL_AUDIO_S16 } from "../src/sdl/types.ts";
 import { loadAudioDecode } from "../src/sdl/ffi_audio_decode.ts";
+import { loadMixer } from "../src/sdl/ffi_mixer.ts";
 import { writeFileSync, unlinkSync, mkdirSync, existsSync } from "fs";
 import { join } from "path";
 import { tmpdir } from "os";
 import { $ } from "bun";
+import { ptr, toArrayBuffer } from "bun:ffi";
 
 // Generate a minimal valid WAV file programmatically
 function generateWav(durationSec: number, freq: number = 440): Uint8Array {
@@ -358,6 +360,21 @@ describe("jove.audio", () => {
     s2.release();
   });
 
+  test("_updateSources skips idle sources and picks them up again on play()", () => {
+    if (!audioAvailable) return;
+    const src = audio.newSource(wavPath)!;
+    src.play();
+    src.stop();
+    audio._updateSources(); // prunes the stopped source from the polling set
+    expect(audio.getActiveSourceCount()).toBe(0);
+    src.play();
+    audio._updateSources();
+    expect(audio.getActiveSourceCount()).toBe(1);
+    expect(src.isPlaying()).toBe(true);
+    src.stop();
+    src.release();
+  });
+
   test("global pause() pauses all playing sources", () => {
     if (!audioAvailable) return;
     const s1 = audio.newSource(wavPath)!;
@@ -415,6 +432,77 @@ describe("jove.audio", () => {
     src.release();
   });
 
+  // --- Device options / latency ---
+
+  test("setDeviceOptions validates and round-trips", () => {
+    expect(() => audio.setDeviceOptions({ sampleFrames: 0 })).toThrow();
+    expect(() => audio.setDeviceOptions({ sampleFrames: 12.5 })).toThrow();
+    expect(() => audio.setDeviceOptions({ format: "s8" as any })).toThrow();
+    expect(() => audio.setDeviceOptions({ sampleRate: -1 })).toThrow();
+    expect(typeof audio.setDeviceOptions({ sampleFrames: 256, format: "f32" })).toBe("boolean");
+    expect(audio.getDeviceOptions()).toEqual({ sampleFrames: 256, format: "f32" });
+    audio.setDeviceOptions({});
+    expect(audio.getDeviceOptions()).toEqual({});
+  });
+
+  test("device info and latency estimates once the device is open", () => {
+    if (!audioAvailable) return;
+    const src = audio.newSource(wavPath)!;
+    const info = audio.getDeviceInfo()!;
+    expect(info).not.toBeNull();
+    expect(info.sampleRate).toBeGreaterThan(0);
+    expect(info.sampleFrames).toBeGreaterThanOrEqual(0);
+    expect(audio.getQueuedSamples()).toBeGreaterThanOrEqual(0);
+    expect(audio.getLatency()).toBeGreaterThanOrEqual(0);
+    src.release();
+  });
+
+  // --- Sound banks ---
+
+  test("sound bank registers cheaply and decodes on first play", () => {
+    if (!audioAvailable) return;
+    const bank = audio.newSoundBank();
+    expect(bank.add("blip", wavPath)).toBe(true);
+    expect(bank.add("missing", join(tmpDir, "jove2d-no-such-file.wav"))).toBe(false);
+    expect(bank.has("blip")).toBe(true);
+    expect(bank.isDecoded("blip")).toBe(false);
+    const src = bank.play("blip");
+    expect(src).not.toBeNull();
+    expect(src!.isPlaying()).toBe(true);
+    expect(bank.isDecoded("blip")).toBe(true);
+    // Second play while the first is still going gets another pooled voice
+    const second = bank.play("blip");
+    expect(second).not.toBe(src);
+    const stats = bank.getStats();
+    expect(stats.sounds).toBe(1);
+    expect(stats.decoded).toBe(1);
+    expect(stats.misses).toBe(1);
+    expect(stats.hits).toBe(1);
+    expect(stats.decodedBytes).toBeGreaterThan(0);
+    expect(bank.play("nope")).toBeNull();
+    bank.release();
+    expect(bank.has("blip")).toBe(false);
+  });
+
+  test("sound bank evicts least-recently-used PCM over budget", () => {
+    if (!audioAvailable) return;
+    const bank = audio.newSoundBank();
+    bank.add("a", wavPath);
+    bank.add("b", wavPath);
+    bank.newSource("a")!.release();
+    bank.newSource("b")!.release();
+    const perSound = bank.getStats().decodedBytes / 2;
+    // Room for one sound: "a" was used least recently
+    bank.setBudget(perSound);
+    expect(bank.isDecoded("a")).toBe(false);
+    expect(bank.isDecoded("b")).toBe(true);
+    expect(bank.getStats().evictions).toBe(1);
+    // Decoding "a" again pushes "b" out
+    bank.newSource("a")!.release();
+    expect(bank.isDecoded("b")).toBe(false);
+    bank.release();
+  });
+
   // --- _updateSources auto-stop ---
 
   test("_updateSources auto-stops finished non-looping sources", () => {
@@ -596,3 +684,311 @@ describe("jove.audio codecs", () => {
     try { unlinkSync(tmpWav); } catch {}
   });
 });
+
+// ============================================================
+// Native mixer: scene effects, filters, positional audio
+// ============================================================
+
+const mixerLibAvailable = loadMixer() !== null;
+
+describe("jove.audio native mixer", () => {
+  const fxWavPath = join(tmpDir, "jove2d-test-fx.wav");
+  let mixerReady = false;
+
+  beforeAll(() => {
+    writeFileSync(fxWavPath, generateWav(0.2, 440));
+    if (!mixerLibAvailable || !audio._init()) return;
+    const probe = audio.newSource(fxWavPath);
+    if (probe) {
+      mixerReady = audio._isMixerOpen();
+      probe.release();
+    }
+  });
+
+  afterAll(() => {
+    audio._quit();
+    try { unlinkSync(fxWavPath); } catch {}
+  });
+
+  test("isEffectsSupported matches mixer lib availability", () => {
+    expect(audio.isEffectsSupported()).toBe(mixerLibAvailable);
+    if (mixerLibAvailable) {
+      expect(audio.getMaxSceneEffects()).toBeGreaterThan(0);
+      expect(audio.getMaxSourceEffects()).toBeGreaterThan(0);
+    } else {
+      expect(audio.getMaxSceneEffects()).toBe(0);
+    }
+  });
+
+  test("setEffect/getEffect round-trip and removal", () => {
+    if (!mixerReady) return;
+    expect(audio.setEffect("hall", { type: "reverb", decaytime: 2.5 })).toBe(true);
+    expect(audio.getEffect("hall")).toEqual({ type: "reverb", decaytime: 2.5 });
+    expect(audio.getActiveEffects()).toContain("hall");
+    // Changing type replaces the slot
+    expect(audio.setEffect("hall", { type: "echo", delay: 0.2 })).toBe(true);
+    expect(audio.getEffect("hall")!.type).toBe("echo");
+    expect(audio.setEffect("hall", false)).toBe(true);
+    expect(audio.getEffect("hall")).toBeNull();
+    expect(audio.setEffect("hall", false)).toBe(false);
+  });
+
+  test("setEffect rejects unknown effect types", () => {
+    expect(() => audio.setEffect("bad", { type: "chorus" as any })).toThrow();
+  });
+
+  test("source setFilter/getFilter round-trip", () => {
+    if (!mixerReady) return;
+    const src = audio.newSource(fxWavPath)!;
+    expect(src.getFilter()).toBeNull();
+    expect(src.setFilter({ type: "lowpass", highgain: 0.2 })).toBe(true);
+    expect(src.getFilter()).toEqual({ type: "lowpass", highgain: 0.2 });
+    src.setFilter();
+    expect(src.getFilter()).toBeNull();
+    expect(() => src.setFilter({ type: "notch" as any })).toThrow();
+    src.release();
+  });
+
+  test("source routes into existing scene effects only", () => {
+    if (!mixerReady) return;
+    const src = audio.newSource(fxWavPath)!;
+    expect(src.setEffect("missing")).toBe(false);
+    audio.setEffect("room", { type: "reverb" });
+    expect(src.setEffect("room", { type: "highpass", lowgain: 0.5 })).toBe(true);
+    expect(src.getActiveEffects()).toEqual(["room"]);
+    expect(src.getEffect("room")).toEqual({ type: "highpass", lowgain: 0.5 });
+    src.play();
+    audio._updateSources();
+    expect(src.isPlaying()).toBe(true);
+    // Removing the scene effect detaches it from the source
+    audio.setEffect("room", false);
+    expect(src.getActiveEffects()).toEqual([]);
+    expect(src.setEffect("room", false)).toBe(true);
+    src.release();
+  });
+
+  test("clone copies filter and effect routing", () => {
+    if (!mixerReady) return;
+    audio.setEffect("slap", { type: "echo", delay: 0.05 });
+    const src = audio.newSource(fxWavPath)!;
+    src.setFilter({ type: "bandpass" });
+    src.setEffect("slap");
+    const cloned = src.clone();
+    expect(cloned.getFilter()).toEqual({ type: "bandpass" });
+    expect(cloned.getActiveEffects()).toEqual(["slap"]);
+    src.release();
+    cloned.release();
+    audio.setEffect("slap", false);
+  });
+
+  test("listener position, orientation and distance model", () => {
+    audio.setPosition(10, 20);
+    expect(audio.getPosition()).toEqual([10, 20, 0]);
+    audio.setOrientation(0, 0, -1, 0, 1, 0);
+    expect(audio.getOrientation()).toEqual([0, 0, -1, 0, 1, 0]);
+    expect(audio.getDistanceModel()).toBe("inverseclamped");
+    audio.setDistanceModel("linearclamped");
+    expect(audio.getDistanceModel()).toBe("linearclamped");
+    expect(() => audio.setDistanceModel("cubic" as any)).toThrow();
+    audio.setDistanceModel("inverseclamped");
+    audio.setPosition(0, 0, 0);
+  });
+
+  test("source positional settings round-trip", () => {
+    if (!mixerReady) return;
+    const src = audio.newSource(fxWavPath)!;
+    expect(src.getPosition()).toEqual([0, 0, 0]);
+    src.setPosition(100, -50);
+    expect(src.getPosition()).toEqual([100, -50, 0]);
+    src.setAttenuationDistances(32, 512);
+    expect(src.getAttenuationDistances()).toEqual([32, 512]);
+    src.setRolloff(2);
+    expect(src.getRolloff()).toBe(2);
+    expect(src.isRelative()).toBe(false);
+    src.setRelative(true);
+    expect(src.isRelative()).toBe(true);
+    const cloned = src.clone();
+    expect(cloned.getPosition()).toEqual([100, -50, 0]);
+    expect(cloned.getAttenuationDistances()).toEqual([32, 512]);
+    src.release();
+    cloned.release();
+  });
+
+  test("setSourcePositions updates many sources in one call", () => {
+    if (!mixerReady) return;
+    const sources = [audio.newSource(fxWavPath)!, audio.newSource(fxWavPath)!, audio.newSource(fxWavPath)!];
+    const positions = new Float32Array([1, 2, 0, 3, 4, 0, 5, 6, 7]);
+    audio.setSourcePositions(sources, positions);
+    // Second update takes the bulk native path for already-positioned sources
+    positions[0] = 8;
+    audio.setSourcePositions(sources, positions);
+    expect(sources[0]!.getPosition()).toEqual([8, 2, 0]);
+    expect(sources[2]!.getPosition()).toEqual([5, 6, 7]);
+    for (const s of sources) s.release();
+  });
+
+  test("loop points round-trip, clamp to the sound and carry over to clones", () => {
+    if (!mixerReady) return;
+    const src = audio.newSource(fxWavPath)!;
+    expect(src.getLoopPoints()).toEqual([0, 0]);
+    src.setLoopPoints(0.05, 0.15);
+    const [start, end] = src.getLoopPoints();
+    expect(start).toBeCloseTo(0.05, 3);
+    expect(end).toBeCloseTo(0.15, 3);
+    expect(() => src.setLoopPoints(0.15, 0.05)).toThrow();
+    expect(src.getLoopPoints()[0]).toBeCloseTo(0.05, 3);
+    src.setLoopPoints(0.1, 5);
+    expect(src.getLoopPoints()[1]).toBeCloseTo(src.getDuration(), 3);
+    const cloned = src.clone();
+    expect(cloned.getLoopPoints()[0]).toBeCloseTo(0.1, 3);
+    src.release();
+    cloned.release();
+  });
+
+  test("playAt schedules on the mixer clock", () => {
+    if (!mixerReady) return;
+    expect(audio.getSampleRate()).toBeGreaterThan(0);
+    expect(audio.getSampleTime()).toBeGreaterThanOrEqual(0);
+    const src = audio.newSource(fxWavPath)!;
+    src.playAt(audio.getSampleTime() + audio.getSampleRate());
+    // Playing (silently) until the scheduled sample; stop cancels the schedule
+    expect(src.isPlaying()).toBe(true);
+    src.stop();
+    expect(src.isStopped()).toBe(true);
+    src.release();
+  });
+
+  test("synth sources run an oscillator voice with an envelope", () => {
+    if (!mixerReady) return;
+    expect(() => audio.newSynth("organ" as any)).toThrow();
+    const synth = audio.newSynth("square")!;
+    expect(synth).not.toBeNull();
+    expect(synth.getWaveform()).toBe("square");
+    expect(synth.getDuration()).toBe(-1);
+    synth.setWaveform("saw");
+    expect(synth.getWaveform()).toBe("saw");
+    synth.setFrequency(220, 0.05);
+    expect(synth.getFrequency()).toBe(220);
+    synth.setEnvelope({ attack: 0.01, decay: 0.1, sustain: 2, release: 0.2 });
+    expect(synth.getEnvelope()).toEqual({ attack: 0.01, decay: 0.1, sustain: 1, release: 0.2 });
+    synth.noteOn(330);
+    expect(synth.isPlaying()).toBe(true);
+    expect(synth.getFrequency()).toBe(330);
+    // Note-off only starts the release; the source stops when the mixer reports it ended
+    synth.noteOff();
+    expect(synth.isPlaying()).toBe(true);
+    // Synths are full mixer sources: filters and positioning apply
+    expect(synth.setFilter({ type: "lowpass", highgain: 0.5 })).toBe(true);
+    synth.setPosition(1, 0, 0);
+    const cloned = synth.clone() as audio.SynthSource;
+    expect(cloned.getWaveform()).toBe("saw");
+    expect(cloned.getEnvelope()!.release).toBeCloseTo(0.2, 5);
+    synth.release();
+    cloned.release();
+  });
+
+  test("stream and queue sources report no effect support", () => {
+    if (!mixerReady) return;
+    const q = audio.newQueueableSource(44100, 16, 1)!;
+    expect(q.setFilter({ type: "lowpass" })).toBe(false);
+    expect(q.getActiveEffects()).toEqual([]);
+    q.release();
+  });
+});
+
+describe("jove.audio native mixer output (offline)", () => {
+  // Rendered without a device at the buffers' own rate, so samples come through unresampled
+  const RATE = 22050;
+  const mixer = loadMixer();
+  let ready = false;
+
+  beforeAll(() => {
+    // The previous block's _quit() closed the device mixer; don't take over one that is open
+    if (!mixer || mixer.jove_mixer_get_rate() !== 0) return;
+    ready = mixer.jove_mixer_open_offline(RATE) === RATE;
+  });
+
+  afterAll(() => {
+    if (ready) mixer!.jove_mixer_close();
+  });
+
+  function monoBuffer(samples: Int16Array): number {
+    return mixer!.jove_mixer_buffer_create(ptr(samples), samples.byteLength, SDL_AUDIO_S16, 1, RATE);
+  }
+
+  function render(frames: number): Float32Array {
+    const out = mixer!.jove_mixer_render_offline(frames)!;
+    return new Float32Array(toArrayBuffer(out, 0, frames * 8).slice(0));
+  }
+
+  test("playAt starts on the scheduled mixer frame", () => {
+    if (!ready) return;
+    const buffer = monoBuffer(new Int16Array(4000).fill(16384)); // DC 0.5
+    const voice = mixer!.jove_mixer_voice_create(buffer);
+    // 1500 frames out: nothing in the first 1024-frame block, onset 476 frames into the next
+    mixer!.jove_mixer_voice_play_at(voice, 1, mixer!.jove_mixer_get_clock() + 1500);
+    expect(render(1024).every((s) => s === 0)).toBe(true);
+    const out = render(1024);
+    expect(out[475 * 2]).toBe(0);
+    expect(out[476 * 2]).toBe(0.5);
+    expect(out[476 * 2 + 1]).toBe(0.5);
+    expect(out[1023 * 2]).toBe(0.5);
+    mixer!.jove_mixer_voice_free(voice);
+    mixer!.jove_mixer_buffer_free(buffer);
+  });
+
+  test("loops wrap from the loop end to the loop start without a gap", () => {
+    if (!ready) return;
+    const ramp = new Int16Array(1000);
+    for (let i = 0; i < ramp.length; i++) ramp[i] = i * 8;
+    const buffer = monoBuffer(ramp);
+    const voice = mixer!.jove_mixer_voice_create(buffer);
+    mixer!.jove_mixer_voice_set_looping(voice, 1);
+    mixer!.jove_mixer_voice_set_loop_points(voice, 200, 600);
+    mixer!.jove_mixer_voice_play(voice, 1);
+    const out = render(1024);
+    // Frame 599 is the last sample of the loop, frame 600 the loop start again — every frame accounted for
+    for (let f = 0; f < 1024; f++) {
+      const frame = f < 600 ? f : 200 + ((f - 600) % 400);
+      expect(out[f * 2]).toBe((frame * 8) / 32768);
+    }
+    mixer!.jove_mixer_voice_free(voice);
+    mixer!.jove_mixer_buffer_free(buffer);
+  });
+
+  test("distance attenuation and panning scale the output", () => {
+    if (!ready) return;
+    const buffer = monoBuffer(new Int16Array(4000).fill(16384)); // DC 0.5
+    // Default listener: at the origin facing -z with +y up, so +x is to the right
+    const positioned = (x: number, y: number, z: number): Float32Array => {
+      const voice = mixer!.jove_mixer_voice_create(buffer);
+      mixer!.jove_mixer_voice_set_spatial(voice, 0, 1, 1e30, 1);
+      mixer!.jove_mixer_voice_set_position(voice, x, y, z);
+      mixer!.jove_mixer_voice_play(voice, 1);
+      const out = render(256);
+      mixer!.jove_mixer_voice_free(voice);
+      return out;
+    };
+
+    // Inverse-clamped model, ref 1, rolloff 1: gain = 1 / (1 + (dist - 1))
+    // Straight ahead at distance 3: centered, a third of the level in both channels
+    let out = positioned(0, 3, 0);
+    expect(out[0]).toBeCloseTo(0.5 / 3, 5);
+    expect(out[1]).toBeCloseTo(0.5 / 3, 5);
+
+    // Hard right at distance 4: a quarter of the level, all in the right channel
+    out = positioned(4, 0, 0);
+    expect(out[0]).toBeCloseTo(0, 5);
+    expect(out[1]).toBeCloseTo(0.125, 5);
+    expect(out[255 * 2 + 1]).toBeCloseTo(0.125, 5);
+
+    // Front-left at 45°: sine-law pan normalized to unity at the center
+    out = positioned(-3, 0, -3);
+    const dist = Math.hypot(3, 3);
+    const theta = (1 - Math.SQRT1_2) * Math.PI / 4;
+    expect(out[0]).toBeCloseTo((0.5 / dist) * Math.min(1, Math.cos(theta) * Math.SQRT2), 5);
+    expect(out[1]).toBeCloseTo((0.5 / dist) * Math.min(1, Math.sin(theta) * Math.SQRT2), 5);
+
+    mixer!.jove_mixer_buffer_free(buffer);
+  });
+});
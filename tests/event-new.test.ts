@@ -2,6 +2,8 @@ import { test, expect, describe, beforeAll, afterAll } from "bun:test";
 import sdl from "../src/sdl/ffi.ts";
 import { SDL_INIT_VIDEO } from "../src/sdl/types.ts";
 import * as event from "../src/jove/event.ts";
+import * as joystick from "../src/jove/joystick.ts";
+import { getRandomState } from "../src/jove/math.ts";
 
 describe("jove.event — push/clear/quit", () => {
   beforeAll(() => {
@@ -61,3 +63,175 @@ describe("jove.event — push/clear/quit", () => {
   });
 
 });
+
+describe("jove.event — input recording and playback", () => {
+  test("recorded frames replay with identical dt and events", () => {
+    const frames: [number, any[]][] = [
+      [1 / 60, []],
+      [0.0171234, [
+        { type: "keypressed", key: "space", scancode: "space", isRepeat: false },
+        { type: "mousemoved", x: 10.5, y: 20.25, dx: 1, dy: -2 },
+      ]],
+      [0.016, [
+        { type: "keyreleased", key: "space", scancode: "space" },
+        { type: "mousepressed", x: 11, y: 21, button: 1, clicks: 2 },
+        { type: "gamepadaxis", instanceId: 3, axis: "leftx", value: -0.5 },
+        { type: "textinput", text: "héllo" },
+        { type: "custom-not-recorded" },
+      ]],
+    ];
+    event.startRecording();
+    expect(event.isRecording()).toBe(true);
+    for (const [dt, evs] of frames) event._recordFrame(dt, evs);
+    const log = event.stopRecording()!;
+    expect(event.isRecording()).toBe(false);
+    expect(log).toBeInstanceOf(Uint8Array);
+
+    event.startPlayback(log);
+    expect(event.isPlayingBack()).toBe(true);
+    for (const [dt, evs] of frames) {
+      const frame = event._playbackFrame()!;
+      expect(frame.dt).toBe(dt);
+      expect(frame.events).toEqual(evs.filter((e) => e.type !== "custom-not-recorded"));
+    }
+    // Log exhausted — playback ends and the loop goes back to live input
+    expect(event._playbackFrame()).toBeNull();
+    expect(event.isPlayingBack()).toBe(false);
+    const stats = event.getPlaybackStats();
+    expect(stats.frames).toBe(3);
+    expect(stats.totalFrames).toBe(3);
+  });
+
+  test("quitAtEnd pushes a final quit frame", () => {
+    event.startRecording();
+    event._recordFrame(0.02, []);
+    event.startPlayback(event.stopRecording()!, { quitAtEnd: true });
+    expect(event._playbackFrame()!.events).toEqual([]);
+    expect(event._playbackFrame()!.events).toEqual([{ type: "quit" }]);
+    expect(event._playbackFrame()).toBeNull();
+  });
+
+  test("frames with more than 65535 events and overlong strings round-trip", () => {
+    const many = Array.from({ length: 70000 }, () => ({ type: "minimized" }));
+    // 0xffff bytes would end inside a two-byte "é": truncation keeps whole characters
+    const long = "é".repeat(40000);
+    event.startRecording();
+    event._recordFrame(0.01, many);
+    event._recordFrame(0.01, [{ type: "textinput", text: long }]);
+    event.startPlayback(event.stopRecording()!);
+    expect(event._playbackFrame()!.events.length).toBe(70000);
+    const text = (event._playbackFrame()!.events[0] as any).text as string;
+    expect(text).toBe(long.slice(0, 32767));
+    event.stopPlayback();
+  });
+
+  // Written by hand: a session on a machine with a gamepad (instance 42) open at the start
+  // and a plain joystick (instance 43) plugged in on the second frame
+  function recordedWithJoysticks(): Uint8Array {
+    const bytes: number[] = [];
+    const u8 = (v: number) => bytes.push(v & 0xff);
+    const u16 = (v: number) => { u8(v); u8(v >> 8); };
+    const i32 = (v: number) => { u16(v & 0xffff); u16(v >>> 16); };
+    const f64 = (v: number) => bytes.push(...new Uint8Array(new Float64Array([v]).buffer));
+    const str = (v: string) => { const b = new TextEncoder().encode(v); u16(b.length); bytes.push(...b); };
+    const device = (instanceId: number, id: number, gamepad: boolean, name: string) => {
+      i32(instanceId); i32(id); u8(gamepad ? 1 : 0); str(name);
+      i32(6); i32(15); i32(1); i32(0x045e); i32(0x02ea); i32(0x0408);
+    };
+    i32(0x5249564a); u16(3); u16(0); i32(3); str(getRandomState());
+    u16(1); device(42, 1, true, "Recorded Pad");
+    // gamepadpressed a, gamepadaxis leftx
+    f64(1 / 60); i32(2); u8(25); i32(42); str("a"); u8(27); i32(42); str("leftx"); f64(-0.5);
+    // joystickadded, followed by the device it opened
+    f64(1 / 60); i32(1); u8(19); i32(43); device(43, 2, false, "Recorded Stick");
+    // joystickpressed 3, joystickhat 1 up
+    f64(1 / 60); i32(2); u8(21); i32(43); i32(3); u8(24); i32(43); i32(1); str("u");
+    return new Uint8Array(bytes);
+  }
+
+  test("joysticks replay without the recorded devices attached", () => {
+    const liveCount = joystick.getJoystickCount();
+    event.startPlayback(recordedWithJoysticks());
+    // What the game loop does each frame: rebuild the snapshot, then dispatch
+    const step = () => {
+      const frame = event._playbackFrame();
+      if (!frame) return null;
+      joystick._replaySnapshot(frame.events);
+      for (const ev of frame.events) if (ev.type === "joystickadded") joystick._onJoystickAdded(ev.instanceId);
+      return frame;
+    };
+
+    expect(joystick.getJoystickCount()).toBe(1);
+    const pad = joystick._getByInstanceId(42)!;
+    expect(pad.getName()).toBe("Recorded Pad");
+    expect(pad.getID()).toEqual([1, 42]);
+    expect(pad.isGamepad()).toBe(true);
+    expect(pad.isConnected()).toBe(true);
+    expect(pad.getDeviceInfo()).toEqual([0x045e, 0x02ea, 0x0408]);
+
+    step();
+    expect(pad.isGamepadDown("a")).toBe(true);
+    expect(pad.wasGamepadPressed("a")).toBe(true);
+    expect(pad.getGamepadAxis("leftx")).toBe(-0.5);
+
+    expect(step()!.events).toEqual([{ type: "joystickadded", instanceId: 43 }]);
+    const stick = joystick._getByInstanceId(43)!;
+    expect(stick.getName()).toBe("Recorded Stick");
+    expect(stick.isGamepad()).toBe(false);
+    expect(joystick.getJoystickCount()).toBe(2);
+    expect(pad.isGamepadDown("a")).toBe(true);
+    expect(pad.wasGamepadPressed("a")).toBe(false);
+
+    step();
+    expect(stick.isDown(3)).toBe(true);
+    expect(stick.getHat(0)).toBe("u");
+    // The new device moved the slots; the pad's state moved with it
+    expect(pad.isGamepadDown("a")).toBe(true);
+    expect(pad.getGamepadAxis("leftx")).toBe(-0.5);
+
+    // Log exhausted: back to the live devices
+    expect(step()).toBeNull();
+    expect(joystick.getJoystickCount()).toBe(liveCount);
+    expect(pad.isConnected()).toBe(false);
+  });
+
+  test("startPlayback rejects data that is not a recording", () => {
+    expect(() => event.startPlayback(new Uint8Array(32))).toThrow();
+    expect(event.isPlayingBack()).toBe(false);
+  });
+});
+
+describe("jove.event — idle wait", () => {
+  beforeAll(() => {
+    sdl.SDL_Init(SDL_INIT_VIDEO);
+  });
+
+  afterAll(() => {
+    event.setIdleWait(false);
+    sdl.SDL_Quit();
+  });
+
+  test("setIdleWait / getIdleWait round-trip", () => {
+    expect(event.getIdleWait()).toEqual([false, 0]);
+    event.setIdleWait(true, 0.5);
+    expect(event.getIdleWait()).toEqual([true, 0.5]);
+  });
+
+  test("_waitIfIdle returns at once when not idle or when events are queued", () => {
+    event.setIdleWait(true);
+    const t0 = performance.now();
+    event._waitIfIdle(false);
+    event.push({ type: "quit" });
+    event._waitIfIdle(true);
+    expect(performance.now() - t0).toBeLessThan(100);
+    event.clear();
+  });
+
+  test("_waitIfIdle sleeps for at most the timeout", () => {
+    event.clear();
+    event.setIdleWait(true, 0.05);
+    const t0 = performance.now();
+    event._waitIfIdle(true);
+    expect(performance.now() - t0).toBeLessThan(1000);
+  });
+});
@@ -1,7 +1,11 @@
 import { describe, test, expect, afterEach, beforeEach } from "bun:test";
 import { init, quit, window, graphics } from "../src/jove/index.ts";
-import { _createRenderer, _destroyRenderer, newFont, setFont, getFont, newText, draw, setColor } from "../src/jove/graphics.ts";
+import { _createRenderer, _destroyRenderer, _getGPUDevice, newFont, newSDFFont, setFont, getFont, newText, draw, print, setColor } from "../src/jove/graphics.ts";
 import { loadTTF } from "../src/sdl/ffi_ttf.ts";
+import { _getGlyphAtlasInfo } from "../src/jove/graphics-text.ts";
+import { _flushCommands } from "../src/jove/graphics-commands.ts";
+import sdl from "../src/sdl/ffi.ts";
+import { ptr } from "bun:ffi";
 
 const ttfAvailable = loadTTF() !== null;
 
@@ -274,4 +278,73 @@ describe("jove.graphics font (TTF)", () => {
     text.release();
     setColor(255, 255, 255); // restore
   });
+
+  test("Text objects share the font's glyph atlas", () => {
+    setupWindowAndRenderer();
+    const font = newFont(16)!;
+    const a = newText(font, "Score: 100")!;
+    a.getWidth(); // force layout
+    const after = _getGlyphAtlasInfo(font);
+    expect(after.pages).toBe(1);
+    expect(after.glyphs).toBeGreaterThan(0);
+
+    // Same glyphs in another Text, and an update, add nothing to the atlas
+    const b = newText(font, "Score: 001")!;
+    b.getWidth();
+    a.set("Score: 010");
+    a.getWidth();
+    expect(_getGlyphAtlasInfo(font)).toEqual(after);
+    expect(() => { draw(a, 0, 0); draw(b, 0, 20); }).not.toThrow();
+
+    a.release();
+    b.release();
+    font.release();
+    expect(_getGlyphAtlasInfo(font)).toEqual({ glyphs: 0, pages: 0 });
+  });
+
+  test("a Text keeps drawing after its font is released", () => {
+    setupWindowAndRenderer();
+    const font = newFont(16)!;
+    const text = newText(font, "Still here")!;
+    const page = text._texture!;
+    const size = new Float32Array(2);
+    // SDL validates texture handles, so this is false once the page is destroyed
+    const pageAlive = () => sdl.SDL_GetTextureSize(page, ptr(size), ptr(size, 4));
+
+    font.release();
+    expect(_getGlyphAtlasInfo(font)).toEqual({ glyphs: 0, pages: 0 });
+    expect(pageAlive()).toBe(true);
+    expect(() => { draw(text, 10, 20); _flushCommands(); }).not.toThrow();
+    expect(text._texture).toBe(page);
+
+    // The last Text drawing from the released atlas frees its pages
+    text.release();
+    expect(pageAlive()).toBe(false);
+  });
+
+  test("SDF fonts of every size share one distance-field atlas", async () => {
+    setupWindowAndRenderer();
+    const small = await newSDFFont(undefined, 12);
+    if (!_getGPUDevice() || !small) {
+      expect(small).toBeNull(); // no GPU renderer or shader compiler
+      return;
+    }
+    const large = (await newSDFFont(undefined, 96))!;
+    const preloaded = _getGlyphAtlasInfo(small);
+    expect(preloaded.glyphs).toBeGreaterThan(90); // printable ASCII
+    expect(_getGlyphAtlasInfo(large)).toEqual(preloaded);
+
+    // Metrics scale with the size; drawing any size adds no glyphs
+    expect(large.getWidth("Hello")).toBeCloseTo(small.getWidth("Hello") * 8, 0);
+    const t = newText(large, "Hello")!;
+    expect(t.getWidth()).toBeGreaterThan(newText(small, "Hello")!.getWidth());
+    setFont(small);
+    expect(() => { draw(t, 0, 0, 0, 3, 3); print("Hello", 0, 0); }).not.toThrow();
+    expect(_getGlyphAtlasInfo(small)).toEqual(preloaded);
+
+    small.release();
+    expect(_getGlyphAtlasInfo(large)).toEqual(preloaded);
+    large.release();
+    expect(_getGlyphAtlasInfo(large)).toEqual({ glyphs: 0, pages: 0 });
+  });
 });
@@ -103,6 +103,141 @@ describe("jove.graphics renderer + drawing", () => {
     unlinkSync(path);
   });
 
+  test("command buffering draws the same pixels as direct SDL calls", () => {
+    setupWindowAndRenderer();
+    const frame = (): ImageData => {
+      let shot: ImageData | null = null;
+      graphics._beginFrame();
+      graphics.setColor(255, 0, 0, 255);
+      graphics.rectangle("fill", 10, 10, 50, 50);
+      graphics.setColor(0, 0, 255, 255);
+      graphics.line(0, 100, 320, 100);
+      graphics.captureScreenshot((data) => { shot = data; });
+      graphics._endFrame();
+      return shot!;
+    };
+    const pixel = (img: ImageData, x: number, y: number) =>
+      Array.from(img.data.subarray((y * img.width + x) * 4, (y * img.width + x) * 4 + 4));
+
+    const direct = frame();
+    if (!graphics.setCommandBuffering(true)) {
+      // jove_render not built — buffering stays off
+      expect(graphics.isCommandBuffering()).toBe(false);
+      return;
+    }
+    expect(graphics.isCommandBuffering()).toBe(true);
+    const recorded = frame();
+    expect(pixel(recorded, 20, 20)).toEqual(pixel(direct, 20, 20));
+    expect(pixel(recorded, 200, 100)).toEqual(pixel(direct, 200, 100));
+
+    const stats = graphics.getCommandBufferStats();
+    expect(stats.enabled).toBe(true);
+    expect(stats.commands).toBeGreaterThan(0);
+    expect(stats.flushes).toBe(1);
+    expect(stats.bytes).toBeGreaterThan(0);
+
+    expect(graphics.setCommandBuffering(false)).toBe(true);
+    expect(graphics.isCommandBuffering()).toBe(false);
+  });
+
+  test("retained mode redraws only invalidated regions", () => {
+    setupWindowAndRenderer();
+    const frame = (r: number, g: number, b: number) => {
+      let shot: ImageData | null = null;
+      graphics._beginFrame();
+      const passes = graphics._prepareDraw();
+      for (let i = 0; i < passes; i++) {
+        graphics._beginDrawPass(i);
+        graphics.setColor(r, g, b, 255);
+        graphics.rectangle("fill", 0, 0, 320, 240);
+      }
+      graphics.captureScreenshot((data) => { shot = data; });
+      graphics._endFrame();
+      return { passes, shot: shot! };
+    };
+    const pixel = (img: ImageData, x: number, y: number) =>
+      Array.from(img.data.subarray((y * img.width + x) * 4, (y * img.width + x) * 4 + 3));
+
+    expect(graphics.setRetainedMode(true)).toBe(true);
+    expect(graphics.isRetainedMode()).toBe(true);
+    expect(graphics.getDirtyRegions()).toEqual([[0, 0, 320, 240]]);
+    const first = frame(255, 0, 0);
+    expect(first.passes).toBe(1);
+    expect(graphics._isIdle()).toBe(true);
+
+    // Overlapping rects merge; disjoint ones stay separate
+    graphics.invalidate(10, 10, 20, 20);
+    graphics.invalidate(25, 25, 10, 10);
+    graphics.invalidate(200, 200, 10, 10);
+    expect(graphics.getDirtyRegions()).toEqual([[10, 10, 25, 25], [200, 200, 10, 10]]);
+    expect(graphics._isIdle()).toBe(false);
+
+    const { passes, shot } = frame(0, 0, 255);
+    expect(passes).toBe(2);
+    // Screenshot pixels are in the renderer's format, so compare against each other
+    expect(pixel(shot, 205, 205)).toEqual(pixel(shot, 15, 15));
+    expect(pixel(shot, 15, 15)).not.toEqual(pixel(first.shot, 15, 15));
+    expect(pixel(shot, 100, 100)).toEqual(pixel(first.shot, 100, 100)); // kept from the first frame
+
+    // Nothing invalidated: draw is skipped
+    expect(frame(0, 255, 0).passes).toBe(0);
+
+    expect(graphics.setRetainedMode(false)).toBe(true);
+    expect(graphics._prepareDraw()).toBe(1);
+  });
+
+  test("render state cache skips unchanged state calls", () => {
+    setupWindowAndRenderer();
+    const img = graphics.newCanvas(8, 8)!;
+    graphics._beginFrame();
+    const before = graphics.getStats();
+    graphics.setColor(255, 255, 255, 255);
+    for (let i = 0; i < 10; i++) graphics.draw(img, i * 10, 0);
+    const after = graphics.getStats();
+    // Blend mode, address mode, color mod and alpha mod are set once, then skipped
+    expect(after.statechanges - before.statechanges).toBeLessThanOrEqual(5);
+    expect(after.statechangeselided - before.statechangeselided).toBeGreaterThanOrEqual(36);
+
+    // A change goes through
+    graphics.setColor(255, 0, 0, 255);
+    graphics.draw(img, 0, 20);
+    expect(graphics.getStats().statechanges).toBeGreaterThan(after.statechanges);
+    graphics._endFrame();
+    img.release();
+  });
+
+  test("dynamic resolution upscales the scene to the window", () => {
+    setupWindowAndRenderer();
+    const frame = () => {
+      let shot: ImageData | null = null;
+      graphics._beginFrame();
+      graphics.setColor(255, 0, 0, 255);
+      graphics.rectangle("fill", 160, 0, 160, 240);
+      graphics.captureScreenshot((data) => { shot = data; });
+      graphics._endFrame();
+      return shot!;
+    };
+    const pixel = (img: ImageData, x: number, y: number) =>
+      Array.from(img.data.subarray((y * img.width + x) * 4, (y * img.width + x) * 4 + 3));
+
+    expect(graphics.getResolutionScale()).toBe(1);
+    expect(graphics.setDynamicResolution(true, { minScale: 0.5, maxScale: 0.5 })).toBe(true);
+    expect(graphics.isDynamicResolution()).toBe(true);
+    expect(graphics.getResolutionScale()).toBe(0.5);
+    expect(graphics.setRetainedMode(true)).toBe(false);
+
+    // Still drawn in window coordinates: the right half is red, the left half is not
+    const shot = frame();
+    expect(shot.width).toBe(320);
+    expect(pixel(shot, 300, 120)).not.toEqual(pixel(shot, 20, 120));
+    expect(pixel(shot, 300, 120)).toEqual(pixel(shot, 200, 20));
+    expect(graphics.getDimensions()).toEqual([320, 240]);
+
+    expect(graphics.setDynamicResolution(false)).toBe(true);
+    expect(graphics.isDynamicResolution()).toBe(false);
+    expect(graphics.getResolutionScale()).toBe(1);
+  });
+
   test("drawing functions safe to call with no renderer", () => {
     init();
     // No window or renderer
@@ -0,0 +1,49 @@
+import { test, expect, describe, afterAll } from "bun:test";
+import * as jobs from "../src/jove/jobs.ts";
+import * as thread from "../src/jove/thread.ts";
+
+const KERNEL = "tests/assets/jobs-kernel.ts";
+
+function counters(n: number) {
+  const out = thread.newByteData(n * 4);
+  return { out, counts: new Int32Array(out._data.buffer, out._data.byteOffset, n) };
+}
+
+describe("jove.jobs", () => {
+  afterAll(() => jobs.shutdown());
+
+  test("parallelFor runs the kernel exactly once per index", () => {
+    jobs.setWorkerCount(3);
+    const { out, counts } = counters(10000);
+    jobs.parallelFor(10000, KERNEL, { out, add: 1 }, { grain: 16 }).wait();
+    expect(counts.every((c) => c === 1)).toBe(true);
+  });
+
+  test("dependent jobs run after the jobs they depend on", () => {
+    const { out, counts } = counters(1000);
+    // Each job doubles its contribution, so any reordering shows up in the totals
+    const a = jobs.parallelFor(1000, KERNEL, { out, add: 1 });
+    const b = a.then(1000, KERNEL, { out, add: 2 });
+    const c = jobs.parallelFor(1000, KERNEL, { out, add: 4 }, { after: [a, b] });
+    c.wait();
+    expect(a.isDone() && b.isDone()).toBe(true);
+    expect(counts.every((n) => n === 7)).toBe(true);
+  });
+
+  test("a job with no workers runs on the waiting thread", () => {
+    jobs.setWorkerCount(0);
+    expect(jobs.getWorkerCount()).toBe(0);
+    const { out, counts } = counters(100);
+    jobs.parallelFor(100, KERNEL, { out, add: 1 }).wait();
+    expect(counts.every((c) => c === 1)).toBe(true);
+    jobs.parallelFor(0, KERNEL).wait();
+  });
+
+  test("kernel errors are reported by wait()", () => {
+    jobs.setWorkerCount(2);
+    const { out } = counters(100);
+    const job = jobs.parallelFor(100, KERNEL, { out, add: 1, fail: 50 });
+    expect(() => job.wait()).toThrow("failed at 50");
+    expect(job.getError()).toBe("failed at 50");
+  });
+});
@@ -31,6 +31,21 @@ describe("jove.joystick module", () => {
     const joy = jove.joystick._getByInstanceId(999999);
     expect(joy).toBeNull();
   });
+
+  test("getSnapshot packs one slot per joystick", () => {
+    const snap = jove.joystick.getSnapshot();
+    const count = jove.joystick.getJoystickCount();
+    expect(snap.joysticks.length).toBe(count);
+    expect(snap.axisStride).toBe(snap.gamepadAxes + 16);
+    expect(snap.buttonStride).toBe(snap.gamepadButtons + 32);
+    expect(snap.axes.length).toBeGreaterThanOrEqual(count * snap.axisStride);
+    expect(snap.buttons.length).toBeGreaterThanOrEqual(count * snap.buttonStride);
+    expect(snap.previousButtons.length).toBe(snap.buttons.length);
+    expect(snap.hats.length).toBeGreaterThanOrEqual(count * snap.hatStride);
+    for (let i = 0; i < count * snap.axisStride; i++) {
+      expect(Math.abs(snap.axes[i]!)).toBeLessThanOrEqual(1);
+    }
+  });
 });
 
 describe("jove.joystick — connected device tests", () => {
@@ -51,4 +51,17 @@ describe("jove.keyboard", () => {
     expect(() => keyboard.isDown("a")).not.toThrow();
     expect(() => keyboard.isScancodeDown("space")).not.toThrow();
   });
+
+  test("snapshot queries and edges without input", () => {
+    init();
+    window.setMode(320, 240);
+    // No snapshot yet — edges are always false
+    expect(keyboard.wasPressed("a")).toBe(false);
+    keyboard._snapshot();
+    keyboard._snapshot();
+    expect(keyboard.isDown("a", "space")).toBe(false);
+    expect(keyboard.wasPressed("a", "space")).toBe(false);
+    expect(keyboard.wasReleased("a")).toBe(false);
+    expect(keyboard.wasPressed("nonexistentkey")).toBe(false);
+  });
 });
@@ -123,6 +123,20 @@ describe("jove.graphics — Mesh", () => {
     expect(y2).toBe(40);
   });
 
+  test("setVertices accepts a Float32Array in vertex-format order", () => {
+    const mesh = graphics.newMesh(3)!;
+    // x, y, u, v, r, g, b, a per vertex
+    mesh.setVertices(new Float32Array([
+      10, 20, 0.25, 0.5, 1, 0, 0, 1,
+      30, 40, 0.75, 1, 0, 1, 0, 0.5,
+      // Extra vertex past the end of the mesh is ignored
+      50, 60, 0, 0, 1, 1, 1, 1,
+    ]), 2);
+    expect(mesh.getVertex(1)).toEqual([0, 0, 0, 0, 1, 1, 1, 1]);
+    expect(mesh.getVertex(2)).toEqual([10, 20, 0.25, 0.5, 1, 0, 0, 1]);
+    expect(mesh.getVertex(3)).toEqual([30, 40, 0.75, 1, 0, 1, 0, 0.5]);
+  });
+
   // --- setVertexMap / getVertexMap ---
 
   test("vertex map is null by default", () => {
@@ -224,6 +238,64 @@ describe("jove.graphics — Mesh", () => {
     expect(fmt[2]).toEqual({ name: "VertexColor", type: "byte", components: 4 });
   });
 
+  test("custom vertex format orders vertices and stores extra attributes", () => {
+    const format = [
+      { name: "VertexPosition", type: "float", components: 2 },
+      { name: "Wave", type: "float", components: 1 },
+      { name: "VertexColor", type: "float", components: 4 },
+    ];
+    const mesh = graphics.newMesh(format, [
+      [0, 0, 0.5, 1, 0, 0, 1],
+      [10, 0, 0.25],
+      [10, 10, 1, 0, 0, 1, 0.5],
+    ], "triangles", "static")!;
+    expect(mesh.getVertexFormat()).toEqual(format);
+    expect(mesh.getVertexStride()).toBe(7);
+    expect(mesh.getUsage()).toBe("static");
+    expect(mesh.getDrawMode()).toBe("triangles");
+    // Format order; missing color defaults to white
+    expect(mesh.getVertex(2)).toEqual([10, 0, 0.25, 1, 1, 1, 1]);
+    expect(mesh.getVertexAttribute(1, 2)).toEqual([0.5]);
+    mesh.setVertexAttribute(1, 2, 0.75);
+    expect(mesh.getVertexAttribute(1, 2)).toEqual([0.75]);
+    mesh.setVertices(new Float32Array([5, 6, 0.1, 0, 1, 0, 1]), 3);
+    expect(mesh.getVertexAttribute(3, 1)).toEqual([5, 6]);
+    expect(mesh.getVertexAttribute(3, 3)).toEqual([0, 1, 0, 1]);
+    // No texcoord attribute: the SDL-side UVs stay 0
+    const data = mesh._getDrawData()!;
+    expect(data.vertices[2 * 8 + 6]).toBe(0);
+  });
+
+  test("invalid vertex formats throw", () => {
+    expect(() => graphics.newMesh([{ name: "Wave", type: "float", components: 1 }], 3)).toThrow();
+    expect(() => graphics.newMesh([{ name: "VertexPosition", type: "float", components: 5 }], 3)).toThrow();
+    expect(() => graphics.newMesh([
+      { name: "VertexPosition", type: "float", components: 2 },
+      { name: "VertexPosition", type: "float", components: 2 },
+    ], 3)).toThrow();
+  });
+
+  test("static meshes reuse transformed vertices until geometry or transform changes", () => {
+    const mesh = graphics.newMesh([[0, 0], [10, 0], [10, 10]], "triangles", "static")!;
+    const cache = mesh._staticCache!;
+    expect(cache).not.toBeNull();
+    expect(graphics.newMesh(3)!._staticCache).toBeNull();
+    graphics._beginFrame();
+    graphics.draw(mesh, 100, 50);
+    const first = cache.vertices;
+    expect(first[8]).toBe(110); // vertex 2 x, translated
+    const version = cache.version;
+    graphics.draw(mesh, 100, 50);
+    expect(cache.version).toBe(version);
+    mesh.setVertex(2, 20, 0);
+    graphics.draw(mesh, 100, 50);
+    expect(cache.version).not.toBe(version);
+    expect(cache.vertices[8]).toBe(120);
+    graphics.draw(mesh, 0, 50);
+    expect(cache.vertices[8]).toBe(20);
+    graphics._endFrame();
+  });
+
   // --- _isMesh ---
 
   test("_isMesh flag is true", () => {
@@ -285,6 +357,35 @@ describe("jove.graphics — Mesh", () => {
     expect(Array.from(data.indices)).toEqual([0, 1, 2, 0, 2, 3]);
   });
 
+  test("index buffer is cached until map, mode or range changes", () => {
+    const mesh = graphics.newMesh(4, "fan")!;
+    const first = mesh._getDrawData()!.indices;
+    // Vertex edits don't touch indices
+    mesh.setVertex(1, 5, 5);
+    expect(mesh._getDrawData()!.indices).toBe(first);
+    mesh.setDrawMode("strip");
+    const strip = mesh._getDrawData()!.indices;
+    expect(strip).not.toBe(first);
+    expect(Array.from(strip)).toEqual([0, 1, 2, 2, 1, 3]);
+    mesh.setVertexMap(4, 3, 2, 1);
+    expect(Array.from(mesh._getDrawData()!.indices)).toEqual([3, 2, 1, 1, 2, 0]);
+    mesh.setDrawRange(1, 3);
+    expect(Array.from(mesh._getDrawData()!.indices)).toEqual([3, 2, 1]);
+  });
+
+  test("points mode reuses its quad buffer and follows vertex edits", () => {
+    const mesh = graphics.newMesh(2, "points")!;
+    mesh.setVertex(1, 10, 20);
+    const first = mesh._getDrawData()!.vertices;
+    mesh.setVertex(1, 50, 60);
+    const data = mesh._getDrawData()!;
+    expect(data.vertices).toBe(first);
+    const hp = graphics.getPointSize() / 2;
+    // First corner of the first point's quad is its top-left
+    expect(data.vertices[0]).toBe(50 - hp);
+    expect(data.vertices[1]).toBe(60 - hp);
+  });
+
   test("draw range limits rendered vertices", () => {
     const mesh = graphics.newMesh(6, "triangles")!;
     for (let i = 0; i < 6; i++) mesh.setVertex(i + 1, i * 10, 0);
@@ -108,4 +108,18 @@ describe("jove.mouse", () => {
     expect(cursor._type).toBe("image");
     cursor.release();
   });
+
+  test("snapshot queries and edges", () => {
+    init();
+    window.setMode(320, 240);
+    expect(mouse.wasPressed(1)).toBe(false);
+    mouse._snapshot();
+    const [x, y] = mouse.getPosition();
+    expect(mouse.getX()).toBe(x);
+    expect(mouse.getY()).toBe(y);
+    mouse._snapshot();
+    expect(typeof mouse.isDown(1)).toBe("boolean");
+    expect(mouse.wasPressed(1)).toBe(false);
+    expect(mouse.wasReleased(1)).toBe(false);
+  });
 });
@@ -208,6 +208,129 @@ describe("jove.sound — SoundData", () => {
   test("newSoundData from nonexistent file throws", () => {
     expect(() => sound.newSoundData("/tmp/nonexistent-audio.wav")).toThrow();
   });
+
+  // --- Typed-array views ---
+
+  test("32-bit float SoundData round-trips without quantization", () => {
+    const sd = sound.newSoundData(100, 44100, 32, 1);
+    expect(sd.getBitDepth()).toBe(32);
+    expect(sd._data.length).toBe(100 * 4);
+    sd.setSample(3, 0.123456);
+    expect(sd.getSample(3)).toBeCloseTo(0.123456, 6);
+  });
+
+  test("newSoundData rejects unsupported bit depths", () => {
+    expect(() => sound.newSoundData(10, 44100, 24, 1)).toThrow();
+  });
+
+  test("getInt16Array is a live view of 16-bit data", () => {
+    const sd = sound.newSoundData(64, 44100, 16, 2);
+    const view = sd.getInt16Array();
+    expect(view.length).toBe(128);
+    view[1] = 16384;
+    expect(sd.getSample(0, 2)).toBeCloseTo(0.5, 4);
+    expect(() => sd.getFloat32Array()).toThrow();
+  });
+
+  test("getFloat32Array is a live view of float data", () => {
+    const sd = sound.newSoundData(64, 44100, 32, 1);
+    const view = sd.getFloat32Array();
+    view[10] = -0.25;
+    expect(sd.getSample(10)).toBeCloseTo(-0.25, 6);
+    expect(() => sd.getInt16Array()).toThrow();
+  });
+
+  // --- Bulk operations ---
+
+  test("mixInto adds with gain and clips integer targets", () => {
+    const a = sound.newSoundData(4, 44100, 16, 1);
+    const b = sound.newSoundData(4, 44100, 32, 1);
+    a.setSample(0, 0.25);
+    a.setSample(1, 0.9);
+    b.getFloat32Array().set([0.5, 0.5, 0.5, 0.5]);
+    const mixed = b.mixInto(a, 0.5);
+    expect(mixed).toBe(4);
+    expect(a.getSample(0)).toBeCloseTo(0.5, 3);
+    expect(a.getSample(1)).toBeCloseTo(1, 3); // 0.9 + 0.25 clips to 1
+    expect(a.getSample(2)).toBeCloseTo(0.25, 3);
+  });
+
+  test("mixInto honours target offset and rejects mismatched formats", () => {
+    const src = sound.newSoundData(4, 44100, 32, 1);
+    src.getFloat32Array().fill(0.5);
+    const dst = sound.newSoundData(6, 44100, 32, 1);
+    expect(src.mixInto(dst, 1, 4)).toBe(2);
+    expect(dst.getSample(3)).toBe(0);
+    expect(dst.getSample(4)).toBeCloseTo(0.5, 6);
+    expect(() => src.mixInto(sound.newSoundData(4, 22050, 32, 1))).toThrow();
+    expect(() => src.mixInto(sound.newSoundData(4, 44100, 32, 2))).toThrow();
+  });
+
+  test("resample changes length and preserves a constant signal", () => {
+    const sd = sound.newSoundData(1000, 44100, 16, 2);
+    const v = sd.getInt16Array();
+    for (let i = 0; i < v.length; i++) v[i] = i % 2 === 0 ? 8000 : -8000;
+    const up = sd.resample(88200);
+    expect(up.getSampleRate()).toBe(88200);
+    expect(up.getSampleCount()).toBe(2000);
+    expect(up.getChannelCount()).toBe(2);
+    expect(up.getInt16Array()[501 * 2]).toBe(8000);
+    expect(up.getInt16Array()[501 * 2 + 1]).toBe(-8000);
+    expect(sd.resample(22050).getSampleCount()).toBe(500);
+  });
+
+  test("convert changes bit depth and channel layout", () => {
+    const stereo = sound.newSoundData(8, 44100, 16, 2);
+    stereo.setSample(0, 0.5, 1);
+    stereo.setSample(0, -0.25, 2);
+    const mono = stereo.convert(32, 1);
+    expect(mono.getBitDepth()).toBe(32);
+    expect(mono.getChannelCount()).toBe(1);
+    expect(mono.getSample(0)).toBeCloseTo(0.125, 3);
+
+    const back = mono.convert(8, 2);
+    expect(back.getBitDepth()).toBe(8);
+    expect(back.getChannelCount()).toBe(2);
+    expect(back.getSample(0, 1)).toBeCloseTo(0.125, 1);
+    expect(back.getSample(0, 2)).toBeCloseTo(0.125, 1);
+    expect(back.getSample(1, 1)).toBe(0);
+  });
+
+  test("normalize scales peak to target", () => {
+    const sd = sound.newSoundData(4, 44100, 32, 1);
+    sd.getFloat32Array().set([0.1, -0.4, 0.2, 0]);
+    const gain = sd.normalize(0.8);
+    expect(gain).toBeCloseTo(2, 5);
+    expect(sd.getSample(1)).toBeCloseTo(-0.8, 5);
+    expect(sd.getSample(0)).toBeCloseTo(0.2, 5);
+    // Silent data is left alone
+    expect(sound.newSoundData(4, 44100, 16, 1).normalize()).toBe(1);
+  });
+
+  test("applyEnvelope ramps linearly between points and holds the ends", () => {
+    const sd = sound.newSoundData(100, 100, 32, 1); // 1 frame = 10ms
+    sd.getFloat32Array().fill(1);
+    sd.applyEnvelope([0.1, 0, 0.5, 1, 0.8, 0.5]);
+    expect(sd.getSample(5)).toBe(0);          // held before first point
+    expect(sd.getSample(10)).toBeCloseTo(0, 5);
+    expect(sd.getSample(30)).toBeCloseTo(0.5, 5);
+    expect(sd.getSample(65)).toBeCloseTo(0.75, 5);
+    expect(sd.getSample(90)).toBeCloseTo(0.5, 5); // held after last point
+  });
+
+  test("bulk operations process a second of audio quickly", () => {
+    const sd = sound.newSoundData(44100, 44100, 32, 2);
+    const buf = sd.getFloat32Array();
+    for (let i = 0; i < buf.length; i++) buf[i] = Math.sin(i * 0.01) * 0.5;
+    const dst = sound.newSoundData(44100, 44100, 16, 2);
+    const start = performance.now();
+    sd.mixInto(dst, 0.5);
+    sd.normalize();
+    sd.applyEnvelope([0, 0, 0.01, 1, 0.9, 1, 1, 0]);
+    const elapsed = performance.now() - start;
+    // Generous bound for CI; typically well under a millisecond once JIT-compiled
+    expect(elapsed).toBeLessThan(100);
+  });
 });
 
 describe("jove.audio — QueueableSource", () => {
@@ -605,6 +728,62 @@ describe("jove.sound — Decoder (streaming)", () => {
     dec.close();
   });
 
+  test("decodeInto() fills an existing SoundData and reuses it", () => {
+    if (!canRun || !existsSync(oggPath)) return;
+    const dec = sound.newDecoder(oggPath, 1024);
+    const sd = sound.newSoundData(1024, 22050, 16, 1);
+    let totalFrames = 0;
+    let sawNonZero = false;
+    while (true) {
+      const frames = dec.decodeInto(sd);
+      if (frames === 0) break;
+      expect(frames).toBeLessThanOrEqual(1024);
+      if (!sawNonZero) {
+        for (let i = 0; i < frames; i++) {
+          if (sd.getSample(i) !== 0) { sawNonZero = true; break; }
+        }
+      }
+      totalFrames += frames;
+    }
+    expect(sawNonZero).toBe(true);
+    expect(dec.isFinished()).toBe(true);
+    expect(totalFrames).toBeGreaterThan(20000);
+    expect(totalFrames).toBeLessThan(25000);
+    expect(dec.decodeInto(sd)).toBe(0);
+    dec.close();
+  });
+
+  test("decodeInto() is capped by the target SoundData size", () => {
+    if (!canRun || !existsSync(oggPath)) return;
+    const dec = sound.newDecoder(oggPath, 4096);
+    const small = sound.newSoundData(256, 22050, 16, 1);
+    expect(dec.decodeInto(small)).toBeLessThanOrEqual(256);
+    dec.close();
+  });
+
+  test("decodeInto() matches decode() output", () => {
+    if (!canRun || !existsSync(flacPath)) return;
+    const a = sound.newDecoder(flacPath, 1024);
+    const b = sound.newDecoder(flacPath, 1024);
+    const chunk = a.decode()!;
+    const sd = sound.newSoundData(1024, 22050, 16, 1);
+    const frames = b.decodeInto(sd);
+    expect(frames).toBe(chunk.getSampleCount());
+    for (let i = 0; i < frames; i += 97) {
+      expect(sd.getSample(i)).toBe(chunk.getSample(i));
+    }
+    a.close();
+    b.close();
+  });
+
+  test("decodeInto() rejects mismatched formats", () => {
+    if (!canRun || !existsSync(oggPath)) return;
+    const dec = sound.newDecoder(oggPath);
+    expect(() => dec.decodeInto(sound.newSoundData(512, 22050, 8, 1))).toThrow();
+    expect(() => dec.decodeInto(sound.newSoundData(512, 22050, 16, 2))).toThrow();
+    dec.close();
+  });
+
   // --- Streaming source tests ---
 
   test("newSource with 'stream' type creates a working source", () => {
@@ -237,4 +237,58 @@ describe("jove.graphics — SpriteBatch", () => {
     batch!.add(q2, 32, 0);
     expect(() => graphics.draw(batch!)).not.toThrow();
   });
+
+  // --- Chunks and culling ---
+
+  test("chunked batch draws only visible chunks, in add order", () => {
+    const batch = graphics.newSpriteBatch(img!, 100);
+    for (let i = 0; i < 100; i++) batch!.add((i % 10) * 200, Math.floor(i / 10) * 200);
+    batch!.setChunkSize(256);
+    expect(batch!.getChunkSize()).toBe(256);
+
+    graphics._statReset();
+    graphics.draw(batch!);
+    // 640x480 shows 4x3 of the 10x10 grid of 200px spacing (sprites are 64px)
+    const culled = graphics.getStats().culled;
+    expect(culled).toBeGreaterThan(70);
+    expect(culled).toBeLessThan(100);
+
+    // Scrolled out of view entirely
+    graphics._statReset();
+    graphics.push();
+    graphics.translate(-5000, 0);
+    graphics.draw(batch!);
+    graphics.pop();
+    expect(graphics.getStats().culled).toBe(100);
+
+    // Moving a sprite moves it between chunks
+    batch!.set(100, 0, 0);
+    graphics._statReset();
+    graphics.draw(batch!);
+    expect(graphics.getStats().culled).toBe(culled - 1);
+
+    batch!.setChunkSize(0);
+    graphics._statReset();
+    graphics.draw(batch!);
+    expect(graphics.getStats().culled).toBe(0);
+  });
+
+  test("setCulling skips immediate draws outside the screen", () => {
+    graphics.setCulling(true);
+    expect(graphics.isCulling()).toBe(true);
+    graphics._statReset();
+    graphics.draw(img!, 10, 10);
+    graphics.draw(img!, 1000, 10);
+    graphics.draw(img!, -100, -100, 0, 1, 1); // 64px image ends at -36
+    graphics.draw(img!, -100, 0, 0, 2, 2); // scaled to 128px, reaches x=28
+    const stats = graphics.getStats();
+    expect(stats.culled).toBe(2);
+    expect(stats.drawcalls).toBe(2);
+
+    graphics.setScissor(0, 0, 5, 5);
+    graphics.draw(img!, 10, 10);
+    expect(graphics.getStats().culled).toBe(3);
+    graphics.setScissor();
+    graphics.setCulling(false);
+  });
 });
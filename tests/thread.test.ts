@@ -0,0 +1,94 @@
+import { test, expect, describe } from "bun:test";
+import * as thread from "../src/jove/thread.ts";
+import { ByteData } from "../src/jove/data.ts";
+
+const ECHO = "tests/assets/thread-echo.ts";
+
+describe("jove.thread — Channel", () => {
+  test("push / pop / peek / getCount / clear", () => {
+    const ch = thread.newChannel();
+    expect(ch.pop()).toBeUndefined();
+    const id = ch.push({ a: 1, b: [true, null, "x"], c: undefined });
+    ch.push(2.5);
+    expect(ch.getCount()).toBe(2);
+    expect(ch.peek()).toEqual({ a: 1, b: [true, null, "x"], c: undefined });
+    expect(ch.hasRead(id)).toBe(false);
+    expect(ch.pop()).toEqual({ a: 1, b: [true, null, "x"], c: undefined });
+    expect(ch.hasRead(id)).toBe(true);
+    ch.clear();
+    expect(ch.getCount()).toBe(0);
+    expect(ch.demand(0.01)).toBeUndefined();
+  });
+
+  test("the queue grows past its initial capacity in order", () => {
+    const ch = thread.newChannel();
+    for (let i = 0; i < 100; i++) ch.push(i);
+    for (let i = 0; i < 100; i++) expect(ch.pop()).toBe(i);
+  });
+
+  test("getChannel returns the same channel for a name", () => {
+    thread.getChannel("named").push("hello");
+    expect(thread.getChannel("named").pop()).toBe("hello");
+  });
+
+  test("unsupported values throw", () => {
+    const ch = thread.newChannel();
+    expect(() => ch.push(new Map())).toThrow(TypeError);
+    expect(() => ch.push(() => 1)).toThrow(TypeError);
+    expect(ch.getCount()).toBe(0);
+  });
+
+  test("shared data is received as a view, not a copy", () => {
+    const ch = thread.newChannel();
+    const bytes = thread.newByteData(4);
+    ch.push(bytes);
+    const got = ch.pop() as ByteData;
+    expect(got).toBeInstanceOf(ByteData);
+    got._data[0] = 42;
+    expect(bytes._data[0]).toBe(42);
+
+    // Non-shared data is copied once; share() makes a shared copy up front
+    const local = new ByteData(new Uint8Array([1, 2, 3]));
+    ch.push(local);
+    expect((ch.pop() as ByteData)._data).toEqual(new Uint8Array([1, 2, 3]));
+    const shared = thread.share(local);
+    expect(thread.share(shared)).toBe(shared);
+  });
+});
+
+describe("jove.thread — Thread", () => {
+  test("a thread receives channels and edits shared ImageData in place", () => {
+    const input = thread.newChannel();
+    const output = thread.newChannel();
+    const t = thread.newThread(ECHO);
+    expect(t.start(input, output)).toBe(true);
+    expect(thread.getChannel("thread-test").demand(5)).toBe("started");
+    expect(t.isRunning()).toBe(true);
+
+    const img = thread.newImageData(2, 2)!;
+    img.setPixel(0, 0, 10, 20, 30, 255);
+    input.push("ping");
+    input.push(img);
+    expect(output.demand(5)).toBe("ping");
+    output.demand(5);
+    // The worker's write landed in our own ImageData
+    expect(img.getPixel(0, 0)).toEqual([245, 235, 225, 255]);
+
+    expect(input.supply(null, 5)).toBe(true);
+    t.wait();
+    expect(t.isRunning()).toBe(false);
+    expect(t.getError()).toBeNull();
+    // The Worker released its views on exit: only ours still holds the channel
+    expect(thread._i32[(input._block >> 2) + 1]).toBe(1);
+  });
+
+  test("errors thrown by the thread are reported", () => {
+    const input = thread.newChannel();
+    const t = thread.newThread(ECHO);
+    t.start(input, thread.newChannel());
+    thread.getChannel("thread-test").demand(5);
+    input.push("throw");
+    t.wait();
+    expect(t.getError()).toContain("asked to throw");
+  });
+});
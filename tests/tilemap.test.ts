@@ -0,0 +1,109 @@
+import { test, expect, describe, beforeAll, afterAll } from "bun:test";
+import sdl from "../src/sdl/ffi.ts";
+import { SDL_INIT_VIDEO } from "../src/sdl/types.ts";
+import * as window from "../src/jove/window.ts";
+import * as graphics from "../src/jove/graphics.ts";
+
+describe("jove.graphics — Tilemap", () => {
+  let img: ReturnType<typeof graphics.newCanvas>;
+
+  beforeAll(() => {
+    sdl.SDL_Init(SDL_INIT_VIDEO);
+    window.setMode(640, 480);
+    graphics._createRenderer();
+    // 64×64 tileset of 16×16 tiles = 16 tiles
+    img = graphics.newCanvas(64, 64);
+  });
+
+  afterAll(() => {
+    if (img) img.release();
+    graphics._destroyRenderer();
+    window.close();
+    sdl.SDL_Quit();
+  });
+
+  test("newTilemap sizes the map and the tileset", () => {
+    const map = graphics.newTilemap(img!, 16, 16, 100, 50, 2)!;
+    expect(map).not.toBeNull();
+    expect(map._isTilemap).toBe(true);
+    expect(map.getDimensions()).toEqual([100, 50]);
+    expect(map.getTileDimensions()).toEqual([16, 16]);
+    expect(map.getTileCount()).toBe(16);
+    expect(map.getLayerCount()).toBe(2);
+    expect(map.getChunkSize()).toBe(16);
+  });
+
+  test("setTile / getTile / setTiles / fill", () => {
+    const map = graphics.newTilemap(img!, 16, 16, 8, 4)!;
+    map.setTile(1, 3, 2, 5);
+    expect(map.getTile(1, 3, 2)).toBe(5);
+    expect(map.getTile(1, 3.7, 2.2)).toBe(5);
+    expect(map.getTile(1, 0, 0)).toBe(0);
+    // Out of range cells and layers are ignored
+    map.setTile(1, 8, 0, 1);
+    map.setTile(2, 0, 0, 1);
+    expect(map.getTile(1, 8, 0)).toBe(0);
+    expect(map.getTile(2, 0, 0)).toBe(0);
+
+    map.setTiles(1, [1, 2, 3]);
+    expect(map.getTile(1, 2, 0)).toBe(3);
+    map.fill(1, 7);
+    expect(map.getTile(1, 7, 3)).toBe(7);
+  });
+
+  test("only chunks whose tiles changed are rebuilt, and off-screen chunks are culled", () => {
+    const map = graphics.newTilemap(img!, 16, 16, 128, 128)!;
+    map.setChunkSize(8); // 128 px chunks → 16×16 chunks
+    map.fill(1, 1);
+
+    graphics._statReset();
+    graphics.draw(map, 0, 0);
+    const first = map._getChunkInfo();
+    // Only the chunks around the 640×480 window were built, out of 256
+    expect(first.chunks).toBeGreaterThanOrEqual(20);
+    expect(first.chunks).toBeLessThanOrEqual(30);
+    // Culled tiles are counted whether or not their chunk was ever built
+    expect(graphics.getStats().culled).toBe(128 * 128 - first.chunks * 64);
+
+    // Redrawing rebuilds nothing; changing one tile rebuilds one chunk
+    graphics.draw(map, 0, 0);
+    expect(map._getChunkInfo().rebuilds).toBe(first.rebuilds);
+    map.setTile(1, 3, 3, 2);
+    graphics.draw(map, 0, 0);
+    expect(map._getChunkInfo().rebuilds).toBe(first.rebuilds + 1);
+
+    // A hidden layer draws nothing
+    map.setLayerVisible(1, false);
+    expect(map.isLayerVisible(1)).toBe(false);
+    expect(() => graphics.draw(map, -500, -500, 0.3, 2, 2)).not.toThrow();
+  });
+
+  test("animated tiles advance without rebuilding geometry", () => {
+    const map = graphics.newTilemap(img!, 16, 16, 16, 16)!;
+    map.fill(1, 1);
+    map.setAnimation(1, [1, 2, 3], 0.1);
+    graphics.draw(map, 0, 0);
+    const built = map._getChunkInfo().rebuilds;
+    // Top-left UV of the first and last cells' sprites; tile n sits at column (n - 1) of 4
+    const verts = map._getChunkVertices(1, 0, 0)!;
+    const last = (16 * 16 - 1) * 32;
+    const uv = () => [verts[6], verts[7], verts[last + 6], verts[last + 7]];
+    expect(uv()).toEqual([0, 0, 0, 0]);
+
+    map.update(0.15);
+    graphics.draw(map, 0, 0);
+    expect(uv()).toEqual([0.25, 0, 0.25, 0]);
+    map.update(0.1);
+    graphics.draw(map, 0, 0);
+    expect(uv()).toEqual([0.5, 0, 0.5, 0]);
+    // The bottom-right corner moves with the frame too
+    expect(verts[last + 22]).toBe(0.75);
+    expect(verts[last + 23]).toBe(0.25);
+    expect(map._getChunkInfo().rebuilds).toBe(built);
+
+    map.clearAnimation(1);
+    expect(() => graphics.draw(map, 0, 0)).not.toThrow();
+    expect(uv()).toEqual([0, 0, 0, 0]);
+    expect(map._getChunkInfo().rebuilds).toBe(built);
+  });
+});
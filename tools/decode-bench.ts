@@ -0,0 +1,205 @@
+// jove2d audio decode benchmark — codec cost as seen from the engine (through bun:ffi)
+//
+// For each file: full decode (newSoundData — the static-source path), in-memory decode
+// (the SoundBank path), streaming decode via Decoder.decodeInto at several chunk sizes
+// (the stream-source path, including the per-chunk FFI call), seek + first chunk
+// latency, and memory growth per phase. The native benchmark in vendor/audio_decode
+// (audio_decode_bench) measures the same paths without FFI overhead.
+//
+// Usage:
+//   bun tools/decode-bench.ts                       # generates OGG/MP3/FLAC via ffmpeg
+//   bun tools/decode-bench.ts music.ogg sfx.mp3 --seconds 2
+
+import * as jove from "../src/jove/index.ts";
+import { loadAudioDecode } from "../src/sdl/ffi_audio_decode.ts";
+import { ptr, read } from "bun:ffi";
+import type { Pointer } from "bun:ffi";
+import { readFileSync, writeFileSync, unlinkSync, existsSync } from "fs";
+import { join } from "path";
+import { tmpdir } from "os";
+
+// --- CLI parsing ---
+const args = process.argv.slice(2);
+let seconds = 1;
+const files: string[] = [];
+for (let i = 0; i < args.length; i++) {
+  if (args[i] === "--seconds" && args[i + 1]) {
+    seconds = Math.max(0.1, parseFloat(args[i + 1]!));
+    i++;
+  } else {
+    files.push(args[i]!);
+  }
+}
+
+const CHUNK_SIZES = [256, 1024, 4096, 8192];
+const SEEK_TRIALS = 64;
+
+const lib = loadAudioDecode();
+if (!lib) {
+  console.error("Audio decode library not available — run `bun run build-audio-decode`");
+  process.exit(1);
+}
+
+// --- Generate test files (10s stereo tone + noise) when none are given ---
+function generateWav(path: string): void {
+  const rate = 44100, channels = 2, frames = rate * 10;
+  const dataSize = frames * channels * 2;
+  const view = new DataView(new ArrayBuffer(44 + dataSize));
+  view.setUint32(0, 0x52494646, false); // RIFF
+  view.setUint32(4, 36 + dataSize, true);
+  view.setUint32(8, 0x57415645, false); // WAVE
+  view.setUint32(12, 0x666d7420, false); // fmt
+  view.setUint32(16, 16, true);
+  view.setUint16(20, 1, true);
+  view.setUint16(22, channels, true);
+  view.setUint32(24, rate, true);
+  view.setUint32(28, rate * channels * 2, true);
+  view.setUint16(32, channels * 2, true);
+  view.setUint16(34, 16, true);
+  view.setUint32(36, 0x64617461, false); // data
+  view.setUint32(40, dataSize, true);
+  for (let i = 0; i < frames; i++) {
+    for (let c = 0; c < channels; c++) {
+      const s = 0.5 * Math.sin((2 * Math.PI * (440 + c * 110) * i) / rate) + 0.05 * (Math.random() - 0.5);
+      view.setInt16(44 + (i * channels + c) * 2, Math.floor(s * 32767), true);
+    }
+  }
+  writeFileSync(path, new Uint8Array(view.buffer));
+}
+
+const generated: string[] = [];
+if (files.length === 0) {
+  const wavPath = join(tmpdir(), "jove2d-decode-bench.wav");
+  generateWav(wavPath);
+  generated.push(wavPath);
+  const targets: [string, string[]][] = [
+    ["ogg", ["-c:a", "libvorbis", "-q:a", "5"]],
+    ["mp3", ["-c:a", "libmp3lame", "-b:a", "192k"]],
+    ["flac", ["-c:a", "flac"]],
+  ];
+  for (const [ext, codec] of targets) {
+    const out = join(tmpdir(), `jove2d-decode-bench.${ext}`);
+    try {
+      Bun.spawnSync(["ffmpeg", "-y", "-i", wavPath, ...codec, out], { stderr: "ignore" });
+    } catch {
+      break; // no ffmpeg
+    }
+    if (existsSync(out)) {
+      files.push(out);
+      generated.push(out);
+    }
+  }
+  if (files.length === 0) {
+    console.error("No input files and ffmpeg is unavailable — pass OGG/MP3/FLAC paths");
+    process.exit(1);
+  }
+}
+
+// --- Helpers ---
+const fmtRate = (fps: number, rate: number) =>
+  `${(fps / 1e6).toFixed(2).padStart(8)} Mframes/s ${(fps / rate).toFixed(0).padStart(6)}x realtime`;
+const mib = (bytes: number) => `${(bytes / (1024 * 1024)).toFixed(1)} MiB`;
+
+/** Repeat `pass` (returns frames decoded) for at least `seconds`; returns frames/s and peak RSS growth. */
+function measure(pass: () => number): { fps: number; rssGrowth: number } {
+  Bun.gc(true);
+  const rss0 = process.memoryUsage().rss;
+  let peak = rss0;
+  let frames = 0;
+  const start = performance.now();
+  let elapsed = 0;
+  do {
+    frames += pass();
+    peak = Math.max(peak, process.memoryUsage().rss);
+    elapsed = (performance.now() - start) / 1000;
+  } while (elapsed < seconds);
+  return { fps: frames / elapsed, rssGrowth: peak - rss0 };
+}
+
+function percentile(sorted: number[], p: number): number {
+  return sorted[Math.min(sorted.length - 1, Math.floor(p * sorted.length))]!;
+}
+
+// Out-params for jove_audio_decode_memory — read back with read.*
+const _outData = new BigUint64Array(1);
+const _outCh = new Int32Array(1);
+const _outRate = new Int32Array(1);
+
+console.log(`=== Audio Decode Benchmark === (${seconds}s per measurement)`);
+
+for (const path of files) {
+  let probe;
+  try {
+    probe = jove.sound.newDecoder(path);
+  } catch {
+    console.log(`\n${path}: could not open`);
+    continue;
+  }
+  const channels = probe.getChannelCount();
+  const rate = probe.getSampleRate();
+  const total = probe.getSampleCount();
+  probe.close();
+  const compressed = readFileSync(path);
+  console.log(`\n${path}: ${channels} ch, ${rate} Hz, ${total} frames (${(total / rate).toFixed(2)} s), ${mib(compressed.length)}`);
+
+  // Streaming: one Decoder per pass, decodeInto a reused SoundData (no per-chunk allocation)
+  for (const chunk of CHUNK_SIZES) {
+    const target = jove.sound.newSoundData(chunk, rate, 16, channels);
+    const { fps, rssGrowth } = measure(() => {
+      const d = jove.sound.newDecoder(path, chunk);
+      let frames = 0, n;
+      while ((n = d.decodeInto(target)) > 0) frames += n;
+      d.close();
+      return frames;
+    });
+    console.log(`  stream ${String(chunk).padEnd(6)} ${fmtRate(fps, rate)}   RSS +${mib(rssGrowth)}`);
+  }
+
+  // Seek latency: seek + first chunk, as a stream source's seek() does
+  {
+    const d = jove.sound.newDecoder(path, 1024);
+    const target = jove.sound.newSoundData(1024, rate, 16, channels);
+    const times: number[] = [];
+    for (let i = 0; i < SEEK_TRIALS; i++) {
+      const frame = Math.floor(Math.random() * Math.max(1, total - 1024));
+      const t0 = performance.now();
+      d.seek(frame);
+      d.decodeInto(target);
+      times.push(performance.now() - t0);
+    }
+    d.close();
+    times.sort((a, b) => a - b);
+    const mean = times.reduce((a, b) => a + b, 0) / times.length;
+    console.log(
+      `  seek+read    mean ${(mean * 1000).toFixed(1)} us  p95 ${(percentile(times, 0.95) * 1000).toFixed(1)} us  max ${(times[times.length - 1]! * 1000).toFixed(1)} us`,
+    );
+  }
+
+  // In-memory decode (SoundBank): compressed bytes already resident
+  {
+    const { fps, rssGrowth } = measure(() => {
+      const frames = lib.jove_audio_decode_memory(ptr(compressed), compressed.length, ptr(_outData), ptr(_outCh), ptr(_outRate));
+      const data = read.ptr(ptr(_outData), 0);
+      if (data) lib.jove_audio_free(data as unknown as Pointer);
+      return Math.max(0, frames);
+    });
+    console.log(`  memory       ${fmtRate(fps, rate)}   RSS +${mib(rssGrowth)}`);
+  }
+
+  // Full decode from disk into a SoundData (static sources)
+  {
+    let pcmBytes = 0;
+    const { fps, rssGrowth } = measure(() => {
+      const sd = jove.sound.newSoundData(path);
+      pcmBytes = sd._data.length;
+      return sd.getSampleCount();
+    });
+    console.log(`  full decode  ${fmtRate(fps, rate)}   RSS +${mib(rssGrowth)} (PCM ${mib(pcmBytes)})`);
+  }
+}
+
+for (const path of generated) {
+  try {
+    unlinkSync(path);
+  } catch {}
+}
@@ -0,0 +1,46 @@
+// Kernels for tools/jobs-bench.ts — one job index is one row of the target.
+import { noise } from "../src/jove/math.ts";
+import type { ByteData } from "../src/jove/data.ts";
+import type { ImageData } from "../src/jove/image.ts";
+
+interface BenchArgs {
+  op: "noise" | "invert" | "particles";
+  width: number;
+  target: ByteData | ImageData;
+}
+
+function bytesOf(target: ByteData | ImageData): Uint8Array {
+  return "format" in target ? target.data : target._data;
+}
+
+export default function (start: number, end: number, args: BenchArgs) {
+  const bytes = bytesOf(args.target);
+  const w = args.width;
+  if (args.op === "noise") {
+    // Two octaves of simplex noise into a Float32 heightmap
+    const out = new Float32Array(bytes.buffer, bytes.byteOffset, bytes.length >> 2);
+    for (let y = start; y < end; y++) {
+      for (let x = 0; x < w; x++) {
+        out[y * w + x] = noise(x * 0.01, y * 0.01) + 0.5 * noise(x * 0.02, y * 0.02);
+      }
+    }
+  } else if (args.op === "invert") {
+    // Per-pixel image op on RGBA8 rows
+    for (let i = start * w * 4, n = end * w * 4; i < n; i += 4) {
+      bytes[i] = 255 - bytes[i]!;
+      bytes[i + 1] = 255 - bytes[i + 1]!;
+      bytes[i + 2] = 255 - bytes[i + 2]!;
+    }
+  } else {
+    // Particle integration: x, y, vx, vy per particle, with drag and gravity
+    const p = new Float32Array(bytes.buffer, bytes.byteOffset, bytes.length >> 2);
+    for (let i = start * w * 4, n = end * w * 4; i < n; i += 4) {
+      const vx = p[i + 2]! * 0.99;
+      const vy = p[i + 3]! * 0.99 + 9.8 / 60;
+      p[i] = p[i]! + vx / 60;
+      p[i + 1] = p[i + 1]! + vy / 60;
+      p[i + 2] = vx;
+      p[i + 3] = vy;
+    }
+  }
+}
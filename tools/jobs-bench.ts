@@ -0,0 +1,66 @@
+// jove2d job system benchmark — parallelFor scalability from 1 thread to every core
+//
+// Runs three kernels (simplex-noise heightmap, RGBA image invert, particle integration)
+// over shared buffers with 1..N threads (the main thread plus N−1 pool Workers) and
+// reports time per run, speedup over one thread, and parallel efficiency. Noise is
+// compute bound and should scale close to linearly; invert and particles are memory
+// bound and flatten out once memory bandwidth is saturated.
+//
+// Usage:
+//   bun tools/jobs-bench.ts                    # 1..cores threads, 1024×1024 targets
+//   bun tools/jobs-bench.ts --size 2048 --runs 10 --threads 8
+
+import * as jobs from "../src/jove/jobs.ts";
+import * as thread from "../src/jove/thread.ts";
+import { availableParallelism } from "os";
+
+// --- CLI parsing ---
+const args = process.argv.slice(2);
+let size = 1024;
+let runs = 20;
+let maxThreads = availableParallelism();
+for (let i = 0; i < args.length; i++) {
+  const value = args[i + 1];
+  if (args[i] === "--size" && value) {
+    size = Math.max(16, parseInt(value));
+    i++;
+  } else if (args[i] === "--runs" && value) {
+    runs = Math.max(1, parseInt(value));
+    i++;
+  } else if (args[i] === "--threads" && value) {
+    maxThreads = Math.max(1, parseInt(value));
+    i++;
+  }
+}
+
+const KERNEL = new URL("./jobs-bench-kernel.ts", import.meta.url).pathname;
+const heightmap = thread.newByteData(size * size * 4);
+const image = thread.newImageData(size, size)!;
+const particles = thread.newByteData(size * size * 16); // size rows of size particles
+const targets = [
+  { op: "noise", target: heightmap },
+  { op: "invert", target: image },
+  { op: "particles", target: particles },
+] as const;
+
+function timeRuns(op: string, target: object): number {
+  jobs.parallelFor(size, KERNEL, { op, width: size, target }).wait(); // warm up: load the kernel everywhere
+  const start = performance.now();
+  for (let r = 0; r < runs; r++) jobs.parallelFor(size, KERNEL, { op, width: size, target }).wait();
+  return (performance.now() - start) / runs;
+}
+
+console.log(`=== Job System Benchmark === (${size}×${size}, ${runs} runs, up to ${maxThreads} threads)`);
+const baseline = new Map<string, number>();
+for (let threads = 1; threads <= maxThreads; threads++) {
+  jobs.setWorkerCount(threads - 1);
+  const cells: string[] = [];
+  for (const { op, target } of targets) {
+    const ms = timeRuns(op, target);
+    if (threads === 1) baseline.set(op, ms);
+    const speedup = baseline.get(op)! / ms;
+    cells.push(`${op.padEnd(9)} ${ms.toFixed(2).padStart(7)} ms ${speedup.toFixed(2).padStart(5)}x ${((speedup / threads) * 100).toFixed(0).padStart(3)}%`);
+  }
+  console.log(`${String(threads).padStart(2)} thread${threads === 1 ? " " : "s"}  ${cells.join("   ")}`);
+}
+jobs.shutdown();
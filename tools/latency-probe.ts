@@ -0,0 +1,137 @@
+// jove2d audio latency probe — reports device configuration and measured play() timing
+//
+// Each trial calls source.play() and spins until the native mixer has rendered the
+// voice (tell() advances): the round trip through the command queue and the audio
+// callback. Added to the device buffer estimate, that gives play-to-output latency.
+//
+// Usage:
+//   SDL_AUDIO_DRIVER=dummy bun tools/latency-probe.ts
+//   bun tools/latency-probe.ts --frames 128 --trials 200
+//   bun tools/latency-probe.ts --driver pulseaudio --frames 256 --format f32 --rate 48000
+
+import * as jove from "../src/jove/index.ts";
+import type { DeviceOptions } from "../src/jove/index.ts";
+import sdl from "../src/sdl/ffi.ts";
+import { writeFileSync, unlinkSync } from "fs";
+import { join } from "path";
+import { tmpdir } from "os";
+
+// --- CLI parsing ---
+const args = process.argv.slice(2);
+const options: DeviceOptions = {};
+let trials = 100;
+let driver = "";
+for (let i = 0; i < args.length; i++) {
+  const next = args[i + 1];
+  if (args[i] === "--frames" && next) {
+    options.sampleFrames = parseInt(next, 10);
+    i++;
+  } else if (args[i] === "--format" && next) {
+    options.format = next as DeviceOptions["format"];
+    i++;
+  } else if (args[i] === "--rate" && next) {
+    options.sampleRate = parseInt(next, 10);
+    i++;
+  } else if (args[i] === "--trials" && next) {
+    trials = Math.max(1, parseInt(next, 10));
+    i++;
+  } else if (args[i] === "--driver" && next) {
+    driver = next;
+    i++;
+  }
+}
+
+// --- Generate a short tone WAV (0.25s 1kHz, mono S16) ---
+function generateToneWav(): Uint8Array {
+  const sampleRate = 48000;
+  const numSamples = Math.floor(sampleRate * 0.25);
+  const dataSize = numSamples * 2;
+  const buf = new ArrayBuffer(44 + dataSize);
+  const view = new DataView(buf);
+  view.setUint32(0, 0x52494646, false); // RIFF
+  view.setUint32(4, 36 + dataSize, true);
+  view.setUint32(8, 0x57415645, false); // WAVE
+  view.setUint32(12, 0x666d7420, false); // fmt
+  view.setUint32(16, 16, true);
+  view.setUint16(20, 1, true);
+  view.setUint16(22, 1, true);
+  view.setUint32(24, sampleRate, true);
+  view.setUint32(28, sampleRate * 2, true);
+  view.setUint16(32, 2, true);
+  view.setUint16(34, 16, true);
+  view.setUint32(36, 0x64617461, false); // data
+  view.setUint32(40, dataSize, true);
+  for (let i = 0; i < numSamples; i++) {
+    view.setInt16(44 + i * 2, Math.floor(Math.sin((2 * Math.PI * 1000 * i) / sampleRate) * 8000), true);
+  }
+  return new Uint8Array(buf);
+}
+
+function percentile(sorted: number[], p: number): number {
+  if (sorted.length === 0) return 0;
+  return sorted[Math.min(sorted.length - 1, Math.floor(p * sorted.length))]!;
+}
+
+// --- Setup ---
+if (driver) sdl.SDL_SetHint(Buffer.from("SDL_AUDIO_DRIVER\0"), Buffer.from(driver + "\0"));
+if (!jove.audio._init()) {
+  console.error("Audio init failed");
+  process.exit(1);
+}
+jove.audio.setDeviceOptions(options);
+
+const wavPath = join(tmpdir(), "jove2d-latency-probe.wav");
+writeFileSync(wavPath, generateToneWav());
+const source = jove.audio.newSource(wavPath, "static");
+if (!source) {
+  console.error("Could not open an audio device");
+  process.exit(1);
+}
+source.setVolume(0.2);
+
+const info = jove.audio.getDeviceInfo()!;
+const fmtMs = (s: number) => `${(s * 1000).toFixed(2)} ms`;
+
+console.log("=== Audio Latency Probe ===");
+console.log(`Driver: ${info.driver}`);
+console.log(`Device: ${info.sampleRate} Hz, ${info.channels} ch, ${info.format}, ${info.sampleFrames} frames/buffer`);
+console.log(`Requested: ${JSON.stringify(options)}`);
+console.log(`Device buffer: ${fmtMs(info.sampleFrames / Math.max(1, info.sampleRate))}`);
+console.log(`Estimated output latency: ${fmtMs(jove.audio.getLatency())} (queued ${jove.audio.getQueuedSamples()} frames)`);
+
+// --- Round-trip trials ---
+if (!jove.audio._isMixerOpen()) {
+  console.log("\nNative mixer not available — round-trip timing needs vendor/audio_mixer.");
+} else {
+  const times: number[] = [];
+  let timeouts = 0;
+  for (let t = 0; t < trials; t++) {
+    const start = performance.now();
+    source.play();
+    while (source.tell() === 0) {
+      if (performance.now() - start > 1000) {
+        timeouts++;
+        break;
+      }
+    }
+    times.push((performance.now() - start) / 1000);
+    source.stop();
+    // Land the next play() at a different point in the callback cycle
+    Bun.sleepSync(5 + Math.random() * 15);
+  }
+  times.sort((a, b) => a - b);
+  const mean = times.reduce((a, b) => a + b, 0) / times.length;
+  const median = percentile(times, 0.5);
+
+  console.log(`\nplay() -> rendered, ${trials} trials${timeouts ? ` (${timeouts} timed out)` : ""}:`);
+  console.log(`  min ${fmtMs(times[0]!)}  median ${fmtMs(median)}  mean ${fmtMs(mean)}`);
+  console.log(`  p95 ${fmtMs(percentile(times, 0.95))}  max ${fmtMs(times[times.length - 1]!)}`);
+  console.log(`Estimated play() -> output: ${fmtMs(median + jove.audio.getLatency())}`);
+}
+
+source.release();
+jove.audio._quit();
+sdl.SDL_Quit();
+try {
+  unlinkSync(wavPath);
+} catch {}